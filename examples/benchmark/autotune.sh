@@ -0,0 +1,173 @@
+#!/bin/bash
+#
+# Copyright 2016-2020 Intel Corporation
+# 
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# 
+#     http://www.apache.org/licenses/LICENSE-2.0
+# 
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Sweeps the algorithms of the collectives with the benchmark on the current
+# topology and writes a tuning file to be loaded with CCL_TUNING_FILE=<file>.
+# Every line of the file holds the fastest algorithm per message size range:
+#   <comm_size> <ranks_per_node> CCL_<COLL>=<algo>:<size>-<size>;...
+
+BASENAME=`basename $0 .sh`
+SCRIPT_DIR=`cd $(dirname "$BASH_SOURCE") && pwd -P`
+
+RANKS=""
+PPN=""
+COLLS="allgatherv,allreduce,alltoall,alltoallv,bcast,reduce,reduce_scatter"
+DTYPES="float32"
+MIN_ELEM_COUNT=1
+MAX_ELEM_COUNT=4194304
+ITERS=20
+BENCHMARK="${SCRIPT_DIR}/benchmark"
+LAUNCHER="mpiexec"
+OUTPUT="ccl_tuning.txt"
+
+declare -A ALGOS
+ALGOS[allgather]="naive ring flat multi_bcast"
+ALGOS[allgatherv]="naive ring flat multi_bcast"
+ALGOS[allreduce]="rabenseifner nreduce ring double_tree recursive_doubling 2d hier"
+ALGOS[alltoall]="naive scatter"
+ALGOS[alltoallv]="naive scatter"
+ALGOS[bcast]="ring double_tree naive"
+ALGOS[reduce]="rabenseifner ring tree double_tree"
+ALGOS[reduce_scatter]="naive ring"
+
+print_help()
+{
+    echo "usage: ${BASENAME}.sh -n <ranks> [options]"
+    echo "  -n <ranks>            number of ranks"
+    echo "  -p <ranks per node>   default: number of ranks"
+    echo "  -l <colls>            default: ${COLLS}"
+    echo "  -d <dtypes>           default: ${DTYPES}"
+    echo "  -f <min elem count>   default: ${MIN_ELEM_COUNT}"
+    echo "  -t <max elem count>   default: ${MAX_ELEM_COUNT}"
+    echo "  -i <iters>            default: ${ITERS}"
+    echo "  -b <benchmark path>   default: ${BENCHMARK}"
+    echo "  -m <launcher>         default: ${LAUNCHER}, called as <launcher> -n <ranks> -ppn <ppn>"
+    echo "  -o <output file>      default: ${OUTPUT}"
+    echo "the direct algorithms are added with CCL_ATL_TRANSPORT=mpi"
+}
+
+while getopts "n:p:l:d:f:t:i:b:m:o:h" opt
+do
+    case ${opt} in
+        n ) RANKS=${OPTARG} ;;
+        p ) PPN=${OPTARG} ;;
+        l ) COLLS=${OPTARG} ;;
+        d ) DTYPES=${OPTARG} ;;
+        f ) MIN_ELEM_COUNT=${OPTARG} ;;
+        t ) MAX_ELEM_COUNT=${OPTARG} ;;
+        i ) ITERS=${OPTARG} ;;
+        b ) BENCHMARK=${OPTARG} ;;
+        m ) LAUNCHER=${OPTARG} ;;
+        o ) OUTPUT=${OPTARG} ;;
+        h ) print_help; exit 0 ;;
+        * ) print_help; exit 1 ;;
+    esac
+done
+
+if [[ -z "${RANKS}" ]]
+then
+    print_help
+    exit 1
+fi
+
+if [[ -z "${PPN}" ]]
+then
+    PPN=${RANKS}
+fi
+
+WORK_DIR=`mktemp -d`
+trap "rm -rf ${WORK_DIR}" EXIT
+
+# prints "<message size> <algo> <avg time>" for every measured point
+run_coll()
+{
+    local coll=$1
+    local env_name="CCL_${coll^^}"
+    local algos=${ALGOS[${coll}]}
+
+    if [[ "${CCL_ATL_TRANSPORT}" == "mpi" ]]
+    then
+        algos="direct ${algos}"
+    fi
+
+    for algo in ${algos}
+    do
+        local csv_file="${WORK_DIR}/${coll}_${algo}.csv"
+        # no fallback: an algorithm which can not be used fails the run and is skipped
+        env ${env_name}=${algo} CCL_ALGO_FALLBACK=0 \
+            ${LAUNCHER} -n ${RANKS} -ppn ${PPN} ${BENCHMARK} \
+            --coll ${coll} --dtype ${DTYPES} --reduction sum \
+            --min_elem_count ${MIN_ELEM_COUNT} --max_elem_count ${MAX_ELEM_COUNT} \
+            --iters ${ITERS} --csv_filepath ${csv_file} > ${WORK_DIR}/${coll}_${algo}.log 2>&1
+        if [ $? -ne 0 ]
+        then
+            echo "${coll}: skip ${algo}" 1>&2
+            continue
+        fi
+        echo "${coll}: done ${algo}" 1>&2
+        # columns: #ranks,collective,reduction,dtype,dtype_size,#elements/buffer,
+        #          message_size,#buffers,#repetitions,t_min,t_max,t_avg,...
+        awk -F, -v algo=${algo} '!/^#/ { print $7, algo, $12 }' ${csv_file}
+    done
+}
+
+# sums the times over dtypes of the same message size, picks the fastest algo
+# per size and joins the neighbour sizes with the same algo into ranges
+make_selection()
+{
+    awk '{ time[$1 " " $2] += $3; count[$1 " " $2]++ }
+         END { for (key in time) print key, time[key], count[key] }' \
+    | sort -k1,1n -k4,4nr -k3,3g \
+    | awk 'BEGIN { prev_size = -1 }
+           $1 != prev_size {
+               if (algo != "" && $2 != algo) {
+                   sel = sel algo ":" left "-" prev_size ";"
+                   left = prev_size + 1
+               }
+               if (algo == "") {
+                   left = 0
+               }
+               algo = $2
+               prev_size = $1
+           }
+           END {
+               if (algo != "") {
+                   print sel algo ":" left "-max"
+               }
+           }'
+}
+
+echo "# ${BASENAME}: ranks ${RANKS}, ppn ${PPN}, dtypes ${DTYPES}, `date`" > ${OUTPUT}
+
+for coll in ${COLLS//,/ }
+do
+    if [[ -z "${ALGOS[${coll}]}" ]]
+    then
+        echo "unsupported collective: ${coll}" 1>&2
+        exit 1
+    fi
+
+    selection=`run_coll ${coll} | make_selection`
+    if [[ -z "${selection}" ]]
+    then
+        echo "${coll}: no results" 1>&2
+        continue
+    fi
+    echo "${RANKS} ${PPN} CCL_${coll^^}=${selection}" >> ${OUTPUT}
+done
+
+echo "tuning file: ${OUTPUT}"
@@ -0,0 +1,190 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "oneapi/ccl.hpp"
+
+/* measures time-to-first-collective: kvs setup, communicator creation and first allreduce,
+   all ranks are forked from this process so no external launcher is required */
+
+#define DEFAULT_PROC_COUNT 4
+#define ELEM_COUNT         1024
+
+void print_help() {
+    std::cout << "specify: [proc_count]" << std::endl;
+}
+
+bool write_all(int fd, const void* buf, size_t size) {
+    size_t shift = 0;
+    while (shift < size) {
+        ssize_t res = write(fd, static_cast<const char*>(buf) + shift, size - shift);
+        if (res <= 0)
+            return false;
+        shift += res;
+    }
+    return true;
+}
+
+bool read_all(int fd, void* buf, size_t size) {
+    size_t shift = 0;
+    while (shift < size) {
+        ssize_t res = read(fd, static_cast<char*>(buf) + shift, size - shift);
+        if (res <= 0)
+            return false;
+        shift += res;
+    }
+    return true;
+}
+
+int run_rank(int size, int rank, const std::vector<int>& addr_pipe_fds, int result_fd) {
+    auto start = std::chrono::steady_clock::now();
+
+    ccl::init();
+
+    ccl::shared_ptr_class<ccl::kvs> kvs;
+    ccl::kvs::address_type main_addr;
+    if (rank == 0) {
+        kvs = ccl::create_main_kvs();
+        main_addr = kvs->get_address();
+        for (int idx = 1; idx < size; idx++) {
+            if (!write_all(addr_pipe_fds[2 * idx + 1], main_addr.data(), main_addr.size())) {
+                std::cout << "can not send kvs address" << std::endl;
+                return -1;
+            }
+        }
+    }
+    else {
+        if (!read_all(addr_pipe_fds[2 * rank], main_addr.data(), main_addr.size())) {
+            std::cout << "can not receive kvs address" << std::endl;
+            return -1;
+        }
+        kvs = ccl::create_kvs(main_addr);
+    }
+
+    auto comm = ccl::create_communicator(size, rank, kvs);
+
+    std::vector<float> send_buf(ELEM_COUNT, static_cast<float>(rank));
+    std::vector<float> recv_buf(ELEM_COUNT);
+    ccl::allreduce(send_buf.data(), recv_buf.data(), recv_buf.size(), ccl::reduction::sum, comm)
+        .wait();
+
+    double time_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+
+    float expected = (size - 1) * (static_cast<float>(size) / 2);
+    int ret = 0;
+    for (size_t idx = 0; idx < recv_buf.size(); idx++) {
+        if (recv_buf[idx] != expected) {
+            fprintf(stderr, "idx %zu, expected %4.4f, got %4.4f\n", idx, expected, recv_buf[idx]);
+            ret = -1;
+            break;
+        }
+    }
+
+    ccl::barrier(comm);
+
+    if (!write_all(result_fd, &time_ms, sizeof(time_ms))) {
+        std::cout << "can not send result" << std::endl;
+        return -1;
+    }
+    return ret;
+}
+
+int main(int argc, char** argv) {
+    int size = DEFAULT_PROC_COUNT;
+
+    if (argc == 2) {
+        size = std::atoi(argv[1]);
+    }
+    else if (argc > 2) {
+        print_help();
+        return -1;
+    }
+
+    if (size <= 0) {
+        print_help();
+        return -1;
+    }
+
+    std::cout << "proc_count = " << size << std::endl;
+
+    /* pipe per rank to pass main kvs address from rank 0, and one pipe to collect results */
+    std::vector<int> addr_pipe_fds(2 * size);
+    for (int idx = 0; idx < size; idx++) {
+        if (pipe(&addr_pipe_fds[2 * idx])) {
+            perror("pipe");
+            return -1;
+        }
+    }
+    int result_pipe_fds[2];
+    if (pipe(result_pipe_fds)) {
+        perror("pipe");
+        return -1;
+    }
+
+    std::vector<pid_t> pids(size);
+    for (int rank = 0; rank < size; rank++) {
+        pids[rank] = fork();
+        if (pids[rank] < 0) {
+            perror("fork");
+            return -1;
+        }
+        if (pids[rank] == 0) {
+            exit(run_rank(size, rank, addr_pipe_fds, result_pipe_fds[1]) ? EXIT_FAILURE
+                                                                         : EXIT_SUCCESS);
+        }
+    }
+    close(result_pipe_fds[1]);
+
+    int ret = 0;
+    double sum_time = 0, max_time = 0;
+    for (int rank = 0; rank < size; rank++) {
+        double time_ms = 0;
+        if (!read_all(result_pipe_fds[0], &time_ms, sizeof(time_ms))) {
+            std::cout << "can not receive result" << std::endl;
+            ret = -1;
+            break;
+        }
+        sum_time += time_ms;
+        max_time = std::max(max_time, time_ms);
+    }
+
+    for (int rank = 0; rank < size; rank++) {
+        int status = 0;
+        waitpid(pids[rank], &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            ret = -1;
+        }
+    }
+
+    if (ret) {
+        std::cout << "FAILED" << std::endl;
+        return ret;
+    }
+
+    std::cout << "time to first collective: avg " << sum_time / size << " ms, max " << max_time
+              << " ms" << std::endl;
+    std::cout << "PASSED" << std::endl;
+
+    return 0;
+}
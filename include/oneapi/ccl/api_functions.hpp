@@ -1029,6 +1029,28 @@ event CCL_API allreduce(const BufferObjectType& send_buf,
                         const communicator& comm,
                         const allreduce_attr& attr = default_allreduce_attr,
                         const vector_class<event>& deps = {});
+
+/**
+ * \brief Creates a persistent allreduce operation.
+ *        Buffers, algorithm and schedule are bound once,
+ *        @ref ccl::persistent_request::start runs the operation without re-creation.
+ *        Only host buffers are supported.
+ * @param send_buf the buffer with @c count elements of @c dtype that stores local data to be reduced
+ * @param recv_buf [out] the buffer to store reduced result, must have the same dimension as @c send_buf
+ * @param count the number of elements of type @c dtype in @c send_buf and @c recv_buf
+ * @param dtype the datatype of elements in @c send_buf and @c recv_buf
+ * @param rtype the type of the reduction operation to be applied
+ * @param comm the communicator for which the operation will be performed
+ * @param attr optional attributes to customize operation
+ * @return @ref ccl::persistent_request an object to start the operation and track its progress
+ */
+persistent_request CCL_API allreduce_init(const void* send_buf,
+                                          void* recv_buf,
+                                          size_t count,
+                                          datatype dtype,
+                                          reduction rtype,
+                                          const communicator& comm,
+                                          const allreduce_attr& attr = default_allreduce_attr);
 /** @} */ // end of allreduce
 
 /** @defgroup alltoall
@@ -34,8 +34,8 @@
 #define CCL_MINOR_VERSION           16
 #define CCL_UPDATE_VERSION          0
 #define CCL_PRODUCT_STATUS     "Gold"
-#define CCL_PRODUCT_BUILD_DATE "2025-06-30T 04:52:33Z"
-#define CCL_PRODUCT_FULL       "Gold-2021.16.0 2025-06-30T 04:52:33Z (master/59bf593)"
+#define CCL_PRODUCT_BUILD_DATE "2026-10-18T 08:32:16Z"
+#define CCL_PRODUCT_FULL       "Gold-2021.16.0 2026-10-18T 08:32:16Z (master/a2ef1e8)"
 
 #if defined(SYCL_LANGUAGE_VERSION) && defined (__INTEL_LLVM_COMPILER)
 #define CCL_ENABLE_SYCL
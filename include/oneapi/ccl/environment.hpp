@@ -62,6 +62,7 @@
 #include "oneapi/ccl/kvs.hpp"
 
 #include "oneapi/ccl/event.hpp"
+#include "oneapi/ccl/persistent_request.hpp"
 
 #include "oneapi/ccl/stream_attr_ids.hpp"
 #include "oneapi/ccl/stream_attr_ids_traits.hpp"
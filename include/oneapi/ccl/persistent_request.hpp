@@ -0,0 +1,80 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#ifndef CCL_PRODUCT_FULL
+#error "Do not include this file directly. Please include 'ccl.hpp'"
+#endif
+
+namespace ccl {
+
+class persistent_request_impl;
+
+namespace v1 {
+
+/**
+ * Persistent request that holds a communication operation bound to its buffers,
+ * algorithm and schedule. The operation can be started any number of times,
+ * every start has to be completed before the next one.
+ * Has no defined public constructor.
+ * Use ccl::allreduce_init for persistent request objects creation.
+ */
+class persistent_request final : public ccl_api_base_movable<persistent_request,
+                                                             direct_access_policy,
+                                                             persistent_request_impl> {
+public:
+    using base_t =
+        ccl_api_base_movable<persistent_request, direct_access_policy, persistent_request_impl>;
+
+    /**
+     * Declare PIMPL type
+     */
+    using impl_value_t = typename base_t::impl_value_t;
+
+    /**
+     * Declare implementation type
+     */
+    using impl_t = typename impl_value_t::element_type;
+
+    persistent_request(persistent_request&& src) noexcept;
+    persistent_request(impl_value_t&& impl) noexcept;
+    ~persistent_request() noexcept;
+
+    persistent_request& operator=(persistent_request&& src) noexcept;
+
+    /**
+     * Start the operation
+     */
+    void start();
+
+    /**
+     * Blocking wait for completion of the started operation
+     */
+    void wait();
+
+    /**
+     * Non-blocking check for completion of the started operation
+     * @retval true if the operation has been completed or was not started
+     * @retval false if the operation has not been completed
+     */
+    bool test();
+};
+
+} // namespace v1
+
+using v1::persistent_request;
+
+} // namespace ccl
@@ -38,7 +38,10 @@ atl_attr_t atl_base_comm::attr = {
         ATL_MNIC_NONE, /* mnic_type */
         "", /* mnic_name */
         1, /* mnic_count */
-        ATL_MNIC_OFFSET_NONE /* mnic_offset */
+        ATL_MNIC_OFFSET_NONE, /* mnic_offset */
+        0, /* mnic_stripe_size */
+        "", /* mnic_stripe_weights */
+        0 /* enable_cq_wait */
     },
 
     /* out */
@@ -51,6 +54,7 @@ atl_attr_t atl_base_comm::attr = {
         0, /* tag_bits */
         0, /* max_tag */
         0, /* max_order_waw_size */
+        1, /* max_iov_count */
     }
 };
 
@@ -80,6 +80,15 @@ public:
         return transport->recv(eps[ep_idx], buf, len, src_proc_idx, tag, req);
     }
 
+    virtual atl_status_t sendv(size_t ep_idx,
+                               const struct iovec* iov,
+                               size_t iov_count,
+                               int dst_proc_idx,
+                               uint64_t tag,
+                               atl_req_t& req) {
+        return transport->sendv(eps[ep_idx], iov, iov_count, dst_proc_idx, tag, req);
+    }
+
     virtual atl_status_t probe(size_t ep_idx,
                                int src_proc_idx,
                                uint64_t tag,
@@ -213,6 +222,10 @@ public:
         return transport->poll(eps[ep_idx]);
     }
 
+    virtual atl_status_t wait_event(size_t ep_idx, int extra_fd, int timeout_ms) {
+        return transport->wait_event(eps[ep_idx], extra_fd, timeout_ms);
+    }
+
     virtual atl_status_t check(size_t ep_idx, atl_req_t& req) {
         return transport->check(eps[ep_idx], req);
     }
@@ -83,6 +83,16 @@ public:
                               uint64_t tag,
                               atl_req_t& req) = 0;
 
+    /* gather send, iov_count should not exceed attr.out.max_iov_count */
+    virtual atl_status_t sendv(atl_ep_t& ep,
+                               const struct iovec* iov,
+                               size_t iov_count,
+                               int dst_proc_idx,
+                               uint64_t tag,
+                               atl_req_t& req) {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
     virtual atl_status_t probe(atl_ep_t& ep,
                                int src_proc_idx,
                                uint64_t tag,
@@ -179,6 +189,14 @@ public:
 
     virtual atl_status_t poll(atl_ep_t& ep) = 0;
 
+    /*
+       block until ep may have new completions, extra_fd (if not -1) becomes readable
+       or timeout_ms expires, ATL_STATUS_UNSUPPORTED if ep has no wait object
+    */
+    virtual atl_status_t wait_event(atl_ep_t& ep, int extra_fd, int timeout_ms) {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
     virtual atl_status_t check(atl_ep_t& ep, atl_req_t& req) = 0;
 
     virtual atl_proc_coord_t create_proc_coord(atl_ep_t& ep) = 0;
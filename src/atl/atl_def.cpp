@@ -70,7 +70,8 @@ std::string to_string(atl_attr_t& attr) {
        << ", sync_coll: " << attr.in.enable_sync_coll << ", extra_ep: " << attr.in.enable_extra_ep
        << ", ep_count: " << attr.in.ep_count << ", mnic_type: " << to_string(attr.in.mnic_type)
        << ", mnic_count: " << attr.in.mnic_count
-       << ", mnic_offset: " << to_string(attr.in.mnic_offset) << " }\n"
+       << ", mnic_offset: " << to_string(attr.in.mnic_offset)
+       << ", mnic_stripe_size: " << attr.in.mnic_stripe_size << " }\n"
        << "  out: { "
        << "shm: " << attr.out.enable_shm << ", hmem: " << attr.out.enable_hmem
        << ", mnic_type: " << to_string(attr.out.mnic_type)
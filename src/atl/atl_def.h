@@ -31,6 +31,7 @@
 
 #ifndef gettid
 #include <sys/syscall.h>
+#include <sys/uio.h>
 #include <sys/types.h>
 #include <unistd.h>
 #define gettid() syscall(SYS_gettid)
@@ -172,6 +173,9 @@ typedef struct atl_attr {
         std::string mnic_name;
         size_t mnic_count;
         atl_mnic_offset_t mnic_offset;
+        size_t mnic_stripe_size;
+        std::string mnic_stripe_weights;
+        bool enable_cq_wait;
     } in;
     struct {
         bool enable_shm;
@@ -182,6 +186,7 @@ typedef struct atl_attr {
         size_t tag_bits;
         uint64_t max_tag;
         size_t max_order_waw_size;
+        size_t max_iov_count;
     } out;
 } atl_attr_t;
 
@@ -103,6 +103,7 @@ atl_status_t atl_mpi::init(int* argc,
     // MPI specification requires the user tag to be minimum 16 bits.
     attr->out.max_tag = (is_tag_ub_set) ? *((int*)tag_ub_ptr) : 0;
     attr->out.max_order_waw_size = 0;
+    attr->out.max_iov_count = 1;
 
     return ATL_STATUS_SUCCESS;
 
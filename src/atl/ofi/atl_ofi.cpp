@@ -15,6 +15,10 @@
 */
 #include "atl_ofi.hpp"
 
+#include <chrono>
+#include <numeric>
+#include <poll.h>
+
 #ifdef CCL_ENABLE_SYCL
 #include "common/utils/sycl_utils.hpp"
 #endif // CCL_ENABLE_SYCL
@@ -106,6 +110,7 @@ atl_status_t atl_ofi::init(int* argc,
     prov_env = getenv("FI_PROVIDER");
 
     ctx.enable_hmem = 0;
+    ctx.enable_cq_wait = attr->in.enable_cq_wait;
 
     fi_version = FI_VERSION(global_data.fi_major_version, global_data.fi_minor_version);
 
@@ -181,6 +186,12 @@ atl_status_t atl_ofi::init(int* argc,
 
     cache.init(attr->in.ep_count, ctx.enable_hmem);
 
+    ctx.stripe_size = 0;
+    ctx.stripe_count = 1;
+    if (open_nw_provs) {
+        init_striping(*attr);
+    }
+
     for (ep_idx = 0; ep_idx < ctx.ep_count; ep_idx++) {
         atl_ep_t ep;
 
@@ -192,9 +203,12 @@ atl_status_t atl_ofi::init(int* argc,
             ofi_ep->active_prov_count++;
         }
         if (open_nw_provs) {
-            ofi_ep->active_prov_idxs[ofi_ep->active_prov_count] =
-                ctx.nw_prov_first_idx + ep_idx % ctx.nw_prov_count;
-            ofi_ep->active_prov_count++;
+            /* stripe 0 is the default NW prov of EP, other stripes follow it round-robin */
+            for (size_t stripe_idx = 0; stripe_idx < ctx.stripe_count; stripe_idx++) {
+                ofi_ep->active_prov_idxs[ofi_ep->active_prov_count] =
+                    ctx.nw_prov_first_idx + (ep_idx + stripe_idx) % ctx.nw_prov_count;
+                ofi_ep->active_prov_count++;
+            }
         }
         CCL_THROW_IF_NOT(ofi_ep->active_prov_count, "no active providers for ep_idx ", ep_idx);
 
@@ -248,6 +262,13 @@ atl_status_t atl_ofi::init(int* argc,
     attr->out.mnic_count = ctx.mnic_count;
     attr->out.max_order_waw_size = 0;
 
+    /* gather sends skip memory registration, so they are not used with hmem */
+    attr->out.max_iov_count = (ctx.enable_hmem) ? 1 : std::numeric_limits<size_t>::max();
+    for (size_t prov_idx = 0; prov_idx < ctx.prov_count; prov_idx++) {
+        attr->out.max_iov_count =
+            std::min(attr->out.max_iov_count, ctx.provs[prov_idx].info->tx_attr->iov_limit);
+    }
+
     return ATL_STATUS_SUCCESS;
 
 err:
@@ -366,8 +387,26 @@ atl_status_t atl_ofi::send(atl_ep_t& ep,
 
     atl_ofi_init_req(req, prov_ep, prov_ep->tx);
 
+    if (is_striped(prov, len)) {
+        return post_striped(
+            ep, const_cast<void*>(buf), len, dst_proc_idx, tag, req, true /* is_send */);
+    }
+
     ofi_req = ((atl_ofi_req_t*)req.internal);
 
+    if (len <= prov->inject_size) {
+        /* the buffer is copied out on the call, no MR and no completion entry are needed */
+        ofi_req->mr = nullptr;
+        ATL_OFI_RETRY(
+            fi_tinject(prov_ep->tx, buf, len, atl_ofi_get_addr(prov, dst_proc_idx, ep.idx), tag),
+            ep,
+            ret);
+        if (ret == FI_SUCCESS) {
+            ofi_req->comp_state = ATL_OFI_COMP_COMPLETED;
+        }
+        return ATL_OFI_RET(ret);
+    }
+
     cache.get(ep, prov, const_cast<void*>(buf), len, &ofi_req->mr);
     void* desc = (ofi_req->mr) ? fi_mr_desc(ofi_req->mr) : nullptr;
 
@@ -407,6 +446,10 @@ atl_status_t atl_ofi::recv(atl_ep_t& ep,
 
     atl_ofi_init_req(req, prov_ep, prov_ep->rx);
 
+    if (is_striped(prov, len)) {
+        return post_striped(ep, buf, len, src_proc_idx, tag, req, false /* is_send */);
+    }
+
     ofi_req = ((atl_ofi_req_t*)req.internal);
 
     cache.get(ep, prov, const_cast<void*>(buf), len, &ofi_req->mr);
@@ -431,6 +474,52 @@ atl_status_t atl_ofi::recv(atl_ep_t& ep,
     return ATL_OFI_RET(ret);
 }
 
+atl_status_t atl_ofi::sendv(atl_ep_t& ep,
+                            const struct iovec* iov,
+                            size_t iov_count,
+                            int dst_proc_idx,
+                            uint64_t tag,
+                            atl_req_t& req) {
+    ssize_t ret;
+
+    atl_ofi_prov_t* prov;
+    atl_ofi_prov_ep_t* prov_ep;
+    atl_ofi_req_t* ofi_req;
+
+    size_t len = 0;
+    for (size_t idx = 0; idx < iov_count; idx++) {
+        len += iov[idx].iov_len;
+    }
+
+    prov = atl_ofi_get_prov(ctx, coord, ep, dst_proc_idx, len);
+    prov_ep = &(prov->eps[ep.idx]);
+
+    CCL_THROW_IF_NOT(iov_count <= prov->info->tx_attr->iov_limit,
+                     "unexpected iov_count ",
+                     iov_count,
+                     ", iov_limit ",
+                     prov->info->tx_attr->iov_limit);
+
+    atl_ofi_init_req(req, prov_ep, prov_ep->tx);
+
+    ofi_req = ((atl_ofi_req_t*)req.internal);
+    ofi_req->mr = nullptr;
+
+    struct fi_msg_tagged msg;
+    msg.desc = nullptr;
+    msg.msg_iov = iov;
+    msg.iov_count = iov_count;
+    msg.tag = tag;
+    msg.ignore = 0;
+    msg.addr = atl_ofi_get_addr(prov, dst_proc_idx, ep.idx);
+    msg.context = &ofi_req->fi_ctx;
+    msg.data = 0;
+
+    ATL_OFI_RETRY(fi_tsendmsg(prov_ep->tx, &msg, 0), ep, ret);
+
+    return ATL_OFI_RET(ret);
+}
+
 atl_status_t atl_ofi::probe(atl_ep_t& ep,
                             int src_proc_idx,
                             uint64_t tag,
@@ -647,6 +736,25 @@ atl_status_t atl_ofi::cancel(atl_ep_t& ep, atl_req_t& req) {
     ret = ATL_STATUS_SUCCESS;
     ofi_req = ((atl_ofi_req_t*)req.internal);
 
+    if (ofi_req->stripes) {
+        atl_ofi_req_t* stripes = ofi_req->stripes;
+        for (size_t idx = 0; idx < ofi_req->stripe_count; idx++) {
+            atl_ofi_req_t* stripe_req = &stripes[idx];
+            if (stripe_req->comp_state != ATL_OFI_COMP_POSTED) {
+                continue;
+            }
+            if (fi_cancel(&stripe_req->fi_ep->fid, &stripe_req->fi_ctx) == 0) {
+                ret = atl_ofi_wait_cancel_cq(stripe_req->prov_ep->cq);
+                if (ret != FI_SUCCESS) {
+                    break;
+                }
+            }
+        }
+        ofi_req->stripes = nullptr;
+        delete[] stripes;
+        return ATL_OFI_RET(ret);
+    }
+
     ret = fi_cancel(&ofi_req->fi_ep->fid, &ofi_req->fi_ctx);
     if (ret == 0) {
         return ATL_OFI_RET(atl_ofi_wait_cancel_cq(ofi_req->prov_ep->cq));
@@ -662,6 +770,51 @@ atl_status_t atl_ofi::poll(atl_ep_t& ep) {
     return ATL_STATUS_SUCCESS;
 }
 
+atl_status_t atl_ofi::wait_event(atl_ep_t& ep, int extra_fd, int timeout_ms) {
+    atl_ofi_ep_t* ofi_ep = ((atl_ofi_ep_t*)ep.internal);
+    struct pollfd fds[ATL_OFI_MAX_ACTIVE_PROV_COUNT + 1];
+    nfds_t fd_count = 0;
+
+    for (size_t idx = 0; idx < ofi_ep->active_prov_count; idx++) {
+        atl_ofi_prov_t* prov = &(ctx.provs[ofi_ep->active_prov_idxs[idx]]);
+        atl_ofi_prov_ep_t* prov_ep = &(prov->eps[ep.idx]);
+
+        if (prov_ep->cq_wait_fd < 0)
+            return ATL_STATUS_UNSUPPORTED;
+
+        /* fi_trywait is mandatory before blocking on the wait fd */
+        struct fid* fid = &prov_ep->cq->fid;
+        int ret = fi_trywait(prov->fabric, &fid, 1);
+        if (ret == -FI_EAGAIN) {
+            /* completions are already available */
+            return ATL_STATUS_SUCCESS;
+        }
+        else if (ret != FI_SUCCESS) {
+            LOG_DEBUG("fi_trywait error: ", fi_strerror(-ret));
+            return ATL_STATUS_UNSUPPORTED;
+        }
+
+        fds[fd_count].fd = prov_ep->cq_wait_fd;
+        fds[fd_count].events = POLLIN;
+        fds[fd_count].revents = 0;
+        fd_count++;
+    }
+
+    if (extra_fd >= 0) {
+        fds[fd_count].fd = extra_fd;
+        fds[fd_count].events = POLLIN;
+        fds[fd_count].revents = 0;
+        fd_count++;
+    }
+
+    if (::poll(fds, fd_count, timeout_ms) < 0 && errno != EINTR) {
+        LOG_ERROR("poll error: ", strerror(errno));
+        return ATL_STATUS_FAILURE;
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
 atl_status_t atl_ofi::check(atl_ep_t& ep, atl_req_t& req) {
     atl_status_t status;
     atl_ofi_req_t* ofi_req;
@@ -844,6 +997,9 @@ atl_status_t atl_ofi::get_rank2proc_map(std::shared_ptr<ipmi> pmi,
     else {
         for (size_t prov_idx = 0; prov_idx < ep_names.size(); prov_idx++) {
             size_t named_ep_count = (ctx.provs[prov_idx].sep ? 1 : ctx.ep_count);
+            size_t addr_len = ctx.provs[prov_idx].addr_len;
+            std::vector<int> keys;
+            std::vector<char> addr_names;
 
             for (size_t ep_idx = 0; ep_idx < named_ep_count; ep_idx++) {
                 int key = pmi->get_rank() * ATL_OFI_PMI_PROC_MULTIPLIER +
@@ -863,14 +1019,19 @@ atl_status_t atl_ofi::get_rank2proc_map(std::shared_ptr<ipmi> pmi,
                     ccl_pmix::put(key_str, value);
                 }
                 else {
-                    int ret = pmi->pmrt_kvs_put((char*)ATL_OFI_FI_ADDR_PM_KEY,
-                                                key,
-                                                ctx.provs[prov_idx].eps[ep_idx].name.addr,
-                                                ctx.provs[prov_idx].addr_len);
-                    if (ret) {
-                        LOG_ERROR("pmrt_kvs_put failed: ret: ", ret);
-                        return ATL_STATUS_FAILURE;
-                    }
+                    char* addr = static_cast<char*>(ctx.provs[prov_idx].eps[ep_idx].name.addr);
+                    keys.push_back(key);
+                    addr_names.insert(addr_names.end(), addr, addr + addr_len);
+                }
+            }
+
+            /* publish names of all eps of the provider in a single request */
+            if (!keys.empty()) {
+                int ret = pmi->pmrt_kvs_put_batch(
+                    (char*)ATL_OFI_FI_ADDR_PM_KEY, keys, addr_names.data(), addr_len);
+                if (ret) {
+                    LOG_ERROR("pmrt_kvs_put_batch failed: ret: ", ret);
+                    return ATL_STATUS_FAILURE;
                 }
             }
         }
@@ -896,7 +1057,26 @@ atl_status_t atl_ofi::get_rank2proc_map(std::shared_ptr<ipmi> pmi,
                 ATL_CHECK_STATUS(pmi->pmrt_barrier(), "PMI barrier failed");
             }
 
+            size_t addr_name_len = (prov.is_shm) ? (size_t)FI_NAME_MAX : prov.addr_len;
+            std::vector<char> addr_names;
+
             for (size_t ep_idx = 0; ep_idx < named_ep_count; ep_idx++) {
+                if (ccl::global_data::env().kvs_init_mode != ccl::kvs_mode::pmix_ofi) {
+                    /* fetch names of all ranks for the ep in a single request */
+                    std::vector<int> keys(pmi->get_size());
+                    for (int i = 0; i < pmi->get_size(); i++) {
+                        keys[i] = i * ATL_OFI_PMI_PROC_MULTIPLIER +
+                                  prov_idx * ATL_OFI_PMI_PROV_MULTIPLIER + ep_idx;
+                    }
+                    addr_names.assign(keys.size() * addr_name_len, '\0');
+                    int ret = pmi->pmrt_kvs_get_batch(
+                        (char*)ATL_OFI_FI_ADDR_PM_KEY, keys, addr_names.data(), addr_name_len);
+                    if (ret) {
+                        LOG_ERROR("pmrt_kvs_get_batch failed: ret: ", ret);
+                        return ATL_STATUS_FAILURE;
+                    }
+                }
+
                 for (int i = 0; i < pmi->get_size(); i++) {
                     int key = i * ATL_OFI_PMI_PROC_MULTIPLIER +
                               prov_idx * ATL_OFI_PMI_PROV_MULTIPLIER + ep_idx;
@@ -921,14 +1101,8 @@ atl_status_t atl_ofi::get_rank2proc_map(std::shared_ptr<ipmi> pmi,
                         }
                     }
                     else {
-                        int ret = pmi->pmrt_kvs_get((char*)ATL_OFI_FI_ADDR_PM_KEY,
-                                                    key,
-                                                    (void*)addr_name.data(),
-                                                    addr_name.size());
-                        if (ret) {
-                            LOG_ERROR("pmrt_kvs_get failed: ret: ", ret);
-                            return ATL_STATUS_FAILURE;
-                        }
+                        auto addr_name_it = addr_names.begin() + i * addr_name_len;
+                        addr_name.assign(addr_name_it, addr_name_it + addr_name_len);
                     }
 
                     if (process_address_name(prov_ep_names,
@@ -962,6 +1136,8 @@ std::string atl_ofi::to_string() {
        << "  mnic_exclude_names: " << ccl::utils::vec_to_string(ctx.mnic_exclude_names) << "\n"
        << "  mnic_count: " << ctx.mnic_count << "\n"
        << "  mnic_offset: " << ::to_string(ctx.mnic_offset) << "\n"
+       << "  stripe_size: " << ctx.stripe_size << "\n"
+       << "  stripe_count: " << ctx.stripe_count << "\n"
        << "  max_retry_count: " << ctx.max_retry_count << "\n"
        << "  progress_mode: " << ctx.progress_mode << "\n"
 #ifdef CCL_ENABLE_OFI_HMEM
@@ -1051,7 +1227,200 @@ void atl_ofi::process_comps(atl_ep_t& ep, struct fi_cq_tagged_entry* entries, ss
         if (entries[idx].flags & FI_RECV) {
             comp_ofi_req->recv_len = entries[idx].len;
         }
+
+        if (comp_ofi_req->parent) {
+            complete_stripe(comp_ofi_req);
+        }
+    }
+}
+
+void atl_ofi::complete_stripe(atl_ofi_req_t* stripe_req) {
+    atl_ofi_req_t* parent = stripe_req->parent;
+
+    parent->recv_len += stripe_req->recv_len;
+    CCL_THROW_IF_NOT(parent->pending_stripe_count > 0, "unexpected stripe completion");
+    parent->pending_stripe_count--;
+
+    if (parent->pending_stripe_count == 0) {
+        /* stripe_req is a part of stripes and must not be used after this point */
+        atl_ofi_req_t* stripes = parent->stripes;
+        parent->stripes = nullptr;
+        parent->comp_state = ATL_OFI_COMP_COMPLETED;
+        delete[] stripes;
+    }
+}
+
+void atl_ofi::init_striping(const atl_attr_t& attr) {
+    ctx.stripe_count = std::min(ctx.nw_prov_count, (size_t)(ATL_OFI_MAX_STRIPE_COUNT));
+    if (!attr.in.mnic_stripe_size || ctx.stripe_count < 2) {
+        ctx.stripe_count = 1;
+        return;
+    }
+
+    ctx.stripe_size = attr.in.mnic_stripe_size;
+
+    /*
+        the split of a message must be the same on sender and receiver,
+        so weights are taken from configuration and not from local measurements
+    */
+    ctx.stripe_weights.clear();
+    if (!attr.in.mnic_stripe_weights.empty()) {
+        ccl::utils::str_to_array(attr.in.mnic_stripe_weights, ",", ctx.stripe_weights);
+    }
+    if (ctx.stripe_weights.size() < ctx.stripe_count) {
+        if (!ctx.stripe_weights.empty()) {
+            LOG_WARN("number of stripe weights (",
+                     ctx.stripe_weights.size(),
+                     ") is less than number of stripes (",
+                     ctx.stripe_count,
+                     "), use equal weights");
+        }
+        ctx.stripe_weights.assign(ctx.stripe_count, 1);
+    }
+    ctx.stripe_weights.resize(ctx.stripe_count);
+    CCL_THROW_IF_NOT(std::all_of(ctx.stripe_weights.begin(),
+                                 ctx.stripe_weights.end(),
+                                 [](size_t weight) {
+                                     return weight > 0;
+                                 }),
+                     "stripe weights should be positive: ",
+                     attr.in.mnic_stripe_weights);
+
+    if (coord.global_idx == 0) {
+        LOG_INFO("striping: size ",
+                 ctx.stripe_size,
+                 ", count ",
+                 ctx.stripe_count,
+                 ", weights ",
+                 ccl::utils::vec_to_string(ctx.stripe_weights));
+    }
+}
+
+bool atl_ofi::is_striped(const atl_ofi_prov_t* prov, size_t len) const {
+    return (ctx.stripe_size && !prov->is_shm && len >= ctx.stripe_size);
+}
+
+atl_status_t atl_ofi::post_striped(atl_ep_t& ep,
+                                   void* buf,
+                                   size_t len,
+                                   int peer_proc_idx,
+                                   uint64_t tag,
+                                   atl_req_t& req,
+                                   bool is_send) {
+    ssize_t ret = FI_SUCCESS;
+    atl_ofi_req_t* ofi_req = ((atl_ofi_req_t*)req.internal);
+
+    size_t weight_sum = std::accumulate(ctx.stripe_weights.begin(), ctx.stripe_weights.end(), 0UL);
+
+    /* both sides compute the same split, empty stripes are skipped */
+    size_t stripe_lens[ATL_OFI_MAX_STRIPE_COUNT] = {};
+    size_t stripe_count = 0;
+    size_t offset = 0;
+    for (size_t idx = 0; idx < ctx.stripe_count; idx++) {
+        size_t stripe_len = (idx == ctx.stripe_count - 1)
+                                ? (len - offset)
+                                : (len / weight_sum) * ctx.stripe_weights[idx] +
+                                      (len % weight_sum) * ctx.stripe_weights[idx] / weight_sum;
+        stripe_lens[idx] = stripe_len;
+        offset += stripe_len;
+        if (stripe_len) {
+            stripe_count++;
+        }
+    }
+
+    ofi_req->stripes = new atl_ofi_req_t[stripe_count];
+    ofi_req->stripe_count = stripe_count;
+    ofi_req->pending_stripe_count = stripe_count;
+    ofi_req->recv_len = 0;
+
+    offset = 0;
+    size_t posted_count = 0;
+    for (size_t idx = 0; idx < ctx.stripe_count; idx++) {
+        size_t stripe_len = stripe_lens[idx];
+        if (!stripe_len) {
+            continue;
+        }
+
+        atl_ofi_prov_t* prov =
+            &(ctx.provs[ctx.nw_prov_first_idx + (ep.idx + idx) % ctx.nw_prov_count]);
+        atl_ofi_prov_ep_t* prov_ep = &(prov->eps[ep.idx]);
+        atl_ofi_req_t* stripe_req = &(ofi_req->stripes[posted_count]);
+        char* stripe_buf = static_cast<char*>(buf) + offset;
+        offset += stripe_len;
+
+        stripe_req->prov_ep = prov_ep;
+        stripe_req->fi_ep = (is_send) ? prov_ep->tx : prov_ep->rx;
+        stripe_req->comp_state = ATL_OFI_COMP_POSTED;
+        stripe_req->recv_len = 0;
+        stripe_req->mr = nullptr;
+        stripe_req->parent = ofi_req;
+        stripe_req->stripes = nullptr;
+        stripe_req->stripe_count = 0;
+        stripe_req->pending_stripe_count = 0;
+
+        cache.get(ep, prov, stripe_buf, stripe_len, &stripe_req->mr);
+        void* desc = (stripe_req->mr) ? fi_mr_desc(stripe_req->mr) : nullptr;
+
+        struct iovec iov;
+        iov.iov_base = stripe_buf;
+        iov.iov_len = stripe_len;
+
+        struct fi_msg_tagged msg;
+        msg.desc = &desc;
+        msg.msg_iov = &iov;
+        msg.iov_count = 1;
+        msg.tag = tag;
+        msg.ignore = 0;
+        msg.addr = atl_ofi_get_addr(prov, peer_proc_idx, ep.idx);
+        msg.context = &stripe_req->fi_ctx;
+        msg.data = 0;
+
+        if (posted_count == 0) {
+            /* nothing is posted yet, so the caller can safely retry the whole operation */
+            if (is_send) {
+                ATL_OFI_RETRY(fi_tsendmsg(stripe_req->fi_ep, &msg, 0), ep, ret);
+            }
+            else {
+                ATL_OFI_RETRY(fi_trecvmsg(stripe_req->fi_ep, &msg, 0), ep, ret);
+            }
+            if (ret != FI_SUCCESS) {
+                cache.push(ep.idx, stripe_req->mr);
+                delete[] ofi_req->stripes;
+                ofi_req->stripes = nullptr;
+                ofi_req->stripe_count = 0;
+                ofi_req->pending_stripe_count = 0;
+                return ATL_OFI_RET(ret);
+            }
+        }
+        else {
+            /* the rest of stripes must be posted, otherwise the peer would wait forever */
+            do {
+                ret = (is_send) ? fi_tsendmsg(stripe_req->fi_ep, &msg, 0)
+                                : fi_trecvmsg(stripe_req->fi_ep, &msg, 0);
+                if (ret == -FI_EAGAIN) {
+                    (void)progress_ep(ep);
+                }
+            } while (ret == -FI_EAGAIN);
+            CCL_THROW_IF_NOT(ret == FI_SUCCESS,
+                             "failed to post stripe ",
+                             posted_count,
+                             ", ret: ",
+                             ret,
+                             ", strerror: ",
+                             fi_strerror(-ret));
+        }
+        posted_count++;
     }
+
+    LOG_DEBUG((is_send) ? "send" : "recv",
+              ": striped len ",
+              len,
+              " into ",
+              stripe_count,
+              " stripes, peer ",
+              peer_proc_idx);
+
+    return ATL_STATUS_SUCCESS;
 }
 
 atl_status_t atl_ofi::prov_ep_handle_cq_err(atl_ofi_prov_ep_t* ep) {
@@ -1223,18 +1592,112 @@ void atl_ofi::fi_cache::push(size_t idx, fid_mr* mr) {
 }
 
 atl_ofi::mr_cache::~mr_cache() {
-    if (!cache.empty()) {
-        LOG_WARN("mr cache is not empty, size: ", cache.size());
+    if (!mrs.empty()) {
+        LOG_WARN("mr cache is not empty, size: ", mrs.size());
         clear();
     }
 }
 
 void atl_ofi::mr_cache::clear() {
-    LOG_DEBUG("mr cache size: ", cache.size());
-    for (auto& key_value : cache) {
-        fi_close(&key_value.second->fid);
+    size_t lookups = stats.hits + stats.misses;
+    if (lookups) {
+        LOG_INFO("mr cache: lookups: ",
+                 lookups,
+                 ", hit rate: ",
+                 100.0 * stats.hits / lookups,
+                 "%, registrations: ",
+                 stats.misses,
+                 ", avg registration time: ",
+                 (stats.misses) ? stats.reg_time_usec / stats.misses : 0,
+                 " usec, evictions: ",
+                 stats.evictions,
+                 ", invalidations: ",
+                 stats.invalidations);
+    }
+    stats = {};
+
+    LOG_DEBUG("mr cache size: ", mrs.size(), ", bytes: ", cached_bytes);
+    for (auto& mr_region : mrs) {
+        fi_close(&mr_region.first->fid);
+    }
+    mrs.clear();
+    regions.clear();
+    lru.clear();
+    cached_bytes = 0;
+    max_region_len = 0;
+}
+
+atl_ofi::mr_cache::region_t* atl_ofi::mr_cache::find(fid_domain* domain,
+                                                     uintptr_t start,
+                                                     size_t len) {
+    // regions are ordered by start address, a region covering the range
+    // starts not earlier than max_region_len before the end of the range
+    auto it = regions.upper_bound(key_t(domain, start));
+    while (it != regions.begin()) {
+        --it;
+        region_t* region = it->second;
+        if (it->first.first != domain || region->start + max_region_len < start + len) {
+            break;
+        }
+        if (region->start + region->len >= start + len) {
+            return region;
+        }
+    }
+    return nullptr;
+}
+
+bool atl_ofi::mr_cache::is_valid(region_t* region, void* buf) {
+#ifdef CCL_ENABLE_OFI_HMEM
+    // the address range of a freed device allocation can be reused by a new one,
+    // the registration is valid only for the allocation it was created for
+    if (region->alloc_id) {
+        ze_context_handle_t context = ccl::global_data::get().ze_data->contexts[0];
+        ze_memory_allocation_properties_t alloc_props = ccl::ze::default_alloc_props;
+        ze_device_handle_t alloc_dev = nullptr;
+        ZE_CALL(zeMemGetAllocProperties, (context, buf, &alloc_props, &alloc_dev));
+        return (alloc_props.id == region->alloc_id);
+    }
+#endif // CCL_ENABLE_OFI_HMEM
+    return true;
+}
+
+void atl_ofi::mr_cache::acquire(region_t* region) {
+    if (region->ref_count == 0) {
+        lru.erase(region->lru_it);
+    }
+    region->ref_count++;
+}
+
+void atl_ofi::mr_cache::remove(region_t* region) {
+    auto range = regions.equal_range(key_t(region->domain, region->start));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == region) {
+            regions.erase(it);
+            break;
+        }
+    }
+    region->is_cached = false;
+
+    if (region->ref_count == 0) {
+        lru.erase(region->lru_it);
+        close(region);
+    }
+}
+
+void atl_ofi::mr_cache::close(region_t* region) {
+    LOG_DEBUG("close mr: start: ", (void*)region->start, ", len: ", region->len);
+    cached_bytes -= region->len;
+    fid_mr* mr = region->mr;
+    fi_close(&mr->fid);
+    mrs.erase(mr);
+}
+
+void atl_ofi::mr_cache::evict() {
+    size_t max_size = ccl::global_data::env().atl_cache_max_size;
+    while (max_size && cached_bytes > max_size && !lru.empty()) {
+        stats.evictions++;
+        remove(lru.back());
     }
-    cache.clear();
 }
 
 void atl_ofi::mr_cache::get(atl_ep_t& ep,
@@ -1245,18 +1708,30 @@ void atl_ofi::mr_cache::get(atl_ep_t& ep,
     CCL_THROW_IF_NOT(prov->domain);
     CCL_THROW_IF_NOT(mr);
 
-    if (ccl::global_data::env().enable_atl_cache) {
-        key_t key(prov->domain, buf, bytes);
-        auto key_value = cache.find(key);
-        if (key_value != cache.end()) {
-            *mr = key_value->second;
+    bool use_cache = ccl::global_data::env().enable_atl_cache;
+
+    if (use_cache) {
+        region_t* region = find(prov->domain, reinterpret_cast<uintptr_t>(buf), bytes);
+        if (region && !is_valid(region, buf)) {
+            LOG_DEBUG("invalidated in mr cache: buf: ", buf, ", bytes: ", bytes);
+            stats.invalidations++;
+            remove(region);
+            region = nullptr;
+        }
+
+        if (region) {
+            acquire(region);
+            *mr = region->mr;
+            stats.hits++;
             LOG_DEBUG("loaded from mr cache: buf: ", buf, ", bytes: ", bytes);
             return;
         }
+        stats.misses++;
     }
 
     struct fi_mr_attr mr_attr;
     struct iovec iov;
+    uint64_t alloc_id = 0;
 
     memset(&mr_attr, 0, sizeof(mr_attr));
     memset(&iov, 0, sizeof(iov));
@@ -1283,6 +1758,16 @@ void atl_ofi::mr_cache::get(atl_ep_t& ep,
     if (alloc_props.type == ZE_MEMORY_TYPE_HOST || alloc_props.type == ZE_MEMORY_TYPE_DEVICE ||
         alloc_props.type == ZE_MEMORY_TYPE_SHARED) {
         mr_attr.iface = FI_HMEM_ZE;
+        alloc_id = alloc_props.id;
+
+        if (use_cache) {
+            // register the whole allocation to serve any sub-range of it from the cache
+            void* base = nullptr;
+            size_t size = 0;
+            ZE_CALL(zeMemGetAddressRange, (context, buf, &base, &size));
+            iov.iov_base = base;
+            iov.iov_len = size;
+        }
     }
 
     if (alloc_dev) {
@@ -1302,6 +1787,8 @@ void atl_ofi::mr_cache::get(atl_ep_t& ep,
     }
 #endif // CCL_ENABLE_OFI_HMEM
 
+    auto reg_start = std::chrono::steady_clock::now();
+
     int ofi_ret;
     ATL_OFI_CALL(fi_mr_regattr(prov->domain, &mr_attr, 0, mr),
                  ofi_ret,
@@ -1319,20 +1806,50 @@ void atl_ofi::mr_cache::get(atl_ep_t& ep,
         fi_mr_enable(*mr);
     }
 
-    if (ccl::global_data::env().enable_atl_cache) {
-        key_t key(prov->domain, buf, bytes);
-        LOG_DEBUG("inserted to mr cache: buf: ", buf, ", bytes: ", bytes);
-        cache.insert({ std::move(key), *mr });
+    stats.reg_time_usec += std::chrono::duration<double, std::micro>(
+                               std::chrono::steady_clock::now() - reg_start)
+                               .count();
+
+    if (use_cache) {
+        region_t* region = new region_t{ prov->domain,
+                                         reinterpret_cast<uintptr_t>(iov.iov_base),
+                                         iov.iov_len,
+                                         *mr,
+                                         alloc_id,
+                                         1,
+                                         true,
+                                         lru.end() };
+        LOG_DEBUG("inserted to mr cache: buf: ", iov.iov_base, ", bytes: ", iov.iov_len);
+        regions.insert({ key_t(region->domain, region->start), region });
+        mrs.emplace(*mr, std::unique_ptr<region_t>(region));
+        cached_bytes += region->len;
+        max_region_len = std::max(max_region_len, region->len);
+        evict();
     }
 }
 
 void atl_ofi::mr_cache::push(fid_mr* mr) {
     CCL_THROW_IF_NOT(mr);
-    if (ccl::global_data::env().enable_atl_cache) {
-        /* do nothing, all mem regions will be closed in clear() */
+    if (!ccl::global_data::env().enable_atl_cache) {
+        fi_close(&mr->fid);
         return;
     }
-    fi_close(&mr->fid);
+
+    auto it = mrs.find(mr);
+    CCL_THROW_IF_NOT(it != mrs.end(), "unknown mr ", mr);
+    region_t* region = it->second.get();
+    CCL_THROW_IF_NOT(region->ref_count > 0, "unexpected ref_count for mr ", mr);
+
+    if (--region->ref_count == 0) {
+        if (region->is_cached) {
+            lru.push_front(region);
+            region->lru_it = lru.begin();
+            evict();
+        }
+        else {
+            close(region);
+        }
+    }
 }
 
 fi_addr_t atl_ofi::atl_ofi_get_addr(atl_ofi_prov_t* prov, int proc_idx, size_t ep_idx) {
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <iostream>
+#include <list>
+#include <map>
 #include <memory>
 #include <unordered_map>
 
@@ -58,6 +60,13 @@ public:
                       uint64_t tag,
                       atl_req_t& req) override;
 
+    atl_status_t sendv(atl_ep_t& ep,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int dst_proc_idx,
+                       uint64_t tag,
+                       atl_req_t& req) override;
+
     atl_status_t probe(atl_ep_t& ep,
                        int src_proc_idx,
                        uint64_t tag,
@@ -175,6 +184,8 @@ public:
 
     atl_status_t poll(atl_ep_t& ep) override;
 
+    atl_status_t wait_event(atl_ep_t& ep, int extra_fd, int timeout_ms) override;
+
     atl_status_t check(atl_ep_t& ep, atl_req_t& req) override;
 
     atl_proc_coord_t create_proc_coord(atl_ep_t& ep) override {
@@ -208,6 +219,16 @@ public:
 private:
     atl_status_t progress_ep(atl_ep_t& ep);
     void process_comps(atl_ep_t& ep, struct fi_cq_tagged_entry* entries, ssize_t ret);
+    void complete_stripe(atl_ofi_req_t* stripe_req);
+    void init_striping(const atl_attr_t& attr);
+    bool is_striped(const atl_ofi_prov_t* prov, size_t len) const;
+    atl_status_t post_striped(atl_ep_t& ep,
+                              void* buf,
+                              size_t len,
+                              int peer_proc_idx,
+                              uint64_t tag,
+                              atl_req_t& req,
+                              bool is_send);
     atl_status_t prov_ep_handle_cq_err(atl_ofi_prov_ep_t* ep);
     atl_status_t open_providers(char* prov_env,
                                 const atl_proc_coord_t& coord,
@@ -237,6 +258,10 @@ private:
 
     atl_ofi_ctx_t ctx;
 
+    // range based cache of memory registrations:
+    // a registration covers the whole allocation of the buffer and serves any sub-range of it,
+    // registrations which are not in use are kept in LRU order and released
+    // when the registered size exceeds CCL_ATL_CACHE_MAX_SIZE
     class mr_cache {
     public:
         mr_cache() = default;
@@ -251,11 +276,48 @@ private:
         void push(fid_mr* mr);
 
     private:
+        struct region_t;
+        using key_t = typename std::pair<fid_domain*, uintptr_t>;
+        using lru_t = std::list<region_t*>;
+
+        struct region_t {
+            fid_domain* domain;
+            uintptr_t start;
+            size_t len;
+            fid_mr* mr;
+            // id of the device allocation, 0 for system memory
+            uint64_t alloc_id;
+            size_t ref_count;
+            // false if the region is removed from the lookup,
+            // it is closed once it is not in use
+            bool is_cached;
+            lru_t::iterator lru_it;
+        };
+
+        region_t* find(fid_domain* domain, uintptr_t start, size_t len);
+        bool is_valid(region_t* region, void* buf);
+        void acquire(region_t* region);
+        void remove(region_t* region);
+        void close(region_t* region);
+        void evict();
+
         size_t mr_key = 0;
 
-        using key_t = typename std::tuple<fid_domain*, void*, size_t>;
-        using value_t = fid_mr*;
-        std::unordered_multimap<key_t, value_t, ccl::utils::tuple_hash> cache{};
+        std::multimap<key_t, region_t*> regions{};
+        std::unordered_map<fid_mr*, std::unique_ptr<region_t>> mrs{};
+        // regions which are not in use, the least recently used one is at the back
+        lru_t lru{};
+        size_t cached_bytes = 0;
+        // lookup goes back from the buffer address by at most this length
+        size_t max_region_len = 0;
+
+        struct {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+            size_t invalidations = 0;
+            double reg_time_usec = 0;
+        } stats;
     };
 
     class fi_cache {
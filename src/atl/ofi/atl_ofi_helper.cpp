@@ -772,6 +772,7 @@ void atl_ofi_prov_ep_destroy(atl_ofi_prov_t* prov, atl_ofi_prov_ep_t* ep) {
 
     ep->rx = ep->tx = nullptr;
     ep->cq = nullptr;
+    ep->cq_wait_fd = -1;
     ep->name.addr = nullptr;
     ep->name.len = 0;
 }
@@ -842,7 +843,7 @@ int atl_ofi_wait_cancel_cq(struct fid_cq* cq) {
     return ATL_STATUS_FAILURE;
 }
 
-atl_status_t atl_ofi_prov_ep_init(atl_ofi_prov_t* prov, size_t ep_idx) {
+atl_status_t atl_ofi_prov_ep_init(atl_ofi_prov_t* prov, size_t ep_idx, int enable_cq_wait) {
     ssize_t ret = 0;
 
     struct fi_cq_attr cq_attr;
@@ -850,12 +851,36 @@ atl_status_t atl_ofi_prov_ep_init(atl_ofi_prov_t* prov, size_t ep_idx) {
     struct fi_rx_attr rx_attr;
 
     atl_ofi_prov_ep_t* ep = &(prov->eps[ep_idx]);
+    ep->cq_wait_fd = -1;
 
     memset(&cq_attr, 0, sizeof(cq_attr));
     cq_attr.format = FI_CQ_FORMAT_TAGGED;
 
-    ATL_OFI_CALL(
-        fi_cq_open(prov->domain, &cq_attr, &ep->cq, nullptr), ret, return ATL_STATUS_FAILURE);
+    if (enable_cq_wait) {
+        /* not all providers support fd based wait objects, fallback to polling only cq */
+        cq_attr.wait_obj = FI_WAIT_FD;
+        ret = fi_cq_open(prov->domain, &cq_attr, &ep->cq, nullptr);
+        if (ret == FI_SUCCESS) {
+            ret = fi_control(&ep->cq->fid, FI_GETWAIT, &ep->cq_wait_fd);
+            if (ret != FI_SUCCESS) {
+                ep->cq_wait_fd = -1;
+                fi_close(&ep->cq->fid);
+                ep->cq = nullptr;
+            }
+        }
+        if (ret != FI_SUCCESS) {
+            LOG_DEBUG("provider ",
+                      prov->info->fabric_attr->prov_name,
+                      " doesn't support cq wait fd: ",
+                      fi_strerror(-ret));
+            cq_attr.wait_obj = FI_WAIT_NONE;
+        }
+    }
+
+    if (!ep->cq) {
+        ATL_OFI_CALL(
+            fi_cq_open(prov->domain, &cq_attr, &ep->cq, nullptr), ret, return ATL_STATUS_FAILURE);
+    }
 
     if (prov->sep) {
         rx_attr = *prov->info->rx_attr;
@@ -1195,6 +1220,7 @@ atl_status_t atl_ofi_prov_init(atl_ofi_ctx_t& ctx,
         LOG_INFO("  tx_ctx_cnt: ", info->domain_attr->tx_ctx_cnt);
         LOG_INFO("  max_ep_tx_ctx: ", info->domain_attr->max_ep_tx_ctx);
         LOG_INFO("  max_msg_size: ", info->ep_attr->max_msg_size);
+        LOG_INFO("  inject_size: ", info->tx_attr->inject_size);
     }
 
     prov->info = fi_dupinfo(info);
@@ -1205,6 +1231,8 @@ atl_status_t atl_ofi_prov_init(atl_ofi_ctx_t& ctx,
     }
 
     prov->max_msg_size = info->ep_attr->max_msg_size;
+    /* injected data is read by CPU on the call, device buffers have to go through regular send */
+    prov->inject_size = (ctx.enable_hmem) ? 0 : info->tx_attr->inject_size;
 
     ATL_OFI_CALL(fi_fabric(info->fabric_attr, &prov->fabric, nullptr), ret, goto err);
 
@@ -1227,7 +1255,7 @@ atl_status_t atl_ofi_prov_init(atl_ofi_ctx_t& ctx,
     }
 
     for (ep_idx = 0; ep_idx < ctx.ep_count; ep_idx++) {
-        ret = atl_ofi_prov_ep_init(prov, ep_idx);
+        ret = atl_ofi_prov_ep_init(prov, ep_idx, ctx.enable_cq_wait);
         if (ret) {
             LOG_ERROR("atl_ofi_prov_ep_init error");
             goto err;
@@ -1661,6 +1689,11 @@ void atl_ofi_init_req(atl_req_t& req, atl_ofi_prov_ep_t* prov_ep, struct fid_ep*
     ofi_req->prov_ep = prov_ep;
     ofi_req->fi_ep = fi_ep;
     ofi_req->comp_state = ATL_OFI_COMP_POSTED;
+    ofi_req->mr = nullptr;
+    ofi_req->parent = nullptr;
+    ofi_req->stripes = nullptr;
+    ofi_req->stripe_count = 0;
+    ofi_req->pending_stripe_count = 0;
     req.is_completed = 0;
 }
 
@@ -66,7 +66,8 @@
 #define ATL_OFI_MAX_NW_PROV_COUNT   1024
 #define ATL_OFI_MAX_PROV_COUNT      (ATL_OFI_MAX_NW_PROV_COUNT + 1) /* NW and SHM providers */
 #define ATL_OFI_MAX_ACTIVE_PROV_COUNT \
-    2 /* by current scheme each EP may use only SHM and 1 NW prov */
+    8 /* SHM and 1 NW prov per EP, or SHM and up to 7 NW provs if striping is enabled */
+#define ATL_OFI_MAX_STRIPE_COUNT (ATL_OFI_MAX_ACTIVE_PROV_COUNT - 1)
 #define ATL_OFI_SHM_PROV_NAME "shm"
 
 #define ATL_OFI_MAX_ZE_DEV_COUNT 1024
@@ -168,6 +169,7 @@ typedef struct {
     struct fid_ep* tx;
     struct fid_ep* rx;
     struct fid_cq* cq;
+    int cq_wait_fd; /* -1 if cq has no wait object */
     atl_ofi_prov_ep_name_t name;
 } atl_ofi_prov_ep_t;
 
@@ -181,6 +183,8 @@ typedef struct {
 
     int is_shm;
     size_t max_msg_size;
+    /* sends up to this size are injected, 0 if inject is not used */
+    size_t inject_size;
 
     /* used only in case of SEP supported */
     struct fid_ep* sep;
@@ -212,18 +216,32 @@ typedef struct {
     std::vector<std::string> mnic_exclude_names;
     size_t mnic_count;
     atl_mnic_offset_t mnic_offset;
+    /* messages of at least this size are split across stripe_count NW provs */
+    size_t stripe_size;
+    size_t stripe_count;
+    std::vector<size_t> stripe_weights;
     int enable_hmem;
+    int enable_cq_wait;
 } atl_ofi_ctx_t;
 
-typedef struct {
+typedef struct atl_ofi_req {
     struct fi_context fi_ctx;
     atl_ofi_prov_ep_t* prov_ep;
     struct fid_ep* fi_ep;
     atl_ofi_comp_state_t comp_state;
     size_t recv_len;
     struct fid_mr* mr;
+
+    /* striped request owns per-stripe sub-requests, each sub-request points to its parent */
+    struct atl_ofi_req* parent;
+    struct atl_ofi_req* stripes;
+    size_t stripe_count;
+    size_t pending_stripe_count;
 } atl_ofi_req_t;
 
+static_assert(sizeof(atl_ofi_req_t) <= sizeof(atl_req_t::internal),
+              "atl_ofi_req_t does not fit into atl_req_t");
+
 typedef struct atl_ofi_global_data {
     int is_env_inited;
     void* dlhandle;
@@ -274,7 +292,7 @@ atl_status_t atl_ofi_prov_eps_connect(atl_ofi_ctx_t& ctx,
 void atl_ofi_prov_ep_destroy(atl_ofi_prov_t* prov, atl_ofi_prov_ep_t* ep);
 void atl_ofi_prov_destroy(atl_ofi_ctx_t& ctx, atl_ofi_prov_t* prov);
 int atl_ofi_wait_cancel_cq(struct fid_cq* cq);
-atl_status_t atl_ofi_prov_ep_init(atl_ofi_prov_t* prov, size_t ep_idx);
+atl_status_t atl_ofi_prov_ep_init(atl_ofi_prov_t* prov, size_t ep_idx, int enable_cq_wait);
 atl_status_t atl_ofi_try_to_drain_cq_err(struct fid_cq* cq);
 int atl_ofi_try_to_drain_cq(struct fid_cq* cq);
 void atl_ofi_reset(atl_ofi_ctx_t& ctx);
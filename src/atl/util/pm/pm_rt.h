@@ -16,6 +16,8 @@
 #ifndef PM_RT_H
 #define PM_RT_H
 
+#include <vector>
+
 #include "atl_def.h"
 #include "common/api_wrapper/pmix_api_wrapper.hpp"
 
@@ -75,6 +77,36 @@ public:
                                       void *kvs_val,
                                       size_t kvs_val_len) = 0;
 
+    /* kvs_vals holds proc_idxs.size() values of kvs_val_len bytes each,
+       default implementation issues one request per value */
+    virtual atl_status_t pmrt_kvs_put_batch(char *kvs_key,
+                                            const std::vector<int> &proc_idxs,
+                                            const void *kvs_vals,
+                                            size_t kvs_val_len) {
+        for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+            ATL_CHECK_STATUS(pmrt_kvs_put(kvs_key,
+                                          proc_idxs[idx],
+                                          static_cast<const char *>(kvs_vals) + idx * kvs_val_len,
+                                          kvs_val_len),
+                             "failed to put val");
+        }
+        return ATL_STATUS_SUCCESS;
+    }
+
+    virtual atl_status_t pmrt_kvs_get_batch(char *kvs_key,
+                                            const std::vector<int> &proc_idxs,
+                                            void *kvs_vals,
+                                            size_t kvs_val_len) {
+        for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+            ATL_CHECK_STATUS(pmrt_kvs_get(kvs_key,
+                                          proc_idxs[idx],
+                                          static_cast<char *>(kvs_vals) + idx * kvs_val_len,
+                                          kvs_val_len),
+                             "failed to get val");
+        }
+        return ATL_STATUS_SUCCESS;
+    }
+
     virtual int get_rank() = 0;
 
     virtual int get_size() = 0;
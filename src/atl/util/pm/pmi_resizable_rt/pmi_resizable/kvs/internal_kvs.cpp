@@ -145,6 +145,41 @@ kvs_status_t internal_kvs::kvs_get_value_by_name_key(const std::string& kvs_name
     return KVS_STATUS_SUCCESS;
 }
 
+kvs_status_t internal_kvs::kvs_set_values(const std::string& kvs_name,
+                                          const std::vector<std::string>& kvs_keys,
+                                          const std::vector<std::string>& kvs_vals) {
+    assert_throw_can_use_internal_kvs();
+    KVS_ERROR_IF_NOT(kvs_keys.size() == kvs_vals.size());
+    kvs_request_t request;
+    KVS_CHECK_STATUS(request.put_batch(client_op_sock,
+                                       AM_PUT_BATCH,
+                                       client_memory_mutex,
+                                       kvs_name,
+                                       kvs_keys,
+                                       kvs_vals),
+                     "client: put_batch");
+    return KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t internal_kvs::kvs_get_values_by_name_keys(const std::string& kvs_name,
+                                                       const std::vector<std::string>& kvs_keys,
+                                                       std::vector<std::string>& kvs_vals) {
+    assert_throw_can_use_internal_kvs();
+    kvs_request_t request;
+    KVS_CHECK_STATUS(request.put_batch(client_op_sock,
+                                       AM_GET_BATCH,
+                                       client_memory_mutex,
+                                       kvs_name,
+                                       kvs_keys,
+                                       std::vector<std::string>{}),
+                     "client: get_batch");
+
+    KVS_CHECK_STATUS(request.get(client_op_sock, client_memory_mutex, kvs_vals),
+                     "client: get_batch read data");
+    KVS_ERROR_IF_NOT(kvs_vals.size() == kvs_keys.size(), "unexpected count ", kvs_vals.size());
+    return KVS_STATUS_SUCCESS;
+}
+
 kvs_status_t internal_kvs::kvs_get_count_names(const std::string& kvs_name, size_t& count_names) {
     assert_throw_can_use_internal_kvs();
     count_names = 0;
@@ -51,6 +51,16 @@ public:
                                            const std::string& kvs_key,
                                            std::string& kvs_val) override;
 
+    /* single round trip for a set of keys within one name */
+    kvs_status_t kvs_set_values(const std::string& kvs_name,
+                                const std::vector<std::string>& kvs_keys,
+                                const std::vector<std::string>& kvs_vals);
+
+    /* absent keys are returned as empty values */
+    kvs_status_t kvs_get_values_by_name_keys(const std::string& kvs_name,
+                                             const std::vector<std::string>& kvs_keys,
+                                             std::vector<std::string>& kvs_vals);
+
     kvs_status_t kvs_register(const std::string& kvs_name,
                               const std::string& kvs_key,
                               std::string& kvs_val);
@@ -19,12 +19,13 @@
 #include <list>
 #include <map>
 #include <mutex>
-#include <poll.h>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <sys/epoll.h>
 #include <unistd.h>
 #include <memory>
+#include <unordered_set>
 
 #include "common/log/log.hpp"
 #include "internal_kvs_server.hpp"
@@ -34,7 +35,7 @@ public:
     server(server_args_t* server_args) : args(server_args) {}
     kvs_status_t run();
     kvs_status_t check_finalize(size_t& to_finalize);
-    kvs_status_t make_client_request(int& socket);
+    kvs_status_t make_client_request(int socket);
     kvs_status_t try_to_connect_new();
 
 private:
@@ -62,86 +63,91 @@ private:
     struct barrier_info {
         size_t global_size = 0;
         size_t local_size = 0;
-        std::list<std::shared_ptr<clients_info>> clients;
+        /* number of registered clients currently waiting in barrier */
+        size_t arrived_count = 0;
+        std::map<int, std::shared_ptr<clients_info>> clients;
     };
-    enum fd_indexes { FDI_LISTENER = 0, FDI_CONTROL = 1, FDI_LAST = 2 };
+
+    kvs_status_t add_socket(int socket);
+    kvs_status_t remove_socket(int socket);
 
     kvs_request_t request{};
     size_t count{};
     size_t client_count = 0;
     const size_t max_client_queue_size = 300;
-    const size_t client_count_increase = 300;
+    const size_t max_events = 300;
     std::map<std::string, barrier_info> barriers;
     std::map<std::string, comm_info> communicators;
     std::mutex server_memory_mutex;
     std::map<std::string, std::map<std::string, std::string>> requests;
     const int free_socket = -1;
-    std::vector<struct pollfd> poll_fds;
+    int epoll_fd = free_socket;
+    int listener_fd = free_socket;
+    int control_fd = free_socket;
+    std::unordered_set<int> client_sockets;
 
     sa_family_t address_family{ AF_UNSPEC };
     std::unique_ptr<server_args_t> args;
 };
 
+kvs_status_t server::add_socket(int socket) {
+    struct epoll_event event {};
+    /* level triggered: a request that was not read completely is reported again */
+    event.events = EPOLLIN;
+    event.data.fd = socket;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, socket, &event) < 0) {
+        LOG_ERROR("epoll_ctl add: ", strerror(errno));
+        return KVS_STATUS_FAILURE;
+    }
+    return KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t server::remove_socket(int socket) {
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_DEL, socket, nullptr) < 0) {
+        LOG_ERROR("epoll_ctl del: ", strerror(errno));
+        return KVS_STATUS_FAILURE;
+    }
+    return KVS_STATUS_SUCCESS;
+}
+
 kvs_status_t server::try_to_connect_new() {
-    if (poll_fds[FDI_LISTENER].revents != 0) {
-        std::shared_ptr<isockaddr> addr;
+    std::shared_ptr<isockaddr> addr;
 
-        if (address_family == AF_INET) {
-            addr = std::shared_ptr<isockaddr>(new sockaddr_v4());
-        }
-        else {
-            addr = std::shared_ptr<isockaddr>(new sockaddr_v6());
-        }
+    if (address_family == AF_INET) {
+        addr = std::shared_ptr<isockaddr>(new sockaddr_v4());
+    }
+    else {
+        addr = std::shared_ptr<isockaddr>(new sockaddr_v6());
+    }
 
-        int new_socket;
-        bool socket_found = false;
-        socklen_t peer_addr_size = addr->size();
-        if ((new_socket = accept(poll_fds[FDI_LISTENER].fd,
-                                 addr->get_sock_addr_ptr(),
-                                 (socklen_t*)&peer_addr_size)) < 0) {
-            LOG_ERROR("server_listen_sock accept:", strerror(errno));
-            return KVS_STATUS_FAILURE;
-        }
-        for (size_t i = FDI_LAST; i < poll_fds.size(); i++) {
-            if (poll_fds[i].fd == free_socket) {
-                poll_fds[i].fd = new_socket;
-                socket_found = true;
-                break;
-            }
-        }
-        if (!socket_found) {
-            // the code is written in a way that there should always be a free socket available
-            // if no socket is found, this means that there is an error in the code
-            // or that out of memory exception occurred while resizing the poll_fds vector
-            // and it was not properly handled in the layers above internal_kvs_server
-            LOG_ERROR("free socket not found; this indicates programmer's error");
-            if (close(new_socket)) {
-                // we are already returning failure, there is not much we can do
-                // except for logging the exact error that occurred
-                LOG_ERROR("error closing a socket: ", strerror(errno));
-            }
-            return KVS_STATUS_FAILURE;
-        }
-        client_count++;
-        if (poll_fds.size() - FDI_LAST == client_count) {
-            size_t old_size = poll_fds.size();
-            poll_fds.resize(old_size + client_count_increase);
-            for (size_t i = old_size; i < poll_fds.size(); i++) {
-                poll_fds[i].fd = free_socket;
-                poll_fds[i].events = POLLIN;
-            }
+    int new_socket;
+    socklen_t peer_addr_size = addr->size();
+    if ((new_socket = accept(listener_fd, addr->get_sock_addr_ptr(), (socklen_t*)&peer_addr_size)) <
+        0) {
+        LOG_ERROR("server_listen_sock accept:", strerror(errno));
+        return KVS_STATUS_FAILURE;
+    }
+    if (add_socket(new_socket) != KVS_STATUS_SUCCESS) {
+        if (close(new_socket)) {
+            // we are already returning failure, there is not much we can do
+            // except for logging the exact error that occurred
+            LOG_ERROR("error closing a socket: ", strerror(errno));
         }
+        return KVS_STATUS_FAILURE;
     }
+    client_sockets.insert(new_socket);
+    client_count++;
     return KVS_STATUS_SUCCESS;
 }
 
-kvs_status_t server::make_client_request(int& socket) {
+kvs_status_t server::make_client_request(int socket) {
     KVS_CHECK_STATUS(request.get(socket, server_memory_mutex), "server: get command from client");
 
     switch (request.mode) {
         case AM_CLOSE: {
+            KVS_CHECK_STATUS(remove_socket(socket), "server: remove socket");
             close(socket);
-            socket = free_socket;
+            client_sockets.erase(socket);
             client_count--;
             break;
         }
@@ -150,6 +156,30 @@ kvs_status_t server::make_client_request(int& socket) {
             req[request.key] = request.val;
             break;
         }
+        case AM_PUT_BATCH: {
+            auto& req = requests[request.name];
+            for (size_t idx = 0; idx < request.batch_keys.size(); idx++) {
+                /* keep the same C string semantics as for AM_PUT */
+                req[request.batch_keys[idx]] = request.batch_vals[idx].c_str();
+            }
+            break;
+        }
+        case AM_GET_BATCH: {
+            /* absent keys are reported as empty values */
+            std::vector<std::string> vals(request.batch_keys.size());
+            auto it_name = requests.find(request.name);
+            if (it_name != requests.end()) {
+                for (size_t idx = 0; idx < request.batch_keys.size(); idx++) {
+                    auto it_key = it_name->second.find(request.batch_keys[idx]);
+                    if (it_key != it_name->second.end()) {
+                        vals[idx] = it_key->second;
+                    }
+                }
+            }
+            KVS_CHECK_STATUS(request.put(socket, server_memory_mutex, vals),
+                             "server: put batch values");
+            break;
+        }
         case AM_REMOVE: {
             requests[request.name].erase(request.key);
             break;
@@ -212,34 +242,28 @@ kvs_status_t server::make_client_request(int& socket) {
         case AM_BARRIER: {
             auto& barrier_list = barriers[request.name];
             auto& clients = barrier_list.clients;
-            auto client_it = std::find_if(std::begin(clients),
-                                          std::end(clients),
-                                          [&](std::shared_ptr<server::clients_info> v) {
-                                              return v->socket == socket;
-                                          });
+            auto client_it = clients.find(socket);
             if (client_it == clients.end()) {
                 // TODO: Look deeper to fix this error
                 LOG_ERROR("Server error: Unregister Barrier request!");
                 return KVS_STATUS_FAILURE;
             }
-            auto client_inf = client_it->get();
-            client_inf->in_barrier = true;
+            auto client_inf = client_it->second.get();
+            if (!client_inf->in_barrier) {
+                client_inf->in_barrier = true;
+                barrier_list.arrived_count++;
+            }
 
-            if (barrier_list.global_size == barrier_list.local_size) {
-                bool is_barrier_stop = true;
+            /* arrival is O(1), clients are walked only once to release them */
+            if (barrier_list.global_size == barrier_list.local_size &&
+                barrier_list.arrived_count == clients.size()) {
+                size_t is_done = 1;
+                barrier_list.arrived_count = 0;
                 for (const auto& client : clients) {
-                    if (!client->in_barrier) {
-                        is_barrier_stop = false;
-                        break;
-                    }
-                }
-                if (is_barrier_stop) {
-                    size_t is_done = 1;
-                    for (const auto& client : clients) {
-                        client->in_barrier = false;
-                        KVS_CHECK_STATUS(request.put(client->socket, server_memory_mutex, is_done),
-                                         "server: barrier");
-                    }
+                    client.second->in_barrier = false;
+                    KVS_CHECK_STATUS(
+                        request.put(client.second->socket, server_memory_mutex, is_done),
+                        "server: barrier");
                 }
             }
             break;
@@ -263,8 +287,7 @@ kvs_status_t server::make_client_request(int& socket) {
             KVS_CHECK_STATUS(safe_strtol(glob_size, barrier.global_size),
                              "failed to convert global_size");
 
-            barrier.clients.push_back(
-                std::shared_ptr<clients_info>(new clients_info(socket, false)));
+            barrier.clients[socket] = std::shared_ptr<clients_info>(new clients_info(socket, false));
             break;
         }
         case AM_SET_SIZE: {
@@ -339,15 +362,13 @@ kvs_status_t server::make_client_request(int& socket) {
 
 kvs_status_t server::check_finalize(size_t& to_finalize) {
     to_finalize = false;
-    if (poll_fds[FDI_CONTROL].revents != 0) {
-        KVS_CHECK_STATUS(request.get(poll_fds[FDI_CONTROL].fd, server_memory_mutex),
-                         "server: get control msg from client");
-        if (request.mode != AM_FINALIZE) {
-            LOG_ERROR("invalid access mode for local socket\n");
-            return KVS_STATUS_FAILURE;
-        }
-        to_finalize = true;
+    KVS_CHECK_STATUS(request.get(control_fd, server_memory_mutex),
+                     "server: get control msg from client");
+    if (request.mode != AM_FINALIZE) {
+        LOG_ERROR("invalid access mode for local socket\n");
+        return KVS_STATUS_FAILURE;
     }
+    to_finalize = true;
     return KVS_STATUS_SUCCESS;
 }
 
@@ -361,73 +382,92 @@ kvs_status_t server::run() {
     int reuse_optname = SO_REUSEADDR;
 #endif
 
-    poll_fds.resize(client_count_increase);
-    for (auto& it : poll_fds) {
-        it.fd = free_socket;
-        it.events = POLLIN;
-    }
-    poll_fds[FDI_LISTENER].fd = args->sock_listener;
+    listener_fd = args->sock_listener;
     address_family = args->args->sin_family();
 
-    if (setsockopt(
-            poll_fds[FDI_LISTENER].fd, SOL_SOCKET, reuse_optname, &so_reuse, sizeof(so_reuse))) {
+    if (setsockopt(listener_fd, SOL_SOCKET, reuse_optname, &so_reuse, sizeof(so_reuse))) {
         LOG_ERROR("server_listen_sock setsockopt(%s)", strerror(errno));
         return KVS_STATUS_FAILURE;
     }
 
-    if (listen(poll_fds[FDI_LISTENER].fd, max_client_queue_size) < 0) {
+    if (listen(listener_fd, max_client_queue_size) < 0) {
         LOG_ERROR("server_listen_sock listen(%s)", strerror(errno));
         return KVS_STATUS_FAILURE;
     }
 
-    if ((poll_fds[FDI_CONTROL].fd = socket(address_family, SOCK_STREAM, 0)) < 0) {
+    if ((control_fd = socket(address_family, SOCK_STREAM, 0)) < 0) {
         LOG_ERROR("server_control_sock init(%s)", strerror(errno));
         return KVS_STATUS_FAILURE;
     }
 
-    while (connect(poll_fds[FDI_CONTROL].fd, args->args->get_sock_addr_ptr(), args->args->size()) <
-           0) {
+    while (connect(control_fd, args->args->get_sock_addr_ptr(), args->args->size()) < 0) {
     }
+
+    if ((epoll_fd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        LOG_ERROR("epoll_create(%s)", strerror(errno));
+        return KVS_STATUS_FAILURE;
+    }
+    KVS_CHECK_STATUS(add_socket(listener_fd), "failed to add listener socket");
+    KVS_CHECK_STATUS(add_socket(control_fd), "failed to add control socket");
+
+    /* cost of a wakeup depends on the number of ready sockets only, not on the number of clients */
+    std::vector<struct epoll_event> events(max_events);
     while (!should_stop || client_count > 0) {
-        if (poll(poll_fds.data(), poll_fds.size(), -1) < 0) {
+        int event_count = epoll_wait(epoll_fd, events.data(), events.size(), -1);
+        if (event_count < 0) {
             if (errno != EINTR) {
-                LOG_ERROR("poll(%s)", strerror(errno));
+                LOG_ERROR("epoll_wait(%s)", strerror(errno));
                 return KVS_STATUS_FAILURE;
             }
             else {
-                /* restart select */
+                /* restart epoll_wait */
                 continue;
             }
         }
 
-        for (size_t i = FDI_LAST; i < poll_fds.size(); i++) {
-            if (poll_fds[i].fd != free_socket && poll_fds[i].revents != 0) {
-                KVS_CHECK_STATUS(make_client_request(poll_fds[i].fd), "failed to make request");
+        /* handle new connections after requests, so a socket closed in this batch
+           can not be reused by accept while its stale event is still pending */
+        bool is_listener_ready = false;
+        bool is_control_ready = false;
+        for (int i = 0; i < event_count; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listener_fd) {
+                is_listener_ready = true;
+            }
+            else if (fd == control_fd) {
+                is_control_ready = true;
+            }
+            else if (client_sockets.find(fd) != client_sockets.end()) {
+                KVS_CHECK_STATUS(make_client_request(fd), "failed to make request");
             }
         }
-        KVS_CHECK_STATUS(try_to_connect_new(), "failed to connect new");
-        if (!should_stop) {
+        if (is_listener_ready) {
+            KVS_CHECK_STATUS(try_to_connect_new(), "failed to connect new");
+        }
+        if (is_control_ready && !should_stop) {
             KVS_CHECK_STATUS(check_finalize(should_stop), "failed to check finalize");
+            if (should_stop) {
+                KVS_CHECK_STATUS(remove_socket(control_fd), "failed to remove control socket");
+            }
         }
     }
 
-    if (poll_fds[FDI_CONTROL].fd != free_socket) {
-        KVS_CHECK_STATUS(request.put(poll_fds[FDI_CONTROL].fd, server_memory_mutex, should_stop),
-                         "server: put control msg to client");
-    }
+    KVS_CHECK_STATUS(request.put(control_fd, server_memory_mutex, should_stop),
+                     "server: put control msg to client");
 
-    close(poll_fds[FDI_CONTROL].fd);
-    poll_fds[FDI_CONTROL].fd = free_socket;
+    close(control_fd);
+    control_fd = free_socket;
 
-    for (size_t i = FDI_LAST; i < poll_fds.size(); i++) {
-        if (poll_fds[i].fd != free_socket) {
-            close(poll_fds[i].fd);
-            poll_fds[i].fd = free_socket;
-        }
+    for (auto socket : client_sockets) {
+        close(socket);
     }
+    client_sockets.clear();
+
+    close(listener_fd);
+    listener_fd = free_socket;
 
-    close(poll_fds[FDI_LISTENER].fd);
-    poll_fds[FDI_LISTENER].fd = free_socket;
+    close(epoll_fd);
+    epoll_fd = free_socket;
     return KVS_STATUS_SUCCESS;
 }
 
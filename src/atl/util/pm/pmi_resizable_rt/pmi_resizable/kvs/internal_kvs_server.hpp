@@ -15,7 +15,11 @@
 */
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "util/pm/pmi_resizable_rt/pmi_resizable/def.h"
 #include "internal_kvs.h"
@@ -37,8 +41,20 @@ enum kvs_access_mode_t : uint32_t {
     AM_BARRIER_REGISTER = 10,
     AM_INTERNAL_REGISTER = 11,
     AM_SET_SIZE = 12,
+    AM_PUT_BATCH = 13,
+    AM_GET_BATCH = 14,
 };
 
+/*
+   wire format, all integers are little endian
+
+   request:  u32 frame_len | u32 mode | str name | str key | str val |
+             u32 batch_count | batch_count x (str key | str val)
+   str:      u32 len | len bytes, no padding and no terminating zero
+
+   scalar replies (counts, flags) are sent as raw size_t,
+   string replies are framed: u32 frame_len | u32 count | count x str
+*/
 class kvs_request_t {
 public:
     kvs_status_t put(int sock,
@@ -47,44 +63,19 @@ public:
                      const std::string& kvs_name = {},
                      const std::string& kvs_key = {},
                      const std::string& kvs_val = {}) {
-        std::vector<char> put_buf(put_buf_size, 0);
-        size_t step = 0;
-        // convert local endianness to little endian
-        uint8_t put_mode_buff[4]{
-            (static_cast<uint8_t>((static_cast<uint32_t>(put_mode) >> 0) & 0xFF)),
-            (static_cast<uint8_t>((static_cast<uint32_t>(put_mode) >> 8) & 0xFF)),
-            (static_cast<uint8_t>((static_cast<uint32_t>(put_mode) >> 16) & 0xFF)),
-            (static_cast<uint8_t>((static_cast<uint32_t>(put_mode) >> 24) & 0xFF)),
-        };
-        static_assert(sizeof(put_mode_buff) == sizeof(mode),
-                      "`mode` size is no longer compatible with `put_mode_buff`");
-        static_assert(sizeof(put_mode_buff) == sizeof(put_mode),
-                      "`put_mode` size is no longer compatible with `put_mode_buff`");
-        static_assert(sizeof(put_mode_buff) == sizeof(kvs_access_mode_t),
-                      "`kvs_access_mode_t` size is no longer compatible with `put_mode_buff`");
-        std::copy(std::begin(put_mode_buff), std::end(put_mode_buff), put_buf.begin());
-
-        if (!kvs_name.empty()) {
-            KVS_ERROR_IF_NOT(kvs_name.length() <= MAX_KVS_NAME_LENGTH);
-            step += sizeof(mode);
-            std::copy(kvs_name.begin(), kvs_name.end(), put_buf.begin() + step);
-        }
-
-        if (!kvs_key.empty()) {
-            KVS_ERROR_IF_NOT(kvs_key.length() <= MAX_KVS_KEY_LENGTH);
-            step += sizeof(name);
-            std::copy(kvs_key.begin(), kvs_key.end(), put_buf.begin() + step);
-        }
-
-        if (!kvs_val.empty()) {
-            KVS_ERROR_IF_NOT(kvs_val.length() <= MAX_KVS_VAL_LENGTH);
-            step += sizeof(key);
-            std::copy(kvs_val.begin(), kvs_val.end(), put_buf.begin() + step);
-        }
+        return put_batch(sock, put_mode, memory_mutex, kvs_name, kvs_key, kvs_val, {}, {});
+    }
 
-        DO_RW_OP(write, sock, put_buf.data(), put_buf.size(), memory_mutex);
-        return KVS_STATUS_SUCCESS;
+    /* single round trip for many keys of one name, kvs_vals is empty for AM_GET_BATCH */
+    kvs_status_t put_batch(int sock,
+                           kvs_access_mode_t put_mode,
+                           std::mutex& memory_mutex,
+                           const std::string& kvs_name,
+                           const std::vector<std::string>& kvs_keys,
+                           const std::vector<std::string>& kvs_vals) {
+        return put_batch(sock, put_mode, memory_mutex, kvs_name, {}, {}, kvs_keys, kvs_vals);
     }
+
     kvs_status_t put(int sock, std::mutex& memory_mutex, size_t put_buf) {
         const size_t sizeof_put_buf = sizeof(put_buf);
         DO_RW_OP(write, sock, &put_buf, sizeof_put_buf, memory_mutex);
@@ -92,32 +83,28 @@ public:
     }
     kvs_status_t put(int sock, std::mutex& memory_mutex, const std::string& put_buf) {
         KVS_ERROR_IF_NOT(put_buf.size() <= MAX_KVS_VAL_LENGTH);
-        std::vector<char> tmp_val(MAX_KVS_VAL_LENGTH, 0);
-        std::copy(put_buf.begin(), put_buf.end(), tmp_val.begin());
-
-        DO_RW_OP(write, sock, tmp_val.data(), tmp_val.size(), memory_mutex);
-        return KVS_STATUS_SUCCESS;
+        return put(sock, memory_mutex, std::vector<std::string>{ put_buf });
+    }
+    kvs_status_t put(int sock, std::mutex& memory_mutex, const std::vector<std::string>& put_bufs) {
+        std::vector<char> frame = begin_frame();
+        append_u32(frame, put_bufs.size());
+        for (auto& put_buf : put_bufs) {
+            append_str(frame, put_buf);
+        }
+        return write_frame(sock, memory_mutex, frame);
     }
     kvs_status_t put(int sock,
                      std::mutex& memory_mutex,
                      const std::map<std::string, std::string>& requests) {
-        std::vector<char> tmp_val((MAX_KVS_KEY_LENGTH + MAX_KVS_VAL_LENGTH) * requests.size(), 0);
-        size_t i = 0;
+        std::vector<char> frame = begin_frame();
+        append_u32(frame, 2 * requests.size());
         for (auto& request : requests) {
             KVS_ERROR_IF_NOT(request.first.size() <= MAX_KVS_KEY_LENGTH);
-            std::copy(request.first.begin(),
-                      request.first.end(),
-                      tmp_val.begin() + i * MAX_KVS_KEY_LENGTH);
             KVS_ERROR_IF_NOT(request.second.size() <= MAX_KVS_VAL_LENGTH);
-            std::copy(
-                request.second.begin(),
-                request.second.end(),
-                tmp_val.begin() + MAX_KVS_KEY_LENGTH * requests.size() + i * MAX_KVS_VAL_LENGTH);
-            i++;
+            append_str(frame, request.first);
+            append_str(frame, request.second);
         }
-
-        DO_RW_OP(write, sock, tmp_val.data(), tmp_val.size(), memory_mutex);
-        return KVS_STATUS_SUCCESS;
+        return write_frame(sock, memory_mutex, frame);
     }
     kvs_status_t get(int sock, std::mutex& memory_mutex, size_t& get_buf) {
         const size_t sizeof_get_buf = sizeof(get_buf);
@@ -125,10 +112,24 @@ public:
         return KVS_STATUS_SUCCESS;
     }
     kvs_status_t get(int sock, std::mutex& memory_mutex, std::string& get_buf) {
-        get_buf.clear();
-        std::vector<char> output_vec(MAX_KVS_VAL_LENGTH, 0);
-        DO_RW_OP(read, sock, output_vec.data(), output_vec.size(), memory_mutex);
-        std::copy(output_vec.begin(), output_vec.end(), std::back_inserter(get_buf));
+        std::vector<std::string> get_bufs;
+        KVS_CHECK_STATUS(get(sock, memory_mutex, get_bufs), "failed to read value");
+        KVS_ERROR_IF_NOT(get_bufs.size() == 1, "unexpected value count ", get_bufs.size());
+        get_buf = std::move(get_bufs[0]);
+        /* callers treat the value as zero padded C string of max length */
+        get_buf.resize(std::max(get_buf.size(), (size_t)MAX_KVS_VAL_LENGTH), 0);
+        return KVS_STATUS_SUCCESS;
+    }
+    kvs_status_t get(int sock, std::mutex& memory_mutex, std::vector<std::string>& get_bufs) {
+        std::vector<char> frame;
+        KVS_CHECK_STATUS(read_frame(sock, memory_mutex, frame), "failed to read frame");
+        size_t offset = 0;
+        uint32_t count = 0;
+        KVS_CHECK_STATUS(read_u32(frame, offset, count), "failed to read count");
+        get_bufs.resize(count);
+        for (auto& get_buf : get_bufs) {
+            KVS_CHECK_STATUS(read_str(frame, offset, get_buf), "failed to read value");
+        }
         return KVS_STATUS_SUCCESS;
     }
 
@@ -137,26 +138,23 @@ public:
                      size_t count,
                      std::vector<std::string>& key_buf,
                      std::vector<std::string>& val_buf) {
-        std::vector<char> tmp_val(count * (MAX_KVS_KEY_LENGTH + MAX_KVS_VAL_LENGTH), 0);
-        DO_RW_OP(read, sock, tmp_val.data(), tmp_val.size(), memory_mutex);
-        auto it = tmp_val.begin();
+        std::vector<std::string> get_bufs;
+        KVS_CHECK_STATUS(get(sock, memory_mutex, get_bufs), "failed to read keys and values");
+        KVS_ERROR_IF_NOT(get_bufs.size() == 2 * count, "unexpected count ", get_bufs.size());
         // if vector is empty then skip processing
         // user doesn't need this result
         if (!key_buf.empty()) {
             key_buf.resize(count);
             for (size_t i = 0; i < count; i++) {
+                key_buf[i] = std::move(get_bufs[2 * i]);
                 key_buf[i].resize(MAX_KVS_KEY_LENGTH, 0);
-                std::copy(it, it + MAX_KVS_KEY_LENGTH, key_buf[i].begin());
-                it += MAX_KVS_KEY_LENGTH;
             }
         }
         if (!val_buf.empty()) {
             val_buf.resize(count);
-            it = tmp_val.begin() + count * MAX_KVS_KEY_LENGTH;
             for (size_t i = 0; i < count; i++) {
+                val_buf[i] = std::move(get_bufs[2 * i + 1]);
                 val_buf[i].resize(MAX_KVS_VAL_LENGTH, 0);
-                std::copy(it, it + MAX_KVS_VAL_LENGTH, val_buf[i].begin());
-                it += MAX_KVS_VAL_LENGTH;
             }
         }
 
@@ -164,37 +162,152 @@ public:
     }
     kvs_status_t get(int sock, std::mutex& memory_mutex) {
         int ret = 0;
-        std::vector<char> get_buf(put_buf_size, 0);
-        DO_RW_OP_1(read, sock, get_buf.data(), get_buf.size(), ret);
+        uint8_t len_buf[sizeof(uint32_t)]{};
+        DO_RW_OP_1(read, sock, len_buf, sizeof(len_buf), ret);
         if (ret == 0) {
             mode = AM_CLOSE;
             return KVS_STATUS_SUCCESS;
         }
-        auto it_get_buf = get_buf.begin();
-        uint8_t temp_mode[4]{ 0 };
-        static_assert(sizeof(temp_mode) == sizeof(kvs_access_mode_t),
-                      "`kvs_access_mode_t` size is no longer compatible with `temp_mode`");
-        std::copy(it_get_buf, it_get_buf + sizeof(mode), temp_mode);
-        // convert little-endian from serialized buffer to host endianness
-        mode = static_cast<kvs_access_mode_t>((temp_mode[0] << 0) | (temp_mode[1] << 8) |
-                                              (temp_mode[2] << 16) | (temp_mode[3] << 24));
-        it_get_buf += sizeof(mode);
-        std::copy(it_get_buf, it_get_buf + sizeof(name), name);
-        it_get_buf += sizeof(name);
-        std::copy(it_get_buf, it_get_buf + sizeof(key), key);
-        it_get_buf += sizeof(key);
-        std::copy(it_get_buf, it_get_buf + sizeof(val), val);
+
+        size_t offset = 0;
+        uint32_t frame_len = 0;
+        std::vector<char> frame(std::begin(len_buf), std::end(len_buf));
+        KVS_CHECK_STATUS(read_u32(frame, offset, frame_len), "failed to read frame length");
+        KVS_ERROR_IF_NOT(frame_len <= max_frame_len, "too long frame ", frame_len);
+
+        frame.resize(frame_len);
+        if (frame_len)
+            DO_RW_OP(read, sock, frame.data(), frame.size(), memory_mutex);
+
+        offset = 0;
+        uint32_t temp_mode = 0;
+        KVS_CHECK_STATUS(read_u32(frame, offset, temp_mode), "failed to read mode");
+        mode = static_cast<kvs_access_mode_t>(temp_mode);
+
+        std::string str;
+        KVS_CHECK_STATUS(read_str(frame, offset, str), "failed to read name");
+        KVS_CHECK_STATUS(copy_field(str, name, sizeof(name)), "failed to copy name");
+        KVS_CHECK_STATUS(read_str(frame, offset, str), "failed to read key");
+        KVS_CHECK_STATUS(copy_field(str, key, sizeof(key)), "failed to copy key");
+        KVS_CHECK_STATUS(read_str(frame, offset, str), "failed to read val");
+        KVS_CHECK_STATUS(copy_field(str, val, sizeof(val)), "failed to copy val");
+
+        uint32_t batch_count = 0;
+        KVS_CHECK_STATUS(read_u32(frame, offset, batch_count), "failed to read batch count");
+        batch_keys.resize(batch_count);
+        batch_vals.resize(batch_count);
+        for (uint32_t idx = 0; idx < batch_count; idx++) {
+            KVS_CHECK_STATUS(read_str(frame, offset, batch_keys[idx]), "failed to read key");
+            KVS_CHECK_STATUS(read_str(frame, offset, batch_vals[idx]), "failed to read val");
+        }
 
         return KVS_STATUS_SUCCESS;
     }
 
 private:
+    kvs_status_t put_batch(int sock,
+                           kvs_access_mode_t put_mode,
+                           std::mutex& memory_mutex,
+                           const std::string& kvs_name,
+                           const std::string& kvs_key,
+                           const std::string& kvs_val,
+                           const std::vector<std::string>& kvs_keys,
+                           const std::vector<std::string>& kvs_vals) {
+        KVS_ERROR_IF_NOT(kvs_name.length() <= MAX_KVS_NAME_LENGTH);
+        KVS_ERROR_IF_NOT(kvs_key.length() <= MAX_KVS_KEY_LENGTH);
+        KVS_ERROR_IF_NOT(kvs_val.length() <= MAX_KVS_VAL_LENGTH);
+        KVS_ERROR_IF_NOT(kvs_vals.empty() || (kvs_vals.size() == kvs_keys.size()));
+
+        std::vector<char> frame = begin_frame();
+        append_u32(frame, put_mode);
+        append_str(frame, kvs_name);
+        append_str(frame, kvs_key);
+        append_str(frame, kvs_val);
+        append_u32(frame, kvs_keys.size());
+        for (size_t idx = 0; idx < kvs_keys.size(); idx++) {
+            KVS_ERROR_IF_NOT(kvs_keys[idx].length() <= MAX_KVS_KEY_LENGTH);
+            append_str(frame, kvs_keys[idx]);
+            if (kvs_vals.empty()) {
+                append_str(frame, {});
+            }
+            else {
+                KVS_ERROR_IF_NOT(kvs_vals[idx].length() <= MAX_KVS_VAL_LENGTH);
+                append_str(frame, kvs_vals[idx]);
+            }
+        }
+
+        return write_frame(sock, memory_mutex, frame);
+    }
+
+    static std::vector<char> begin_frame() {
+        /* reserve space for frame length */
+        return std::vector<char>(sizeof(uint32_t), 0);
+    }
+    static void append_u32(std::vector<char>& buf, size_t value) {
+        // convert local endianness to little endian
+        for (size_t idx = 0; idx < sizeof(uint32_t); idx++) {
+            buf.push_back(static_cast<char>((static_cast<uint32_t>(value) >> (8 * idx)) & 0xFF));
+        }
+    }
+    static void append_str(std::vector<char>& buf, const std::string& str) {
+        append_u32(buf, str.size());
+        buf.insert(buf.end(), str.begin(), str.end());
+    }
+    static kvs_status_t read_u32(const std::vector<char>& buf, size_t& offset, uint32_t& value) {
+        KVS_ERROR_IF_NOT(offset + sizeof(uint32_t) <= buf.size());
+        value = 0;
+        // convert little-endian from serialized buffer to host endianness
+        for (size_t idx = 0; idx < sizeof(uint32_t); idx++) {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(buf[offset + idx])) << (8 * idx);
+        }
+        offset += sizeof(uint32_t);
+        return KVS_STATUS_SUCCESS;
+    }
+    static kvs_status_t read_str(const std::vector<char>& buf, size_t& offset, std::string& str) {
+        uint32_t len = 0;
+        KVS_CHECK_STATUS(read_u32(buf, offset, len), "failed to read length");
+        KVS_ERROR_IF_NOT(offset + len <= buf.size());
+        str.assign(buf.begin() + offset, buf.begin() + offset + len);
+        offset += len;
+        return KVS_STATUS_SUCCESS;
+    }
+    static kvs_status_t copy_field(const std::string& str, char* field, size_t field_size) {
+        KVS_ERROR_IF_NOT(str.size() < field_size);
+        std::fill(field, field + field_size, 0);
+        std::copy(str.begin(), str.end(), field);
+        return KVS_STATUS_SUCCESS;
+    }
+    static kvs_status_t write_frame(int sock, std::mutex& memory_mutex, std::vector<char>& frame) {
+        uint32_t frame_len = frame.size() - sizeof(uint32_t);
+        for (size_t idx = 0; idx < sizeof(uint32_t); idx++) {
+            frame[idx] = static_cast<char>((frame_len >> (8 * idx)) & 0xFF);
+        }
+        DO_RW_OP(write, sock, frame.data(), frame.size(), memory_mutex);
+        return KVS_STATUS_SUCCESS;
+    }
+    static kvs_status_t read_frame(int sock, std::mutex& memory_mutex, std::vector<char>& frame) {
+        frame.resize(sizeof(uint32_t));
+        DO_RW_OP(read, sock, frame.data(), frame.size(), memory_mutex);
+        size_t offset = 0;
+        uint32_t frame_len = 0;
+        KVS_CHECK_STATUS(read_u32(frame, offset, frame_len), "failed to read frame length");
+        KVS_ERROR_IF_NOT(frame_len <= max_frame_len, "too long frame ", frame_len);
+        frame.resize(frame_len);
+        if (frame_len)
+            DO_RW_OP(read, sock, frame.data(), frame.size(), memory_mutex);
+        return KVS_STATUS_SUCCESS;
+    }
+
+    static constexpr uint32_t max_frame_len = 1U << 30;
+
     friend class server;
-    kvs_access_mode_t mode{ AM_PUT }; // serialized to little-endian byte order for buffer transfers
-    char name[MAX_KVS_NAME_LENGTH]{};
-    char key[MAX_KVS_KEY_LENGTH]{};
-    char val[MAX_KVS_VAL_LENGTH]{};
-    const size_t put_buf_size = sizeof(mode) + sizeof(name) + sizeof(key) + sizeof(val);
+    kvs_access_mode_t mode{ AM_PUT };
+    /* extra byte keeps fields of max length zero terminated */
+    char name[MAX_KVS_NAME_LENGTH + 1]{};
+    char key[MAX_KVS_KEY_LENGTH + 1]{};
+    char val[MAX_KVS_VAL_LENGTH + 1]{};
+    std::vector<std::string> batch_keys;
+    std::vector<std::string> batch_vals;
 };
 
 typedef struct server_args {
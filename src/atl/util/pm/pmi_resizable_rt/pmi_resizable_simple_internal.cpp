@@ -13,6 +13,7 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include <numeric>
 #include <unistd.h>
 
 #include "util/pm/pmi_resizable_rt/pmi_resizable/def.h"
@@ -298,6 +299,91 @@ atl_status_t pmi_resizable_simple_internal::pmrt_kvs_get(char* kvs_key,
     return ATL_STATUS_SUCCESS;
 }
 
+atl_status_t pmi_resizable_simple_internal::pmrt_kvs_put_batch(char* kvs_key,
+                                                               const std::vector<int>& proc_idxs,
+                                                               const void* kvs_vals,
+                                                               size_t kvs_val_len) {
+    int ret;
+    std::vector<char> key_storage(max_keylen);
+    std::vector<std::string> keys(proc_idxs.size());
+    std::vector<std::string> vals(proc_idxs.size());
+    if (kvs_val_len > max_vallen) {
+        LOG_ERROR("asked len > max len");
+        return ATL_STATUS_FAILURE;
+    }
+
+    for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+        ret = snprintf(key_storage.data(),
+                       max_keylen - 1,
+                       RESIZABLE_PMI_RT_KEY_FORMAT,
+                       kvs_key,
+                       proc_idxs[idx]);
+        if (ret < 0) {
+            LOG_ERROR("snprintf failed");
+            return ATL_STATUS_FAILURE;
+        }
+        keys[idx] = key_storage.data();
+
+        ret = encode(static_cast<const char*>(kvs_vals) + idx * kvs_val_len,
+                     kvs_val_len,
+                     val_storage,
+                     max_vallen);
+        if (ret) {
+            LOG_ERROR("encode failed");
+            return ATL_STATUS_FAILURE;
+        }
+        vals[idx] = val_storage;
+    }
+
+    ATL_CHECK_STATUS(kvs_set_values(KVS_NAME, keys, vals), "failed to set vals");
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t pmi_resizable_simple_internal::pmrt_kvs_get_batch(char* kvs_key,
+                                                               const std::vector<int>& proc_idxs,
+                                                               void* kvs_vals,
+                                                               size_t kvs_val_len) {
+    if (strcmp(kvs_key, ATL_MPI_ROOT_RANK_KEY) == 0) {
+        return ipmi::pmrt_kvs_get_batch(kvs_key, proc_idxs, kvs_vals, kvs_val_len);
+    }
+
+    int ret;
+    std::vector<char> key_storage(max_keylen);
+    std::vector<std::string> keys(proc_idxs.size());
+    std::vector<std::string> vals;
+    if (kvs_val_len > max_vallen) {
+        LOG_ERROR("asked len > max len");
+        return ATL_STATUS_FAILURE;
+    }
+
+    for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+        ret = snprintf(key_storage.data(),
+                       max_keylen - 1,
+                       RESIZABLE_PMI_RT_KEY_FORMAT,
+                       kvs_key,
+                       proc_idxs[idx]);
+        if (ret < 0) {
+            LOG_ERROR("snprintf failed");
+            return ATL_STATUS_FAILURE;
+        }
+        keys[idx] = key_storage.data();
+    }
+
+    ATL_CHECK_STATUS(kvs_get_values(KVS_NAME, keys, vals), "failed to get vals");
+
+    for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+        ret = decode(
+            vals[idx].c_str(), static_cast<char*>(kvs_vals) + idx * kvs_val_len, kvs_val_len);
+        if (ret) {
+            LOG_ERROR("decode failed");
+            return ATL_STATUS_FAILURE;
+        }
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
 int pmi_resizable_simple_internal::get_size() {
     return proc_count;
 }
@@ -355,6 +441,67 @@ atl_status_t pmi_resizable_simple_internal::kvs_get_value(const std::string& kvs
     return ATL_STATUS_SUCCESS;
 }
 
+int pmi_resizable_simple_internal::kvs_set_values(const std::string& kvs_name,
+                                                  const std::vector<std::string>& keys,
+                                                  const std::vector<std::string>& values) {
+    std::string result_kvs_name = kvs_name + std::to_string(local_id);
+    for (size_t idx = 0; idx < keys.size(); idx++) {
+        put_key(result_kvs_name.c_str(), keys[idx].c_str(), values[idx].c_str(), ST_CLIENT);
+    }
+
+    return k->kvs_set_values(result_kvs_name, keys, values);
+}
+
+atl_status_t pmi_resizable_simple_internal::kvs_get_values(const std::string& kvs_name,
+                                                           const std::vector<std::string>& keys,
+                                                           std::vector<std::string>& values) {
+    std::string result_kvs_name = kvs_name + std::to_string(local_id);
+
+    time_t start_time = time(NULL);
+    size_t kvs_get_time = 0;
+
+    values.assign(keys.size(), {});
+    std::vector<std::string> missing_keys(keys);
+    std::vector<size_t> missing_idxs(keys.size());
+    std::iota(missing_idxs.begin(), missing_idxs.end(), 0);
+
+    /* re-request only keys which are not published yet */
+    do {
+        std::vector<std::string> missing_values;
+        KVS_2_ATL_CHECK_STATUS(
+            k->kvs_get_values_by_name_keys(result_kvs_name, missing_keys, missing_values),
+            "failed to get values");
+
+        size_t still_missing = 0;
+        for (size_t idx = 0; idx < missing_keys.size(); idx++) {
+            if (missing_values[idx].empty()) {
+                missing_keys[still_missing] = missing_keys[idx];
+                missing_idxs[still_missing] = missing_idxs[idx];
+                still_missing++;
+            }
+            else {
+                values[missing_idxs[idx]] = std::move(missing_values[idx]);
+            }
+        }
+        missing_keys.resize(still_missing);
+        missing_idxs.resize(still_missing);
+        kvs_get_time = time(NULL) - start_time;
+    } while (!missing_keys.empty() && kvs_get_time < kvs_get_timeout);
+
+    if (!missing_keys.empty()) {
+        LOG_ERROR("KVS get error: timeout limit: ",
+                  kvs_get_time,
+                  " > ",
+                  kvs_get_timeout,
+                  ", prefix: ",
+                  result_kvs_name.c_str(),
+                  ", key: ",
+                  missing_keys.front());
+        return ATL_STATUS_FAILURE;
+    }
+    return ATL_STATUS_SUCCESS;
+}
+
 atl_status_t pmi_resizable_simple_internal::get_local_kvs_id(size_t& res) {
     std::string local_kvs_id;
     res = 0;
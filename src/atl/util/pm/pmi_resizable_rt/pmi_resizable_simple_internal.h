@@ -76,6 +76,16 @@ public:
                               void* kvs_val,
                               size_t kvs_val_len) override;
 
+    atl_status_t pmrt_kvs_put_batch(char* kvs_key,
+                                    const std::vector<int>& proc_idxs,
+                                    const void* kvs_vals,
+                                    size_t kvs_val_len) override;
+
+    atl_status_t pmrt_kvs_get_batch(char* kvs_key,
+                                    const std::vector<int>& proc_idxs,
+                                    void* kvs_vals,
+                                    size_t kvs_val_len) override;
+
     int get_size() override;
 
     int get_rank() override;
@@ -103,6 +113,12 @@ private:
     atl_status_t kvs_get_value(const std::string& kvs_name,
                                const std::string& key,
                                std::string& value);
+    int kvs_set_values(const std::string& kvs_name,
+                       const std::vector<std::string>& keys,
+                       const std::vector<std::string>& values);
+    atl_status_t kvs_get_values(const std::string& kvs_name,
+                                const std::vector<std::string>& keys,
+                                std::vector<std::string>& values);
 
     atl_status_t pmrt_barrier_full();
     atl_status_t barrier_full_reg();
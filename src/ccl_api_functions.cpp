@@ -517,6 +517,17 @@ event allreduce(const BufferObjectType& send_buf,
         send_buf, recv_buf, count, reduction, disp(default_stream), attr, deps);
 }
 
+persistent_request allreduce_init(const void* send_buf,
+                                  void* recv_buf,
+                                  size_t count,
+                                  datatype dtype,
+                                  reduction reduction,
+                                  const communicator& comm,
+                                  const allreduce_attr& attr) {
+    impl_dispatch disp;
+    return disp(comm)->allreduce_init(send_buf, recv_buf, count, dtype, reduction, attr);
+}
+
 /* alltoall */
 event alltoall(const void* send_buf,
                void* recv_buf,
@@ -0,0 +1,50 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "oneapi/ccl/types.hpp"
+#include "oneapi/ccl/types_policy.hpp"
+#include "oneapi/ccl/persistent_request.hpp"
+#include "common/request/persistent_request_impl.hpp"
+
+namespace ccl {
+
+namespace v1 {
+
+CCL_API persistent_request::persistent_request(persistent_request&& src) noexcept
+        : base_t(std::move(src)) {}
+CCL_API persistent_request::persistent_request(impl_value_t&& impl) noexcept
+        : base_t(std::move(impl)) {}
+CCL_API persistent_request::~persistent_request() noexcept {}
+
+CCL_API persistent_request& persistent_request::operator=(persistent_request&& src) noexcept {
+    this->acc_policy_t::create(this, std::move(src));
+    return *this;
+}
+
+void CCL_API persistent_request::start() {
+    get_impl()->start();
+}
+
+void CCL_API persistent_request::wait() {
+    get_impl()->wait();
+}
+
+bool CCL_API persistent_request::test() {
+    return get_impl()->test();
+}
+
+} // namespace v1
+
+} // namespace ccl
@@ -47,7 +47,8 @@ enum ccl_coll_allgatherv_algo {
     ccl_coll_allgatherv_ring,
     ccl_coll_allgatherv_flat,
     ccl_coll_allgatherv_multi_bcast,
-    ccl_coll_allgatherv_topo
+    ccl_coll_allgatherv_topo,
+    ccl_coll_allgatherv_shm
 };
 
 enum ccl_coll_allreduce_algo {
@@ -61,7 +62,9 @@ enum ccl_coll_allreduce_algo {
     ccl_coll_allreduce_double_tree,
     ccl_coll_allreduce_recursive_doubling,
     ccl_coll_allreduce_2d,
-    ccl_coll_allreduce_topo
+    ccl_coll_allreduce_topo,
+    ccl_coll_allreduce_shm,
+    ccl_coll_allreduce_hier
 };
 
 enum ccl_coll_alltoall_algo {
@@ -70,6 +73,8 @@ enum ccl_coll_alltoall_algo {
     ccl_coll_alltoall_direct,
     ccl_coll_alltoall_naive,
     ccl_coll_alltoall_scatter,
+    ccl_coll_alltoall_pairwise,
+    ccl_coll_alltoall_bruck,
     ccl_coll_alltoall_topo
 };
 
@@ -79,6 +84,8 @@ enum ccl_coll_alltoallv_algo {
     ccl_coll_alltoallv_direct,
     ccl_coll_alltoallv_naive,
     ccl_coll_alltoallv_scatter,
+    ccl_coll_alltoallv_pairwise,
+    ccl_coll_alltoallv_hier,
     ccl_coll_alltoallv_topo
 };
 
@@ -86,7 +93,9 @@ enum ccl_coll_barrier_algo {
     ccl_coll_barrier_undefined = 0,
 
     ccl_coll_barrier_direct,
-    ccl_coll_barrier_ring
+    ccl_coll_barrier_ring,
+    ccl_coll_barrier_shm,
+    ccl_coll_barrier_hier
 };
 
 enum ccl_coll_bcast_algo {
@@ -96,7 +105,8 @@ enum ccl_coll_bcast_algo {
     ccl_coll_bcast_ring,
     ccl_coll_bcast_double_tree,
     ccl_coll_bcast_naive,
-    ccl_coll_bcast_topo
+    ccl_coll_bcast_topo,
+    ccl_coll_bcast_shm
 };
 
 enum ccl_coll_broadcast_algo {
@@ -134,7 +144,8 @@ enum ccl_coll_reduce_scatter_algo {
     ccl_coll_reduce_scatter_direct,
     ccl_coll_reduce_scatter_naive,
     ccl_coll_reduce_scatter_ring,
-    ccl_coll_reduce_scatter_topo
+    ccl_coll_reduce_scatter_topo,
+    ccl_coll_reduce_scatter_shm
 };
 
 enum ccl_coll_send_algo {
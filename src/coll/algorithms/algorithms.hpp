@@ -69,6 +69,13 @@ ccl::status ccl_coll_build_multi_bcast_allgatherv(ccl_sched* main_sched,
                                                   std::vector<ccl_sched*>& scheds,
                                                   const ccl_coll_param& coll_param,
                                                   size_t data_partition_count);
+ccl::status ccl_coll_build_shm_allgatherv(ccl_sched* sched,
+                                          ccl_buffer send_buf,
+                                          size_t send_count,
+                                          ccl_buffer recv_buf,
+                                          const size_t* recv_counts,
+                                          const ccl_datatype& dtype,
+                                          ccl_comm* comm);
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 ccl::status ccl_coll_build_topo_allgatherv(ccl_sched* main_sched,
                                            std::vector<ccl_sched*>& scheds,
@@ -83,6 +90,13 @@ ccl::status ccl_coll_build_direct_allreduce(ccl_sched* sched,
                                             const ccl_datatype& dtype,
                                             ccl::reduction reduction,
                                             ccl_comm* comm);
+ccl::status ccl_coll_build_shm_allreduce(ccl_sched* sched,
+                                         ccl_buffer send_buf,
+                                         ccl_buffer recv_buf,
+                                         size_t count,
+                                         const ccl_datatype& dtype,
+                                         ccl::reduction reduction,
+                                         ccl_comm* comm);
 ccl::status ccl_coll_build_rabenseifner_allreduce(ccl_sched* sched,
                                                   ccl_buffer send_buf,
                                                   ccl_buffer recv_buf,
@@ -126,6 +140,13 @@ ccl::status ccl_coll_build_2d_allreduce(ccl_sched* sched,
                                         const ccl_datatype& dtype,
                                         ccl::reduction reduction,
                                         ccl_comm* comm);
+ccl::status ccl_coll_build_hier_allreduce(ccl_sched* sched,
+                                          ccl_buffer send_buf,
+                                          ccl_buffer recv_buf,
+                                          size_t count,
+                                          const ccl_datatype& dtype,
+                                          ccl::reduction reduction,
+                                          ccl_comm* comm);
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 ccl::status ccl_coll_build_topo_allreduce(ccl_sched* sched,
                                           ccl_buffer send_buf,
@@ -157,6 +178,15 @@ ccl::status ccl_coll_build_naive_alltoallv(ccl_sched* main_sched,
 ccl::status ccl_coll_build_scatter_alltoallv(ccl_sched* main_sched,
                                              std::vector<ccl_sched*>& scheds,
                                              const ccl_coll_param& coll_param);
+ccl::status ccl_coll_build_pairwise_alltoallv(ccl_sched* main_sched,
+                                              std::vector<ccl_sched*>& scheds,
+                                              const ccl_coll_param& coll_param);
+ccl::status ccl_coll_build_bruck_alltoall(ccl_sched* main_sched,
+                                          std::vector<ccl_sched*>& scheds,
+                                          const ccl_coll_param& coll_param);
+ccl::status ccl_coll_build_hier_alltoallv(ccl_sched* main_sched,
+                                          std::vector<ccl_sched*>& scheds,
+                                          const ccl_coll_param& coll_param);
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 ccl::status ccl_coll_build_topo_alltoallv(ccl_sched* main_sched,
                                           std::vector<ccl_sched*>& scheds,
@@ -166,6 +196,10 @@ ccl::status ccl_coll_build_topo_alltoallv(ccl_sched* main_sched,
 // barrier
 ccl::status ccl_coll_build_direct_barrier(ccl_sched* sched, ccl_comm* comm);
 ccl::status ccl_coll_build_dissemination_barrier(ccl_sched* sched, ccl_comm* comm);
+ccl::status ccl_coll_build_shm_barrier(ccl_sched* sched, ccl_comm* comm);
+ccl::status ccl_coll_build_hier_barrier(ccl_sched* sched, ccl_comm* comm);
+// completes the hier barrier in the calling thread, without schedule
+void ccl_run_hier_barrier(ccl_comm* comm);
 
 // bcast
 ccl::status ccl_coll_build_direct_bcast(ccl_sched* sched,
@@ -186,6 +220,12 @@ ccl::status ccl_coll_build_naive_bcast(ccl_sched* sched,
                                        const ccl_datatype& dtype,
                                        int root,
                                        ccl_comm* comm);
+ccl::status ccl_coll_build_shm_bcast(ccl_sched* sched,
+                                     ccl_buffer buf,
+                                     size_t count,
+                                     const ccl_datatype& dtype,
+                                     int root,
+                                     ccl_comm* comm);
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 ccl::status ccl_coll_build_topo_bcast(ccl_sched* sched,
                                       ccl_buffer buf,
@@ -325,6 +365,13 @@ ccl::status ccl_coll_build_ring_reduce_scatter(ccl_sched* sched,
                                                const ccl_datatype& dtype,
                                                ccl::reduction reduction,
                                                ccl_comm* comm);
+ccl::status ccl_coll_build_shm_reduce_scatter(ccl_sched* sched,
+                                              ccl_buffer send_buf,
+                                              ccl_buffer recv_buf,
+                                              size_t recv_count,
+                                              const ccl_datatype& dtype,
+                                              ccl::reduction reduction,
+                                              ccl_comm* comm);
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 ccl::status ccl_coll_build_topo_reduce_scatter_fill(ccl_sched* sched,
                                                     ccl_buffer send_buf,
@@ -127,6 +127,34 @@ ccl::status ccl_coll_build_naive_allgatherv(ccl_sched* sched,
     return status;
 }
 
+ccl::status ccl_coll_build_shm_allgatherv(ccl_sched* sched,
+                                          ccl_buffer send_buf,
+                                          size_t send_count,
+                                          ccl_buffer recv_buf,
+                                          const size_t* recv_counts,
+                                          const ccl_datatype& dtype,
+                                          ccl_comm* comm) {
+    LOG_DEBUG("build shm allgatherv");
+
+    CCL_THROW_IF_NOT(send_count == recv_counts[comm->rank()],
+                     "unexpected send_count ",
+                     send_count,
+                     ", expected ",
+                     recv_counts[comm->rank()]);
+
+    entry_factory::create<shm_coll_entry>(sched,
+                                          ccl_coll_allgatherv,
+                                          send_buf,
+                                          recv_buf,
+                                          send_count,
+                                          recv_counts,
+                                          dtype,
+                                          ccl::reduction::custom,
+                                          CCL_INVALID_ROOT_RANK_IDX,
+                                          comm);
+    return ccl::status::success;
+}
+
 ccl::status ccl_coll_build_ring_allgatherv(ccl_sched* main_sched,
                                            std::vector<ccl_sched*>& scheds,
                                            ccl_buffer send_buf,
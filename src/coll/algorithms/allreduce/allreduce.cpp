@@ -23,6 +23,7 @@
 #include "coll/algorithms/algorithms.hpp"
 #include "coll/algorithms/algorithm_utils.hpp"
 #include "coll/coll_util.hpp"
+#include "coll/selection/selection.hpp"
 #include "comm/comm.hpp"
 #include "sched/entry/copy/copy_helper.hpp"
 #include "sched/entry/factory/chunked_entry_factory.hpp"
@@ -181,6 +182,9 @@ ccl::status ccl_coll_build_rabenseifner_allreduce(ccl_sched* sched,
 
             CCL_ASSERT(can_use_recv_reduce);
 
+            /* the last reduce-scatter step completes the result, avg is divided there */
+            size_t avg_divisor = ((mask << 1) >= pof2) ? comm_size : 1;
+
             if (can_use_recv_reduce) {
                 entry_factory::create<recv_reduce_entry>(sched,
                                                          (recv_buf + disps[recv_idx] * dtype_size),
@@ -188,7 +192,10 @@ ccl::status ccl_coll_build_rabenseifner_allreduce(ccl_sched* sched,
                                                          dtype,
                                                          op,
                                                          dst,
-                                                         comm);
+                                                         comm,
+                                                         ccl_buffer(),
+                                                         ccl_recv_reduce_local_buf,
+                                                         avg_divisor);
                 entry_factory::create<send_entry>(
                     sched, (recv_buf + disps[send_idx] * dtype_size), send_cnt, dtype, dst, comm);
                 sched->add_barrier();
@@ -214,7 +221,8 @@ ccl::status ccl_coll_build_rabenseifner_allreduce(ccl_sched* sched,
                                                           (recv_buf + disps[recv_idx] * dtype_size),
                                                           nullptr,
                                                           dtype,
-                                                          op);
+                                                          op,
+                                                          avg_divisor);
                 sched->add_barrier();
             }
 
@@ -373,26 +381,29 @@ ccl::status ccl_coll_build_nreduce_allreduce(ccl_sched* sched,
         }
 
         // reduce-scatter
+        std::vector<ccl_buffer> peer_bufs;
+        peer_bufs.reserve(comm_size - 1);
         for (int idx = 1; idx < comm_size; idx++) {
             // send part of buffer to other rank
             int dst = (comm_rank - idx + comm_size) % comm_size;
             entry_factory::create<send_entry>(
                 sched, seg_send_buf + elem_offsets[dst], elem_counts[dst], dtype, dst, comm);
 
-            // recv part of buffer from other rank and perform reduce
+            // recv part of buffer from other rank
             int src = (comm_rank + idx) % comm_size;
-            entry_factory::create<recv_reduce_entry>(sched,
-                                                     reduce_buf,
-                                                     elem_count,
-                                                     dtype,
-                                                     op,
-                                                     src,
-                                                     comm,
-                                                     seg_tmp_buf + elem_count * src * dtype_size);
+            ccl_buffer peer_buf = seg_tmp_buf + elem_count * src * dtype_size;
+            entry_factory::create<recv_entry>(sched, peer_buf, elem_count, dtype, src, comm);
+            peer_bufs.push_back(peer_buf);
         }
 
         sched->add_barrier();
 
+        // reduce all received parts at once so that reduce_buf goes through memory only once
+        entry_factory::create<reduce_local_multi_entry>(
+            sched, peer_bufs, elem_count, reduce_buf, dtype, op, comm_size);
+
+        sched->add_barrier();
+
         // allgatherv
         if (use_buffering) {
             copy_attr attr;
@@ -466,12 +477,29 @@ ccl::status ccl_coll_build_ring_allreduce(ccl_sched* sched,
                      recv_buf);
 
     ccl::status status = ccl::status::success;
+    int comm_size = comm->size();
+
+    // host buffers: reduce_scatter and allgather of the segments pipelined in a single entry
+    if (comm_size > 1 && !sched->coll_param.stream && recv_device_bufs.empty()) {
+        size_t segment_count = ring_allreduce_entry::get_segment_count(count, dtype, comm_size);
+        bool is_compressed = ring_allreduce_entry::get_wire_dtype(dtype, op) != dtype.idx();
+        if (segment_count < count / comm_size || is_compressed) {
+            LOG_DEBUG("build segmented ring allreduce, segment_count ",
+                      segment_count,
+                      ", compressed ",
+                      is_compressed);
+            entry_factory::create<ring_allreduce_entry>(
+                sched, send_buf, recv_buf, count, segment_count, dtype, op, comm);
+            sched->add_barrier();
+            return status;
+        }
+    }
+
     ccl_coll_build_reduce_scatter_block(sched, send_buf, recv_buf, count, dtype, op, comm);
 
     sched->add_barrier();
 
     // Prepare recv_counts for allgatherv phase
-    int comm_size = comm->size();
     size_t main_block_count = count / comm_size;
     size_t last_block_count = main_block_count + count % comm_size;
     std::vector<size_t> recv_counts(comm_size, main_block_count);
@@ -537,6 +565,28 @@ ccl::status ccl_coll_build_ring_allreduce(ccl_sched* sched,
     return status;
 }
 
+ccl::status ccl_coll_build_shm_allreduce(ccl_sched* sched,
+                                         ccl_buffer send_buf,
+                                         ccl_buffer recv_buf,
+                                         size_t count,
+                                         const ccl_datatype& dtype,
+                                         ccl::reduction op,
+                                         ccl_comm* comm) {
+    LOG_DEBUG("build shm allreduce");
+
+    entry_factory::create<shm_coll_entry>(sched,
+                                          ccl_coll_allreduce,
+                                          send_buf,
+                                          recv_buf,
+                                          count,
+                                          nullptr,
+                                          dtype,
+                                          op,
+                                          CCL_INVALID_ROOT_RANK_IDX,
+                                          comm);
+    return ccl::status::success;
+}
+
 ccl::status ccl_coll_build_recursive_doubling_allreduce(ccl_sched* sched,
                                                         ccl_buffer send_buf,
                                                         ccl_buffer recv_buf,
@@ -563,6 +613,15 @@ ccl::status ccl_coll_build_recursive_doubling_allreduce(ccl_sched* sched,
 
     size_t dtype_size = dtype.size();
 
+    /* tiny host messages: all steps in one entry with pre-posted receives */
+    if (comm_size > 1 && !sched->coll_param.stream &&
+        count * dtype_size <= ccl::global_data::env().allreduce_eager_msg_size) {
+        entry_factory::create<eager_allreduce_entry>(
+            sched, send_buf, recv_buf, count, dtype, op, comm);
+        sched->add_barrier();
+        return status;
+    }
+
     ccl_buffer tmp_buf = sched->alloc_buffer({ count * dtype_size, send_buf });
 
     /* copy local data into recv_buf */
@@ -628,9 +687,16 @@ ccl::status ccl_coll_build_recursive_doubling_allreduce(ccl_sched* sched,
             sched->add_barrier();
 
             /* tmp_buf contains data received in this step.
-             * recv_buf contains data accumulated so far */
-            entry_factory::create<reduce_local_entry>(
-                sched, tmp_buf, count, recv_buf, nullptr, dtype, op);
+             * recv_buf contains data accumulated so far,
+             * the last step completes the result, avg is divided there */
+            entry_factory::create<reduce_local_entry>(sched,
+                                                      tmp_buf,
+                                                      count,
+                                                      recv_buf,
+                                                      nullptr,
+                                                      dtype,
+                                                      op,
+                                                      ((mask << 1) >= pof2) ? comm_size : 1);
             sched->add_barrier();
 
             mask <<= 1;
@@ -842,6 +908,206 @@ ccl::status ccl_coll_build_2d_allreduce(ccl_sched* sched,
     return status;
 }
 
+static bool ccl_allreduce_hier_is_shm_stage(ccl_sched* sched,
+                                            ccl_coll_type ctype,
+                                            size_t count,
+                                            const size_t* recv_counts,
+                                            const ccl_datatype& dtype,
+                                            ccl_buffer buf,
+                                            ccl_comm* node_comm) {
+    ccl_selector_param param;
+    param.ctype = ctype;
+    param.count = count;
+    param.recv_counts = recv_counts;
+    param.dtype = dtype;
+    param.comm = node_comm;
+    param.stream = sched->coll_param.stream;
+    param.buf = buf.get_ptr();
+#ifdef CCL_ENABLE_SYCL
+    param.is_sycl_buf = sched->coll_attr.is_sycl_buf;
+#endif // CCL_ENABLE_SYCL
+    param.hint_algo = sched->hint_algo;
+    return ccl_is_shm_algo(param);
+}
+
+ccl::status ccl_coll_build_hier_allreduce(ccl_sched* sched,
+                                          ccl_buffer send_buf,
+                                          ccl_buffer recv_buf,
+                                          size_t count,
+                                          const ccl_datatype& dtype,
+                                          ccl::reduction op,
+                                          ccl_comm* comm) {
+    ccl::status status = ccl::status::success;
+
+    if (count == 0) {
+        return status;
+    }
+
+    ccl_comm* node_comm = comm->get_node_comm().get();
+    ccl_comm* r2r_comm = comm->get_r2r_comm().get();
+    int node_size = node_comm->size();
+    int node_rank = node_comm->rank();
+    size_t dtype_size = dtype.size();
+
+    // every chunk is split into node_size equal blocks,
+    // the elements which do not fill a block are reduced over the whole comm
+    size_t tail_count = count % node_size;
+    size_t main_count = count - tail_count;
+    size_t chunk_count =
+        std::max(ccl::global_data::env().allreduce_hier_chunk_size / dtype_size / node_size,
+                 size_t(1)) *
+        node_size;
+    size_t chunk_num = (main_count + chunk_count - 1) / chunk_count;
+
+    LOG_DEBUG("build hier allreduce: count: ",
+              count,
+              ", chunk_count: ",
+              chunk_count,
+              ", chunk_num: ",
+              chunk_num,
+              ", tail_count: ",
+              tail_count,
+              ", node comm: ",
+              node_comm->to_string(),
+              ", r2r comm: ",
+              r2r_comm->to_string());
+
+    if (tail_count) {
+        entry_factory::create<subsched_entry>(
+            sched,
+            4,
+            [send_buf, recv_buf, main_count, tail_count, dtype, op, comm](ccl_sched* s) {
+                ccl_coll_build_recursive_doubling_allreduce(s,
+                                                            send_buf + main_count * dtype.size(),
+                                                            recv_buf + main_count * dtype.size(),
+                                                            tail_count,
+                                                            dtype,
+                                                            op,
+                                                            comm);
+            },
+            "AR_TAIL");
+    }
+
+    // software pipeline: on step k chunk k is reduce-scattered inside the node,
+    // chunk k - 1 is reduced between the nodes and chunk k - 2 is gathered inside the node.
+    // The intra-node stages are added in place when they use the shm segment
+    // to keep the order of shm operations the same on all local ranks,
+    // otherwise all stages run in subschedules with own op_id to run concurrently
+    for (size_t step = 0; step < chunk_num + 2; step++) {
+        for (size_t stage = 0; stage < 3; stage++) {
+            if (step < stage || step - stage >= chunk_num) {
+                continue;
+            }
+
+            size_t chunk_idx = step - stage;
+            size_t chunk_offset = chunk_idx * chunk_count;
+            size_t block_count = std::min(chunk_count, main_count - chunk_offset) / node_size;
+            ccl_buffer chunk_buf = recv_buf + chunk_offset * dtype_size;
+            ccl_buffer block_buf = chunk_buf + node_rank * block_count * dtype_size;
+
+            if (stage == 0) {
+                ccl_buffer chunk_send_buf = send_buf + chunk_offset * dtype_size;
+                if (ccl_allreduce_hier_is_shm_stage(sched,
+                                                    ccl_coll_reduce_scatter,
+                                                    block_count,
+                                                    nullptr,
+                                                    dtype,
+                                                    chunk_send_buf,
+                                                    node_comm)) {
+                    ccl_coll_build_reduce_scatter(sched,
+                                                  chunk_send_buf,
+                                                  block_buf,
+                                                  block_count,
+                                                  dtype,
+                                                  op,
+                                                  node_comm,
+                                                  false,
+                                                  false);
+                    continue;
+                }
+                entry_factory::create<subsched_entry>(
+                    sched,
+                    1,
+                    [chunk_send_buf, block_buf, block_count, dtype, op, node_comm](ccl_sched* s) {
+                        s->hint_algo.reduce_scatter = ccl_coll_reduce_scatter_ring;
+                        ccl_coll_build_reduce_scatter(s,
+                                                      chunk_send_buf,
+                                                      block_buf,
+                                                      block_count,
+                                                      dtype,
+                                                      op,
+                                                      node_comm,
+                                                      false,
+                                                      false);
+                    },
+                    "RS");
+            }
+            else if (stage == 1) {
+                entry_factory::create<subsched_entry>(
+                    sched,
+                    2,
+                    [block_buf, block_count, dtype, op, r2r_comm](ccl_sched* s) {
+                        // inter-node traffic is the one worth compressing
+                        if (ring_allreduce_entry::get_wire_dtype(dtype, op) != dtype.idx()) {
+                            s->hint_algo.allreduce = ccl_coll_allreduce_ring;
+                        }
+                        ccl_coll_build_allreduce(s,
+                                                 block_buf,
+                                                 block_buf,
+                                                 block_count,
+                                                 std::vector<ccl_buffer>{},
+                                                 dtype,
+                                                 op,
+                                                 r2r_comm,
+                                                 false);
+                    },
+                    "AR");
+            }
+            else {
+                std::vector<size_t> ag_recv_counts(node_size, block_count);
+                if (ccl_allreduce_hier_is_shm_stage(sched,
+                                                    ccl_coll_allgatherv,
+                                                    block_count,
+                                                    ag_recv_counts.data(),
+                                                    dtype,
+                                                    block_buf,
+                                                    node_comm)) {
+                    ccl_coll_build_allgatherv(sched,
+                                              block_buf,
+                                              block_count,
+                                              chunk_buf,
+                                              ag_recv_counts.data(),
+                                              std::vector<ccl_buffer>{},
+                                              dtype,
+                                              node_comm,
+                                              false);
+                    continue;
+                }
+                entry_factory::create<subsched_entry>(
+                    sched,
+                    3,
+                    [block_buf, block_count, chunk_buf, ag_recv_counts, dtype, node_comm](
+                        ccl_sched* s) {
+                        s->hint_algo.allgatherv = ccl_coll_allgatherv_ring;
+                        ccl_coll_build_allgatherv(s,
+                                                  block_buf,
+                                                  block_count,
+                                                  chunk_buf,
+                                                  ag_recv_counts.data(),
+                                                  std::vector<ccl_buffer>{},
+                                                  dtype,
+                                                  node_comm,
+                                                  false);
+                    },
+                    "AG");
+            }
+        }
+        sched->add_barrier();
+    }
+
+    return status;
+}
+
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 
 ccl::status ccl_coll_build_topo_allreduce_fill(ccl_sched* sched,
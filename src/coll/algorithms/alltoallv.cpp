@@ -364,6 +364,623 @@ ccl::status ccl_coll_build_scatter_alltoallv(ccl_sched* main_sched,
     return ccl::status::success;
 }
 
+ccl::status ccl_coll_build_pairwise_alltoallv(ccl_sched* main_sched,
+                                              std::vector<ccl_sched*>& scheds,
+                                              const ccl_coll_param& coll_param) {
+    LOG_DEBUG("build pairwise alltoallv");
+
+    ccl_comm* comm = coll_param.comm;
+    const ccl_datatype& dtype = coll_param.dtype;
+
+    int comm_rank = comm->rank();
+    int comm_size = comm->size();
+    size_t sched_count = scheds.size();
+    size_t dtype_size = dtype.size();
+
+    std::vector<size_t> send_counts, recv_counts, send_offsets, recv_offsets;
+    size_t total_send_count = 0, total_recv_count = 0;
+    size_t total_send_bytes = 0, total_recv_bytes = 0;
+
+    bool inplace = coll_param.is_inplace();
+
+    ccl_coll_calculate_alltoallv_counts(coll_param,
+                                        send_counts,
+                                        recv_counts,
+                                        send_offsets,
+                                        recv_offsets,
+                                        total_send_count,
+                                        total_recv_count,
+                                        total_send_bytes,
+                                        total_recv_bytes);
+
+    if (total_send_count + total_recv_count == 0) {
+        return ccl::status::success;
+    }
+
+    std::vector<ccl_buffer> recv_bufs;
+    if (inplace)
+        recv_bufs.resize(comm_size);
+
+    if (!inplace && send_counts[comm_rank] && recv_counts[comm_rank]) {
+        entry_factory::create<copy_entry>(scheds[0],
+                                          ccl_buffer(coll_param.get_send_buf_ptr(),
+                                                     total_send_bytes,
+                                                     send_offsets[comm_rank],
+                                                     ccl_buffer_type::INDIRECT),
+                                          ccl_buffer(coll_param.get_recv_buf_ptr(),
+                                                     total_recv_bytes,
+                                                     recv_offsets[comm_rank],
+                                                     ccl_buffer_type::INDIRECT),
+                                          send_counts[comm_rank],
+                                          dtype);
+    }
+
+    // one peer per step: XOR peers for power of two comm size, otherwise shifted peers
+    bool is_pof2 = ccl::utils::pof2(comm_size) == static_cast<size_t>(comm_size);
+
+    for (int step = 1; step < comm_size; step++) {
+        int dst = (is_pof2) ? (comm_rank ^ step) : (comm_rank + step) % comm_size;
+        int src = (is_pof2) ? (comm_rank ^ step) : (comm_rank - step + comm_size) % comm_size;
+
+        if (recv_counts[src]) {
+            ccl_buffer recv_buf;
+            if (inplace) {
+                // the send data of the later steps is kept until the end
+                recv_buf = scheds[0]->alloc_buffer(
+                    { recv_counts[src] * dtype_size, coll_param.get_recv_buf() });
+                recv_bufs[src] = recv_buf;
+            }
+            else {
+                recv_buf = ccl_buffer(coll_param.get_recv_buf_ptr(),
+                                      total_recv_bytes,
+                                      recv_offsets[src],
+                                      ccl_buffer_type::INDIRECT);
+            }
+            entry_factory::make_chunked_recv_entry(
+                scheds, 0, recv_buf, recv_counts[src], dtype, src, comm);
+        }
+
+        if (send_counts[dst]) {
+            entry_factory::make_chunked_send_entry(scheds,
+                                                   0,
+                                                   ccl_buffer(coll_param.get_send_buf_ptr(),
+                                                              total_send_bytes,
+                                                              send_offsets[dst],
+                                                              ccl_buffer_type::INDIRECT),
+                                                   send_counts[dst],
+                                                   dtype,
+                                                   dst,
+                                                   comm);
+        }
+
+        // a single exchange in flight keeps the number of unexpected messages bounded
+        for (size_t idx = 0; idx < sched_count; idx++) {
+            scheds[idx]->add_barrier();
+        }
+    }
+
+    if (!inplace)
+        return ccl::status::success;
+
+    if (main_sched) {
+        main_sched->sync_subscheds();
+    }
+
+    for (int idx = 0; idx < comm_size; idx++) {
+        if (idx == comm_rank || recv_counts[idx] == 0)
+            continue;
+        entry_factory::create<copy_entry>(scheds[idx % sched_count],
+                                          recv_bufs[idx],
+                                          ccl_buffer(coll_param.get_recv_buf_ptr(),
+                                                     total_recv_bytes,
+                                                     recv_offsets[idx],
+                                                     ccl_buffer_type::INDIRECT),
+                                          recv_counts[idx],
+                                          dtype);
+    }
+
+    return ccl::status::success;
+}
+
+ccl::status ccl_coll_build_bruck_alltoall(ccl_sched* main_sched,
+                                          std::vector<ccl_sched*>& scheds,
+                                          const ccl_coll_param& coll_param) {
+    LOG_DEBUG("build bruck alltoall");
+
+    CCL_THROW_IF_NOT(coll_param.ctype == ccl_coll_alltoall,
+                     "bruck algorithm requires the same count for all ranks");
+
+    ccl_sched* sched = scheds[0];
+    ccl_comm* comm = coll_param.comm;
+    const ccl_datatype& dtype = coll_param.dtype;
+
+    int comm_rank = comm->rank();
+    int comm_size = comm->size();
+    size_t count = coll_param.get_send_count();
+    size_t block_bytes = count * dtype.size();
+    size_t total_bytes = comm_size * block_bytes;
+
+    if (count == 0) {
+        return ccl::status::success;
+    }
+
+    ccl_buffer send_buf(coll_param.get_send_buf_ptr(), total_bytes, ccl_buffer_type::INDIRECT);
+    ccl_buffer recv_buf(coll_param.get_recv_buf_ptr(), total_bytes, ccl_buffer_type::INDIRECT);
+
+    // the largest number of blocks sent on a step: the blocks with the step bit set in the index
+    size_t max_step_blocks = 0;
+    for (int mask = 1; mask < comm_size; mask <<= 1) {
+        size_t step_blocks = 0;
+        for (int idx = mask; idx < comm_size; idx += 2 * mask) {
+            step_blocks += std::min(mask, comm_size - idx);
+        }
+        max_step_blocks = std::max(max_step_blocks, step_blocks);
+    }
+
+    ccl_buffer tmp_buf = sched->alloc_buffer({ total_bytes, coll_param.get_recv_buf() });
+    ccl_buffer pack_send_buf =
+        sched->alloc_buffer({ max_step_blocks * block_bytes, coll_param.get_recv_buf() });
+    ccl_buffer pack_recv_buf =
+        sched->alloc_buffer({ max_step_blocks * block_bytes, coll_param.get_recv_buf() });
+
+    // tmp block idx holds the data for rank (comm_rank + idx)
+    entry_factory::create<copy_entry>(
+        sched, send_buf + comm_rank * block_bytes, tmp_buf, (comm_size - comm_rank) * count, dtype);
+    if (comm_rank) {
+        entry_factory::create<copy_entry>(sched,
+                                          send_buf,
+                                          tmp_buf + (comm_size - comm_rank) * block_bytes,
+                                          comm_rank * count,
+                                          dtype);
+    }
+    sched->add_barrier();
+
+    // log(p) steps: the blocks with the mask bit set in the index move mask ranks forward
+    for (int mask = 1; mask < comm_size; mask <<= 1) {
+        int dst = (comm_rank + mask) % comm_size;
+        int src = (comm_rank - mask + comm_size) % comm_size;
+
+        size_t step_blocks = 0;
+        for (int idx = mask; idx < comm_size; idx += 2 * mask) {
+            size_t blocks = std::min(mask, comm_size - idx);
+            entry_factory::create<copy_entry>(sched,
+                                              tmp_buf + idx * block_bytes,
+                                              pack_send_buf + step_blocks * block_bytes,
+                                              blocks * count,
+                                              dtype);
+            step_blocks += blocks;
+        }
+        sched->add_barrier();
+
+        entry_factory::create<send_entry>(
+            sched, pack_send_buf, step_blocks * count, dtype, dst, comm);
+        entry_factory::create<recv_entry>(
+            sched, pack_recv_buf, step_blocks * count, dtype, src, comm);
+        sched->add_barrier();
+
+        step_blocks = 0;
+        for (int idx = mask; idx < comm_size; idx += 2 * mask) {
+            size_t blocks = std::min(mask, comm_size - idx);
+            entry_factory::create<copy_entry>(sched,
+                                              pack_recv_buf + step_blocks * block_bytes,
+                                              tmp_buf + idx * block_bytes,
+                                              blocks * count,
+                                              dtype);
+            step_blocks += blocks;
+        }
+        sched->add_barrier();
+    }
+
+    // now tmp block idx holds the data from rank (comm_rank - idx)
+    for (int idx = 0; idx < comm_size; idx++) {
+        entry_factory::create<copy_entry>(
+            sched,
+            tmp_buf + ((comm_rank - idx + comm_size) % comm_size) * block_bytes,
+            recv_buf + idx * block_bytes,
+            count,
+            dtype);
+    }
+
+    return ccl::status::success;
+}
+
+namespace {
+
+// hier alltoallv: data for every remote host is gathered by one local rank, the aggregator,
+// sent to the aggregator with the same local rank on that host and scattered there.
+// The aggregator of the host pair (h, m) is (h + m) % node_size on both hosts
+struct hier_alltoallv_plan {
+    ccl_buffer send_buf;
+    ccl_buffer recv_buf;
+    // user buffer passed with the allocations of temporary buffers
+    void* buf_hint;
+    std::vector<size_t> send_offsets;
+    std::vector<size_t> recv_offsets;
+    // comm ranks of every host in local rank order
+    std::vector<std::vector<int>> host_ranks;
+    // send and recv counts of all local ranks
+    ccl_buffer node_counts;
+    ccl_datatype dtype;
+    ccl_comm* comm;
+    int host_idx;
+    int node_rank;
+    bool inplace;
+};
+
+void add_hier_alltoallv_exchange(ccl_sched* sched, const hier_alltoallv_plan& plan) {
+    ccl_comm* comm = plan.comm;
+    const ccl_datatype& dtype = plan.dtype;
+    const auto& host_ranks = plan.host_ranks;
+    const auto& my_ranks = host_ranks[plan.host_idx];
+
+    int comm_size = comm->size();
+    int host_count = static_cast<int>(host_ranks.size());
+    int node_size = static_cast<int>(my_ranks.size());
+    int node_rank = plan.node_rank;
+    size_t dtype_size = dtype.size();
+
+    const size_t* node_counts = static_cast<const size_t*>(plan.node_counts.get_ptr());
+    auto send_count = [&](int local_rank, int dst) {
+        return node_counts[2 * local_rank * comm_size + dst];
+    };
+    auto recv_count = [&](int local_rank, int src) {
+        return node_counts[(2 * local_rank + 1) * comm_size + src];
+    };
+    auto get_aggregator = [&](int host) {
+        return (plan.host_idx + host) % node_size;
+    };
+    auto is_contiguous = [&](int host) {
+        for (int idx = 1; idx < node_size; idx++) {
+            if (host_ranks[host][idx] != host_ranks[host][0] + idx)
+                return false;
+        }
+        return true;
+    };
+
+    // element counts of the aggregated data for every remote host
+    // out: from local rank l to host m, in: from host m to local rank j
+    std::vector<std::vector<size_t>> agg_out_counts(host_count, std::vector<size_t>(node_size));
+    std::vector<size_t> agg_out_count(host_count), agg_in_count(host_count);
+    for (int host = 0; host < host_count; host++) {
+        if (host == plan.host_idx)
+            continue;
+        for (int local_rank = 0; local_rank < node_size; local_rank++) {
+            for (int idx = 0; idx < node_size; idx++) {
+                agg_out_counts[host][local_rank] += send_count(local_rank, host_ranks[host][idx]);
+                agg_in_count[host] += recv_count(local_rank, host_ranks[host][idx]);
+            }
+            agg_out_count[host] += agg_out_counts[host][local_rank];
+        }
+    }
+
+    auto send_block = [&](int rank) {
+        return plan.send_buf + plan.send_offsets[rank];
+    };
+    auto recv_block = [&](int rank) {
+        return plan.recv_buf + plan.recv_offsets[rank];
+    };
+
+    std::vector<ccl_buffer> agg_out_bufs(host_count), agg_in_bufs(host_count);
+    for (int host = 0; host < host_count; host++) {
+        if (host == plan.host_idx || get_aggregator(host) != node_rank)
+            continue;
+        if (agg_out_count[host]) {
+            agg_out_bufs[host] = sched->alloc_buffer(
+                { agg_out_count[host] * dtype_size, plan.buf_hint });
+        }
+        if (agg_in_count[host]) {
+            agg_in_bufs[host] =
+                sched->alloc_buffer({ agg_in_count[host] * dtype_size, plan.buf_hint });
+        }
+    }
+
+    // the blocks for the ranks of a host are packed unless they are contiguous already
+    std::vector<ccl_buffer> region_bufs(host_count);
+    for (int host = 0; host < host_count; host++) {
+        size_t region_count = agg_out_counts[host][node_rank];
+        if (host == plan.host_idx || !region_count)
+            continue;
+        if (is_contiguous(host)) {
+            region_bufs[host] = send_block(host_ranks[host][0]);
+            continue;
+        }
+        region_bufs[host] =
+            sched->alloc_buffer({ region_count * dtype_size, plan.buf_hint });
+        size_t offset = 0;
+        for (int idx = 0; idx < node_size; idx++) {
+            int dst = host_ranks[host][idx];
+            size_t count = send_count(node_rank, dst);
+            if (count) {
+                entry_factory::create<copy_entry>(
+                    sched, send_block(dst), region_bufs[host] + offset, count, dtype);
+            }
+            offset += count * dtype_size;
+        }
+    }
+    sched->add_barrier();
+
+    // gather: the blocks for the own host go directly, the regions go to their aggregators.
+    // Messages between a pair of local ranks are posted in the same order on both sides
+    std::vector<ccl_buffer> local_recv_bufs(node_size);
+    for (int idx = 0; idx < node_size; idx++) {
+        int peer = (node_rank + idx) % node_size;
+        int peer_rank = my_ranks[peer];
+
+        if (peer == node_rank) {
+            size_t count = send_count(node_rank, peer_rank);
+            if (!plan.inplace && count) {
+                entry_factory::create<copy_entry>(
+                    sched, send_block(peer_rank), recv_block(peer_rank), count, dtype);
+            }
+            for (int host = 0; host < host_count; host++) {
+                size_t region_count = agg_out_counts[host][node_rank];
+                if (host == plan.host_idx || get_aggregator(host) != node_rank || !region_count)
+                    continue;
+                size_t offset = 0;
+                for (int local_rank = 0; local_rank < node_rank; local_rank++) {
+                    offset += agg_out_counts[host][local_rank] * dtype_size;
+                }
+                entry_factory::create<copy_entry>(sched,
+                                                  region_bufs[host],
+                                                  agg_out_bufs[host] + offset,
+                                                  region_count,
+                                                  dtype);
+            }
+            continue;
+        }
+
+        size_t count = send_count(node_rank, peer_rank);
+        if (count) {
+            entry_factory::create<send_entry>(
+                sched, send_block(peer_rank), count, dtype, peer_rank, comm);
+        }
+        for (int host = 0; host < host_count; host++) {
+            size_t region_count = agg_out_counts[host][node_rank];
+            if (host == plan.host_idx || get_aggregator(host) != peer || !region_count)
+                continue;
+            entry_factory::create<send_entry>(
+                sched, region_bufs[host], region_count, dtype, peer_rank, comm);
+        }
+
+        count = recv_count(node_rank, peer_rank);
+        if (count) {
+            // in-place data is kept until all the sends are done
+            local_recv_bufs[peer] =
+                (plan.inplace)
+                    ? sched->alloc_buffer({ count * dtype_size, plan.buf_hint })
+                    : recv_block(peer_rank);
+            entry_factory::create<recv_entry>(
+                sched, local_recv_bufs[peer], count, dtype, peer_rank, comm);
+        }
+        for (int host = 0; host < host_count; host++) {
+            size_t region_count = agg_out_counts[host][peer];
+            if (host == plan.host_idx || get_aggregator(host) != node_rank || !region_count)
+                continue;
+            size_t offset = 0;
+            for (int local_rank = 0; local_rank < peer; local_rank++) {
+                offset += agg_out_counts[host][local_rank] * dtype_size;
+            }
+            entry_factory::create<recv_entry>(
+                sched, agg_out_bufs[host] + offset, region_count, dtype, peer_rank, comm);
+        }
+    }
+    sched->add_barrier();
+
+    // a single message per host pair between the aggregators
+    for (int host = 0; host < host_count; host++) {
+        if (host == plan.host_idx || get_aggregator(host) != node_rank)
+            continue;
+        int peer_rank = host_ranks[host][node_rank];
+        if (agg_out_count[host]) {
+            entry_factory::create<send_entry>(
+                sched, agg_out_bufs[host], agg_out_count[host], dtype, peer_rank, comm);
+        }
+        if (agg_in_count[host]) {
+            entry_factory::create<recv_entry>(
+                sched, agg_in_bufs[host], agg_in_count[host], dtype, peer_rank, comm);
+        }
+    }
+    sched->add_barrier();
+
+    // received data is ordered by the source local rank, the scatter needs it by the destination.
+    // The blocks for this rank go directly to recv_buf, all the sends are done already
+    std::vector<std::vector<ccl_buffer>> scatter_bufs(host_count);
+    for (int host = 0; host < host_count; host++) {
+        if (host == plan.host_idx || get_aggregator(host) != node_rank || !agg_in_count[host])
+            continue;
+        ccl_buffer scatter_buf =
+            sched->alloc_buffer({ agg_in_count[host] * dtype_size, plan.buf_hint });
+        std::vector<size_t> dst_offsets(node_size);
+        size_t offset = 0;
+        for (int local_rank = 0; local_rank < node_size; local_rank++) {
+            dst_offsets[local_rank] = offset;
+            for (int idx = 0; idx < node_size; idx++) {
+                offset += recv_count(local_rank, host_ranks[host][idx]) * dtype_size;
+            }
+        }
+        scatter_bufs[host].resize(node_size);
+        for (int local_rank = 0; local_rank < node_size; local_rank++) {
+            scatter_bufs[host][local_rank] = scatter_buf + dst_offsets[local_rank];
+        }
+        size_t src_offset = 0;
+        for (int idx = 0; idx < node_size; idx++) {
+            int src = host_ranks[host][idx];
+            for (int local_rank = 0; local_rank < node_size; local_rank++) {
+                size_t count = recv_count(local_rank, src);
+                if (count) {
+                    ccl_buffer dst_buf = (local_rank == node_rank)
+                                             ? recv_block(src)
+                                             : scatter_buf + dst_offsets[local_rank];
+                    entry_factory::create<copy_entry>(
+                        sched, agg_in_bufs[host] + src_offset, dst_buf, count, dtype);
+                    dst_offsets[local_rank] += count * dtype_size;
+                }
+                src_offset += count * dtype_size;
+            }
+        }
+    }
+    if (plan.inplace) {
+        for (int peer = 0; peer < node_size; peer++) {
+            size_t count = recv_count(node_rank, my_ranks[peer]);
+            if (peer == node_rank || !count)
+                continue;
+            entry_factory::create<copy_entry>(
+                sched, local_recv_bufs[peer], recv_block(my_ranks[peer]), count, dtype);
+        }
+    }
+    sched->add_barrier();
+
+    // scatter inside the host
+    std::vector<ccl_buffer> unpack_bufs(host_count);
+    for (int idx = 1; idx < node_size; idx++) {
+        int peer = (node_rank + idx) % node_size;
+        int peer_rank = my_ranks[peer];
+        for (int host = 0; host < host_count; host++) {
+            if (host == plan.host_idx || get_aggregator(host) != node_rank)
+                continue;
+            size_t count = 0;
+            for (int src_idx = 0; src_idx < node_size; src_idx++) {
+                count += recv_count(peer, host_ranks[host][src_idx]);
+            }
+            if (count) {
+                entry_factory::create<send_entry>(
+                    sched, scatter_bufs[host][peer], count, dtype, peer_rank, comm);
+            }
+        }
+        for (int host = 0; host < host_count; host++) {
+            if (host == plan.host_idx || get_aggregator(host) != peer)
+                continue;
+            size_t count = 0;
+            for (int src_idx = 0; src_idx < node_size; src_idx++) {
+                count += recv_count(node_rank, host_ranks[host][src_idx]);
+            }
+            if (!count)
+                continue;
+            unpack_bufs[host] =
+                (is_contiguous(host))
+                    ? recv_block(host_ranks[host][0])
+                    : sched->alloc_buffer({ count * dtype_size, plan.buf_hint });
+            entry_factory::create<recv_entry>(
+                sched, unpack_bufs[host], count, dtype, peer_rank, comm);
+        }
+    }
+    sched->add_barrier();
+
+    for (int host = 0; host < host_count; host++) {
+        if (host == plan.host_idx || get_aggregator(host) == node_rank || !unpack_bufs[host] ||
+            is_contiguous(host))
+            continue;
+        size_t offset = 0;
+        for (int idx = 0; idx < node_size; idx++) {
+            int src = host_ranks[host][idx];
+            size_t count = recv_count(node_rank, src);
+            if (count) {
+                entry_factory::create<copy_entry>(
+                    sched, unpack_bufs[host] + offset, recv_block(src), count, dtype);
+            }
+            offset += count * dtype_size;
+        }
+    }
+}
+
+} // namespace
+
+ccl::status ccl_coll_build_hier_alltoallv(ccl_sched* main_sched,
+                                          std::vector<ccl_sched*>& scheds,
+                                          const ccl_coll_param& coll_param) {
+    ccl_sched* sched = scheds[0];
+    ccl_comm* comm = coll_param.comm;
+    ccl_comm* node_comm = comm->get_node_comm().get();
+    const ccl::topo_manager& topo_manager = comm->get_topo_manager();
+
+    int comm_rank = comm->rank();
+    int comm_size = comm->size();
+    int node_size = node_comm->size();
+    int host_count = comm_size / node_size;
+
+    hier_alltoallv_plan plan;
+    plan.dtype = coll_param.dtype;
+    plan.comm = comm;
+    plan.host_idx = topo_manager.get_host_idx();
+    plan.node_rank = node_comm->rank();
+    plan.inplace = coll_param.is_inplace();
+    plan.buf_hint = coll_param.get_recv_buf();
+
+    LOG_DEBUG("build hier alltoallv: hosts ", host_count, ", node comm ", node_comm->to_string());
+
+    std::vector<size_t> send_counts, recv_counts;
+    size_t total_send_count = 0, total_recv_count = 0;
+    size_t total_send_bytes = 0, total_recv_bytes = 0;
+
+    ccl_coll_calculate_alltoallv_counts(coll_param,
+                                        send_counts,
+                                        recv_counts,
+                                        plan.send_offsets,
+                                        plan.recv_offsets,
+                                        total_send_count,
+                                        total_recv_count,
+                                        total_send_bytes,
+                                        total_recv_bytes);
+
+    plan.send_buf =
+        ccl_buffer(coll_param.get_send_buf_ptr(), total_send_bytes, 0, ccl_buffer_type::INDIRECT);
+    plan.recv_buf =
+        ccl_buffer(coll_param.get_recv_buf_ptr(), total_recv_bytes, 0, ccl_buffer_type::INDIRECT);
+
+    plan.host_ranks.resize(host_count);
+    for (int host = 0; host < host_count; host++) {
+        for (const auto& info : topo_manager.get_filtered_rank_info_vec(host)) {
+            plan.host_ranks[host].push_back(info.rank);
+        }
+        CCL_THROW_IF_NOT(static_cast<int>(plan.host_ranks[host].size()) == node_size,
+                         "unexpected number of ranks on host ",
+                         host,
+                         ": ",
+                         plan.host_ranks[host].size(),
+                         ", expected ",
+                         node_size);
+    }
+    CCL_THROW_IF_NOT(plan.host_ranks[plan.host_idx][plan.node_rank] == comm_rank,
+                     "unexpected local rank ",
+                     plan.node_rank,
+                     " for rank ",
+                     comm_rank);
+
+    // the aggregators need the counts of all local ranks
+    size_t counts_bytes = 2 * comm_size * sizeof(size_t);
+    plan.node_counts = sched->alloc_buffer({ node_size * counts_bytes, coll_param.get_recv_buf() });
+    ccl_buffer own_counts = plan.node_counts + plan.node_rank * counts_bytes;
+    size_t* own_counts_ptr = static_cast<size_t*>(own_counts.get_ptr());
+    std::copy(send_counts.begin(), send_counts.end(), own_counts_ptr);
+    std::copy(recv_counts.begin(), recv_counts.end(), own_counts_ptr + comm_size);
+
+    const auto& my_ranks = plan.host_ranks[plan.host_idx];
+    for (int idx = 1; idx < node_size; idx++) {
+        int dst = (plan.node_rank + idx) % node_size;
+        int src = (plan.node_rank - idx + node_size) % node_size;
+        entry_factory::create<send_entry>(
+            sched, own_counts, counts_bytes, ccl_datatype_int8, my_ranks[dst], comm);
+        entry_factory::create<recv_entry>(sched,
+                                          plan.node_counts + src * counts_bytes,
+                                          counts_bytes,
+                                          ccl_datatype_int8,
+                                          my_ranks[src],
+                                          comm);
+    }
+    sched->add_barrier();
+
+    // the exchange is built on its start when the counts are received
+    entry_factory::create<subsched_entry>(
+        sched,
+        1,
+        [plan](ccl_sched* s) {
+            add_hier_alltoallv_exchange(s, plan);
+        },
+        "A2AV_HIER");
+
+    return ccl::status::success;
+}
+
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 ccl::status ccl_coll_build_topo_alltoallv(ccl_sched* main_sched,
                                           std::vector<ccl_sched*>& scheds,
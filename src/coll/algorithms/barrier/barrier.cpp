@@ -20,6 +20,8 @@
 */
 
 #include "coll/algorithms/algorithms.hpp"
+#include "common/utils/exchange_utils.hpp"
+#include "common/utils/yield.hpp"
 #include "sched/entry/factory/entry_factory.hpp"
 
 ccl::status ccl_coll_build_direct_barrier(ccl_sched* sched, ccl_comm* comm) {
@@ -52,3 +54,147 @@ ccl::status ccl_coll_build_dissemination_barrier(ccl_sched* sched, ccl_comm* com
 
     return status;
 }
+
+ccl::status ccl_coll_build_shm_barrier(ccl_sched* sched, ccl_comm* comm) {
+    LOG_DEBUG("build shm barrier");
+
+    entry_factory::create<shm_coll_entry>(sched,
+                                          ccl_coll_barrier,
+                                          ccl_buffer(),
+                                          ccl_buffer(),
+                                          0,
+                                          nullptr,
+                                          ccl_datatype_int8,
+                                          ccl::reduction::custom,
+                                          CCL_INVALID_ROOT_RANK_IDX,
+                                          comm);
+    return ccl::status::success;
+}
+
+namespace {
+
+// dissemination among the node leaders, leader of host h exchanges with hosts h +/- 2^k
+void add_leaders_barrier(ccl_sched* sched, ccl_comm* comm, int host_idx, int host_count) {
+    const ccl::topo_manager& topo_manager = comm->get_topo_manager();
+    for (int mask = 0x1; mask < host_count; mask <<= 1) {
+        int dst = topo_manager.get_host_leader_rank((host_idx + mask) % host_count);
+        int src = topo_manager.get_host_leader_rank((host_idx - mask + host_count) % host_count);
+        entry_factory::create<send_entry>(sched, ccl_buffer(), 0, ccl_datatype_int8, dst, comm);
+        entry_factory::create<recv_entry>(sched, ccl_buffer(), 0, ccl_datatype_int8, src, comm);
+        sched->add_barrier();
+    }
+}
+
+void add_node_barrier(ccl_sched* sched, ccl_comm* node_comm) {
+    if (node_comm->size() == 1)
+        return;
+
+    // ranks of nodes without shm segment exchange messages instead
+    if (node_comm->get_shm_coll_ctx()) {
+        ccl_coll_build_shm_barrier(sched, node_comm);
+    }
+    else {
+        ccl_coll_build_dissemination_barrier(sched, node_comm);
+    }
+    sched->add_barrier();
+}
+
+// blocking dissemination over count participants, get_rank maps participant index to comm rank.
+// The messages use the tag reserved for the barrier without schedule
+template <class rank_fn_t>
+void run_dissemination(ccl_comm* comm, int idx, int count, rank_fn_t get_rank) {
+    auto atl_comm = comm->get_atl_comm();
+    ccl_sched_id_t sched_id = atl_comm->tag_creator->get_barrier_sched_id();
+    uint64_t send_tag = atl_comm->tag_creator->create(comm->rank(), comm->get_comm_id(), sched_id);
+    char ack[1];
+
+    for (int mask = 0x1; mask < count; mask <<= 1) {
+        int dst = get_rank((idx + mask) % count);
+        int src = get_rank((idx - mask + count) % count);
+        uint64_t recv_tag = atl_comm->tag_creator->create(src, comm->get_comm_id(), sched_id);
+        // zero-byte sends complete on the call when the transport injects them
+        atl_req_t send_req = ccl::utils::send(atl_comm, ack, 0, dst, send_tag, false);
+        ccl::utils::recv(atl_comm, ack, 0, src, recv_tag);
+        ccl::utils::check(atl_comm, send_req);
+    }
+}
+
+void run_node_barrier(ccl_comm* node_comm) {
+    if (node_comm->size() == 1)
+        return;
+
+    ccl_shm_coll_ctx* ctx = node_comm->get_shm_coll_ctx();
+    if (!ctx) {
+        run_dissemination(node_comm, node_comm->rank(), node_comm->size(), [](int idx) {
+            return idx;
+        });
+        return;
+    }
+
+    // the same flag protocol as in the shm barrier entry,
+    // the sequence number keeps it ordered with the scheduled shm collectives
+    uint64_t seq = ctx->acquire_seq();
+    if (seq >= ccl_shm_coll_ctx::slot_count) {
+        while (!ctx->is_step_reached(seq - ccl_shm_coll_ctx::slot_count,
+                                     ccl_shm_coll_ctx::done_step)) {
+            ccl_yield(ccl::global_data::env().yield_type);
+        }
+    }
+    ctx->publish(seq, ccl_shm_coll_ctx::done_step);
+    while (!ctx->is_step_reached(seq, ccl_shm_coll_ctx::done_step)) {
+        ccl_yield(ccl::global_data::env().yield_type);
+    }
+}
+
+bool is_node_leader(ccl_comm* comm) {
+    if (comm->get_node_comm()->rank() != 0)
+        return false;
+
+    const ccl::topo_manager& topo_manager = comm->get_topo_manager();
+    CCL_THROW_IF_NOT(topo_manager.get_host_leader_rank(topo_manager.get_host_idx()) == comm->rank(),
+                     "rank ",
+                     comm->rank(),
+                     " is the first rank of node comm but not the host leader");
+    return true;
+}
+
+} // namespace
+
+// node barrier, dissemination among the node leaders, node barrier again to release the ranks
+ccl::status ccl_coll_build_hier_barrier(ccl_sched* sched, ccl_comm* comm) {
+    LOG_DEBUG("build hier barrier");
+
+    ccl_comm* node_comm = comm->get_node_comm().get();
+    const ccl::topo_manager& topo_manager = comm->get_topo_manager();
+    int host_count = topo_manager.get_host_count();
+
+    add_node_barrier(sched, node_comm);
+    if (host_count == 1)
+        return ccl::status::success;
+
+    if (is_node_leader(comm)) {
+        add_leaders_barrier(sched, comm, topo_manager.get_host_idx(), host_count);
+    }
+    add_node_barrier(sched, node_comm);
+
+    return ccl::status::success;
+}
+
+void ccl_run_hier_barrier(ccl_comm* comm) {
+    LOG_DEBUG("run hier barrier");
+
+    ccl_comm* node_comm = comm->get_node_comm().get();
+    const ccl::topo_manager& topo_manager = comm->get_topo_manager();
+    int host_count = topo_manager.get_host_count();
+
+    run_node_barrier(node_comm);
+    if (host_count == 1)
+        return;
+
+    if (is_node_leader(comm)) {
+        run_dissemination(comm, topo_manager.get_host_idx(), host_count, [&](int idx) {
+            return topo_manager.get_host_leader_rank(idx);
+        });
+    }
+    run_node_barrier(node_comm);
+}
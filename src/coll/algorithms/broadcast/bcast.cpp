@@ -75,6 +75,27 @@ fn_exit:
     return status;
 }
 
+ccl::status ccl_coll_build_shm_bcast(ccl_sched* sched,
+                                     ccl_buffer buf,
+                                     size_t count,
+                                     const ccl_datatype& dtype,
+                                     int root,
+                                     ccl_comm* comm) {
+    LOG_DEBUG("build shm bcast");
+
+    entry_factory::create<shm_coll_entry>(sched,
+                                          ccl_coll_bcast,
+                                          buf,
+                                          buf,
+                                          count,
+                                          nullptr,
+                                          dtype,
+                                          ccl::reduction::custom,
+                                          root,
+                                          comm);
+    return ccl::status::success;
+}
+
 ccl::status ccl_coll_build_scatter_for_bcast(ccl_sched* sched,
                                              ccl_buffer tmp_buf,
                                              int root,
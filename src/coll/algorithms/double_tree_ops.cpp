@@ -41,6 +41,47 @@ static void bcast_tree(const ccl_bin_tree& tree,
     }
 }
 
+static void recv_reduce_children(const ccl_bin_tree& tree,
+                                 ccl_sched* sched,
+                                 ccl_buffer buffer,
+                                 size_t count,
+                                 const ccl_datatype& dtype,
+                                 ccl::reduction reduction,
+                                 ccl_comm* comm) {
+    // the root completes the result with the last child reduction, avg is divided there
+    size_t avg_divisor = (tree.parent() == -1) ? comm->size() : 1;
+    if (tree.left() != -1) {
+        LOG_DEBUG("recv_reduce left ", tree.left());
+        entry_factory::create<recv_reduce_entry>(sched,
+                                                 buffer,
+                                                 count,
+                                                 dtype,
+                                                 reduction,
+                                                 static_cast<size_t>(tree.left()),
+                                                 comm,
+                                                 ccl_buffer(),
+                                                 ccl_recv_reduce_local_buf,
+                                                 (tree.right() == -1) ? avg_divisor : 1);
+    }
+    if (tree.right() != -1) {
+        if (tree.left() != -1 && avg_divisor > 1 && reduction == ccl::reduction::avg) {
+            // order the reductions to know which one is the last
+            sched->add_barrier();
+        }
+        LOG_DEBUG("recv_reduce right ", tree.right());
+        entry_factory::create<recv_reduce_entry>(sched,
+                                                 buffer,
+                                                 count,
+                                                 dtype,
+                                                 reduction,
+                                                 static_cast<size_t>(tree.right()),
+                                                 comm,
+                                                 ccl_buffer(),
+                                                 ccl_recv_reduce_local_buf,
+                                                 avg_divisor);
+    }
+}
+
 static void reduce_tree(const ccl_bin_tree& tree,
                         ccl_sched* sched,
                         ccl_buffer buffer,
@@ -48,16 +89,7 @@ static void reduce_tree(const ccl_bin_tree& tree,
                         const ccl_datatype& dtype,
                         ccl::reduction reduction,
                         ccl_comm* comm) {
-    if (tree.left() != -1) {
-        LOG_DEBUG("recv_reduce left ", tree.left());
-        entry_factory::create<recv_reduce_entry>(
-            sched, buffer, count, dtype, reduction, static_cast<size_t>(tree.left()), comm);
-    }
-    if (tree.right() != -1) {
-        LOG_DEBUG("recv_reduce right ", tree.right());
-        entry_factory::create<recv_reduce_entry>(
-            sched, buffer, count, dtype, reduction, static_cast<size_t>(tree.right()), comm);
-    }
+    recv_reduce_children(tree, sched, buffer, count, dtype, reduction, comm);
     if (tree.parent() != -1) {
         if (tree.left() != -1 || tree.right() != -1) {
             sched->add_barrier();
@@ -75,16 +107,7 @@ static void reduce_bcast_tree(const ccl_bin_tree& tree,
                               const ccl_datatype& dtype,
                               ccl::reduction reduction,
                               ccl_comm* comm) {
-    if (tree.left() != -1) {
-        LOG_DEBUG("recv_reduce left ", tree.left());
-        entry_factory::create<recv_reduce_entry>(
-            sched, buffer, count, dtype, reduction, static_cast<size_t>(tree.left()), comm);
-    }
-    if (tree.right() != -1) {
-        LOG_DEBUG("recv_reduce right ", tree.right());
-        entry_factory::create<recv_reduce_entry>(
-            sched, buffer, count, dtype, reduction, static_cast<size_t>(tree.right()), comm);
-    }
+    recv_reduce_children(tree, sched, buffer, count, dtype, reduction, comm);
     if (tree.parent() != -1) {
         if (tree.left() != -1 || tree.right() != -1) {
             sched->add_barrier();
@@ -115,6 +138,30 @@ static void reduce_bcast_tree(const ccl_bin_tree& tree,
     }
 }
 
+static void build_pipelined_allreduce(const ccl_bin_tree& tree,
+                                      ccl_sched* sched,
+                                      ccl_op_id_t op_id,
+                                      ccl_buffer buffer,
+                                      size_t count,
+                                      const ccl_datatype& dtype,
+                                      ccl::reduction reduction,
+                                      ccl_comm* comm,
+                                      const char* name) {
+    if (count == 0) {
+        return;
+    }
+
+    size_t chunk_count = tree_allreduce_entry::get_chunk_count(count, dtype, comm->size());
+    entry_factory::create<subsched_entry>(
+        sched,
+        op_id,
+        [buffer, count, chunk_count, dtype, reduction, tree, comm](ccl_sched* s) {
+            entry_factory::create<tree_allreduce_entry>(
+                s, buffer, count, chunk_count, dtype, reduction, tree, comm);
+        },
+        name);
+}
+
 ccl::status ccl_coll_build_double_tree_op(ccl_sched* sched,
                                           ccl_coll_type coll_type,
                                           ccl_buffer send_buf,
@@ -143,6 +190,27 @@ ccl::status ccl_coll_build_double_tree_op(ccl_sched* sched,
     ccl_buffer t2_start = t1_end;
     ccl_buffer t2_end = t2_start + t2_count * dtype.size();
 
+    // host buffers: every tree reduces and broadcasts its half in a single pipelined entry
+    if (coll_type == ccl_coll_allreduce && !sched->coll_param.stream && count > 0) {
+        const auto& t1 = dtree.T1();
+        const auto& t2 = dtree.T2();
+        //even ranks are leaves in T2, start schedule with T2
+        if (comm->rank() % 2 == 0) {
+            build_pipelined_allreduce(
+                t2, sched, 1, t2_start, t2_count, dtype, op, comm, "tree_allreduce_t2");
+            build_pipelined_allreduce(
+                t1, sched, 0, t1_start, t1_count, dtype, op, comm, "tree_allreduce_t1");
+        }
+        else {
+            build_pipelined_allreduce(
+                t1, sched, 0, t1_start, t1_count, dtype, op, comm, "tree_allreduce_t1");
+            build_pipelined_allreduce(
+                t2, sched, 1, t2_start, t2_count, dtype, op, comm, "tree_allreduce_t2");
+        }
+        sched->add_barrier();
+        return status;
+    }
+
     //todo: evaluate/configure k param;
     size_t parts = 1;
     if (ccl::global_data::env().dtree_partition_count != CCL_ENV_SIZET_NOT_SPECIFIED) {
@@ -219,14 +219,16 @@ ccl::status ccl_coll_build_rabenseifner_reduce(ccl_sched* sched,
              * recv_buf contains data accumulated so far */
 
             /* This algorithm is used only for predefined ops
-             * and predefined ops are always commutative. */
+             * and predefined ops are always commutative.
+             * The last step completes the result, avg is divided there. */
             entry_factory::create<reduce_local_entry>(sched,
                                                       (tmp_buf + disps[recv_idx] * dtype_size),
                                                       recv_cnt,
                                                       (recv_buf + disps[recv_idx] * dtype_size),
                                                       nullptr,
                                                       dtype,
-                                                      reduction);
+                                                      reduction,
+                                                      ((mask << 1) >= pof2) ? comm_size : 1);
             sched->add_barrier();
 
             /* update send_idx for next iteration */
@@ -504,8 +506,16 @@ ccl::status ccl_coll_build_binomial_reduce(ccl_sched* sched,
                 entry_factory::create<recv_entry>(sched, tmp_buf, count, dtype, source, comm);
                 sched->add_barrier();
 
+                /* the last receive of the root completes the result, avg is divided there */
                 entry_factory::create<reduce_local_entry>(
-                    sched, tmp_buf, count, recv_buf, nullptr, dtype, reduction);
+                    sched,
+                    tmp_buf,
+                    count,
+                    recv_buf,
+                    nullptr,
+                    dtype,
+                    reduction,
+                    (relrank == 0 && (mask << 1) >= comm_size) ? comm_size : 1);
                 sched->add_barrier();
             }
         }
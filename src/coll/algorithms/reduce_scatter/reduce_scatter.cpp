@@ -131,8 +131,14 @@ ccl::status ccl_coll_build_naive_reduce_scatter(ccl_sched* sched,
 
         sched->add_barrier();
 
-        entry_factory::create<reduce_local_entry>(
-            sched, tmp_buf, recv_count, recv_buf, nullptr, dtype, op);
+        entry_factory::create<reduce_local_entry>(sched,
+                                                  tmp_buf,
+                                                  recv_count,
+                                                  recv_buf,
+                                                  nullptr,
+                                                  dtype,
+                                                  op,
+                                                  (idx == comm_size - 1) ? comm_size : 1);
     }
 
     return status;
@@ -186,6 +192,28 @@ ccl::status ccl_coll_build_ring_reduce_scatter(ccl_sched* sched,
     return ccl::status::success;
 }
 
+ccl::status ccl_coll_build_shm_reduce_scatter(ccl_sched* sched,
+                                              ccl_buffer send_buf,
+                                              ccl_buffer recv_buf,
+                                              size_t recv_count,
+                                              const ccl_datatype& dtype,
+                                              ccl::reduction op,
+                                              ccl_comm* comm) {
+    LOG_DEBUG("build shm reduce_scatter");
+
+    entry_factory::create<shm_coll_entry>(sched,
+                                          ccl_coll_reduce_scatter,
+                                          send_buf,
+                                          recv_buf,
+                                          recv_count,
+                                          nullptr,
+                                          dtype,
+                                          op,
+                                          CCL_INVALID_ROOT_RANK_IDX,
+                                          comm);
+    return ccl::status::success;
+}
+
 /* A building block for other collectives (used as a part of allreduce, reduce, reduce_scatter).
  * Implemented with "ring" algorithm, chunking/pipelining is supported.
  * Last block may contain more elements. */
@@ -355,6 +383,9 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
 
             entry_factory::create<send_entry>(sched, sbuf, send_chunk_size, dtype, dst, comm);
 
+            /* the last step completes the block, avg is divided there */
+            bool is_last_step = (idx == comm_size - 2);
+
             if (!use_prev) {
                 CCL_ASSERT(recv_chunk_size == reduce_chunk_size);
                 entry_factory::create<recv_reduce_entry>(sched,
@@ -365,19 +396,23 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
                                                          src,
                                                          comm,
                                                          recv_reduce_comm_buf,
-                                                         recv_reduce_result_type);
+                                                         recv_reduce_result_type,
+                                                         is_last_step ? comm_size : 1);
             }
             else {
                 entry_factory::create<recv_entry>(sched, rbuf, recv_chunk_size, dtype, src, comm);
 
                 if (idx + chunk_idx > 0) {
-                    entry_factory::create<reduce_local_entry>(sched,
-                                                              reduce_in_buf,
-                                                              reduce_chunk_size,
-                                                              reduce_inout_buf,
-                                                              nullptr,
-                                                              dtype,
-                                                              op);
+                    /* the previous chunk is reduced here */
+                    entry_factory::create<reduce_local_entry>(
+                        sched,
+                        reduce_in_buf,
+                        reduce_chunk_size,
+                        reduce_inout_buf,
+                        nullptr,
+                        dtype,
+                        op,
+                        (is_last_step && chunk_idx > 0) ? comm_size : 1);
                     sched->add_barrier();
                 }
 
@@ -403,7 +438,8 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
                                                               reduce_inout_buf,
                                                               nullptr,
                                                               dtype,
-                                                              op);
+                                                              op,
+                                                              comm_size);
                 }
             }
 
@@ -32,6 +32,7 @@
 #include "oneapi/ccl/stream_attr_ids_traits.hpp"
 #include "oneapi/ccl/stream.hpp"
 
+#include "common/request/persistent_request_impl.hpp"
 #include "common/request/request.hpp"
 #include "common/event/impls/host_event.hpp"
 
@@ -56,6 +57,7 @@
 
 #include "coll/algorithms/algorithm_utils.hpp"
 #include "coll/algorithms/algorithms.hpp"
+#include "coll/selection/adaptive_selector.hpp"
 #include "coll/selection/selection.hpp"
 #include "exec/exec.hpp"
 #include "fusion/fusion.hpp"
@@ -248,6 +250,7 @@ static ccl_request* ccl_coll_create(ccl_coll_param& param, const ccl_coll_attr&
     selector_param.recv_counts =
         const_cast<size_t*>(reinterpret_cast<const size_t*>(param.recv_counts.data()));
     selector_param.dtype = param.dtype;
+    selector_param.reduction = param.reduction;
     selector_param.comm = param.comm;
     selector_param.stream = param.stream;
     selector_param.buf = (param.send_buf) ? param.send_buf.get_ptr() : param.recv_buf.get_ptr();
@@ -259,6 +262,24 @@ static ccl_request* ccl_coll_create(ccl_coll_param& param, const ccl_coll_attr&
     selector_param.peer_rank = param.peer_rank;
     selector_param.is_scaleout = param.is_scaleout;
 
+    /* adaptive selection passes its choice as hint, so it goes before any algo checks */
+    bool is_adaptive_timed = false;
+    if (data.adaptive_selector) {
+        is_adaptive_timed = data.adaptive_selector->select(param, selector_param, attr);
+    }
+
+    if (param.ctype == ccl_coll_barrier && ccl::global_data::env().enable_barrier_fast_path &&
+        !group_impl::is_group_active &&
+        data.algorithm_selector->get<ccl_coll_barrier>(selector_param) == ccl_coll_barrier_hier) {
+        // the selection is the same on all ranks, so either all of them take the fast path or none
+        for (auto& dep : param.deps) {
+            dep.wait();
+        }
+        ccl_run_hier_barrier(param.comm);
+        // returned nullptr will be used to create an empty and completed event
+        return nullptr;
+    }
+
     // Some allgatherv algos hang up because of L0 submissions from multiple schedules MLSL-3258, MLSL-3461
     // WA is to make allgatherv flat & mullti_bcast synchronous
     if (param.ctype == ccl_coll_allgatherv &&
@@ -432,6 +453,10 @@ static ccl_request* ccl_coll_create(ccl_coll_param& param, const ccl_coll_attr&
 
     sched->set_submitted_to_gpu(false);
 
+    if (is_adaptive_timed) {
+        sched->adaptive_timer.start();
+    }
+
     /* 6. regular schedule execution */
     ccl_request* request = sched->start(data.executor.get());
     if (sched->coll_attr.synchronous) {
@@ -572,6 +597,10 @@ ccl::status ccl_coll_build_allgatherv(ccl_sched* sched,
             CCL_CALL(
                 ccl_coll_build_multi_bcast_allgatherv(nullptr, part_scheds, get_coll_param(), 1));
             break;
+        case ccl_coll_allgatherv_shm:
+            CCL_CALL(ccl_coll_build_shm_allgatherv(
+                sched, send_buf, send_count, recv_buf, recv_counts, dtype, comm));
+            break;
         case ccl_coll_allgatherv_naive:
             CCL_CALL(ccl_coll_build_naive_allgatherv(sched,
                                                      send_buf,
@@ -624,6 +653,7 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
     param.ctype = ccl_coll_allreduce;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.buf = send_buf.get_ptr();
@@ -635,6 +665,9 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_allreduce>(param);
 
+    /* 2d and hier algorithms build nested colls on the same sched, don't pass allreduce hint */
+    sched->hint_algo = {};
+
     switch (algo) {
         case ccl_coll_allreduce_direct:
             CCL_CALL(ccl_coll_build_direct_allreduce(
@@ -648,6 +681,10 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
             CCL_CALL(ccl_coll_build_nreduce_allreduce(
                 sched, send_buf, recv_buf, count, dtype, reduction, comm));
             break;
+        case ccl_coll_allreduce_shm:
+            CCL_CALL(ccl_coll_build_shm_allreduce(
+                sched, send_buf, recv_buf, count, dtype, reduction, comm));
+            break;
         case ccl_coll_allreduce_ring:
             CCL_CALL(ccl_coll_build_ring_allreduce(
                 sched, send_buf, recv_buf, count, recv_device_bufs, dtype, reduction, comm));
@@ -675,6 +712,10 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
             CCL_CALL(ccl_coll_build_2d_allreduce(
                 sched, send_buf, recv_buf, count, dtype, reduction, comm));
             break;
+        case ccl_coll_allreduce_hier:
+            CCL_CALL(ccl_coll_build_hier_allreduce(
+                sched, send_buf, recv_buf, count, dtype, reduction, comm));
+            break;
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
         case ccl_coll_allreduce_topo:
             CCL_CALL(ccl_coll_build_topo_allreduce(
@@ -777,6 +818,8 @@ ccl::status ccl_coll_build_barrier(ccl_sched* sched, ccl_comm* comm) {
         case ccl_coll_barrier_ring:
             CCL_CALL(ccl_coll_build_dissemination_barrier(sched, comm));
             break;
+        case ccl_coll_barrier_shm: CCL_CALL(ccl_coll_build_shm_barrier(sched, comm)); break;
+        case ccl_coll_barrier_hier: CCL_CALL(ccl_coll_build_hier_barrier(sched, comm)); break;
         default:
             CCL_FATAL("unexpected barrier_algo ", ccl_coll_algorithm_to_str(algo));
             return ccl::status::invalid_arguments;
@@ -815,6 +858,9 @@ ccl::status ccl_coll_build_bcast(ccl_sched* sched,
             CCL_CALL(
                 ccl_coll_build_scatter_ring_allgather_bcast(sched, buf, count, dtype, root, comm));
             break;
+        case ccl_coll_bcast_shm:
+            CCL_CALL(ccl_coll_build_shm_bcast(sched, buf, count, dtype, root, comm));
+            break;
         case ccl_coll_bcast_double_tree:
             CCL_CALL(ccl_coll_build_double_tree_op(
                 sched,
@@ -919,6 +965,7 @@ ccl::status ccl_coll_build_reduce(ccl_sched* sched,
     param.ctype = ccl_coll_reduce;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.buf = send_buf.get_ptr();
@@ -988,6 +1035,7 @@ ccl::status ccl_coll_build_reduce_scatter(ccl_sched* sched,
     param.ctype = ccl_coll_reduce_scatter;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.buf = send_buf.get_ptr();
@@ -1000,6 +1048,12 @@ ccl::status ccl_coll_build_reduce_scatter(ccl_sched* sched,
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_reduce_scatter>(param);
 
     switch (algo) {
+        case ccl_coll_reduce_scatter_shm:
+            if (!from_allreduce) {
+                CCL_CALL(ccl_coll_build_shm_reduce_scatter(
+                    sched, send_buf, recv_buf, count, dtype, reduction, comm));
+                break;
+            }
         case ccl_coll_reduce_scatter_direct:
             if (!from_allreduce) {
                 CCL_CALL(ccl_coll_build_direct_reduce_scatter(
@@ -1450,6 +1504,37 @@ ccl_request* ccl_allreduce_impl(const void* send_buf,
     return req;
 }
 
+ccl::persistent_request ccl_allreduce_init(const void* send_buf,
+                                           void* recv_buf,
+                                           size_t count,
+                                           ccl::datatype dtype,
+                                           ccl::reduction reduction,
+                                           const ccl_coll_attr& in_attr,
+                                           ccl_comm* comm) {
+    ccl_coll_attr attr = in_attr;
+    // the sched is owned by the persistent request and is not shared through the cache,
+    // the completion is tracked by the request itself
+    attr.to_cache = 0;
+    attr.synchronous = 0;
+
+    ccl_coll_param param = ccl_coll_param::create_allreduce_param(
+        send_buf, recv_buf, count, dtype, reduction, attr, comm, nullptr, {});
+
+    ccl_coll_validate_user_input(param, attr);
+
+    CCL_THROW_IF_NOT(!group_impl::is_group_active,
+                     "persistent operations are not supported inside group calls");
+    CCL_THROW_IF_NOT(!ccl::global_data::env().enable_unordered_coll,
+                     "persistent operations are not supported with unordered collectives");
+
+    /* parameter processing, algorithm selection and sched build are done once here */
+    ccl_sched* sched = ccl_sched::create(param, attr);
+    sched->commit(ccl::global_data::get().parallelizer.get());
+
+    LOG_DEBUG("persistent coll ", ccl_coll_type_to_str(param.ctype), " created, sched ", sched);
+    return std::unique_ptr<ccl::persistent_request_impl>(new ccl::persistent_request_impl(sched));
+}
+
 ccl::event ccl_alltoall(const void* send_buf,
                         void* recv_buf,
                         size_t count,
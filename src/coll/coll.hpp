@@ -195,6 +195,14 @@ ccl_request* ccl_allreduce_impl(const void* send_buf,
                                 const ccl_stream* stream,
                                 const std::vector<ccl::event>& deps);
 
+ccl::persistent_request ccl_allreduce_init(const void* send_buf,
+                                           void* recv_buf,
+                                           size_t count,
+                                           ccl::datatype dtype,
+                                           ccl::reduction reduction,
+                                           const ccl_coll_attr& attr,
+                                           ccl_comm* comm);
+
 ccl::event ccl_alltoall(const void* send_buf,
                         void* recv_buf,
                         size_t count,
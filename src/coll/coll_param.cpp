@@ -464,10 +464,18 @@ void ccl_coll_param::validate() const {
 
             if (ctype == ccl_coll_allreduce || ctype == ccl_coll_reduce_scatter ||
                 ctype == ccl_coll_reduce) {
-                if (reduction == ccl::reduction::avg) {
+                // host buffers support avg for floating point types only,
+                // the sum is divided by comm size within the last reduction step
+                bool is_avg_supported =
+                    !stream && (dtype.idx() == ccl::datatype::float16 ||
+                                dtype.idx() == ccl::datatype::bfloat16 ||
+                                dtype.idx() == ccl::datatype::float32 ||
+                                dtype.idx() == ccl::datatype::float64);
+                if (reduction == ccl::reduction::avg && !is_avg_supported) {
                     // CCL_THROW_IF_NOT produce and error message which CI interprets as a failed test,
                     // however in some cases we want to throw exception, catch it and skip the average test.
-                    CCL_THROW("average operation is not supported for the scheduler path");
+                    CCL_THROW("average operation is not supported for the scheduler path with ",
+                              stream ? "stream" : ccl::global_data::get().dtypes->name(dtype));
                 }
             }
 
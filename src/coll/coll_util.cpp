@@ -59,6 +59,11 @@ void add_coll_entry(ccl_sched* sched, const ccl_coll_param& param) {
             /* entry directly into schedule due to performance reasons */
             coll_entry::build_sched(sched, param);
         }
+        else if (ccl_is_shm_algo(selector_param)) {
+            /* shm entries take slots of the node segment in the order of schedule renewal,
+               entry should be in the schedule at that moment rather than built lazily */
+            coll_entry::build_sched(sched, param);
+        }
         else {
             entry_factory::create<coll_entry>(sched, param);
         }
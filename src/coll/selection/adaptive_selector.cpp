@@ -0,0 +1,258 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "coll/coll.hpp"
+#include "coll/group/group.hpp"
+#include "coll/selection/adaptive_selector.hpp"
+#include "coll/selection/selection.hpp"
+#include "common/global/global.hpp"
+#include "exec/exec.hpp"
+
+#include <numeric>
+
+thread_local bool ccl_adaptive_selector::is_agreement_active = false;
+
+template <ccl_coll_type coll_id>
+static void filter_candidates(
+    ccl_selector_param& param,
+    std::initializer_list<typename ccl_algorithm_selector<coll_id>::type> algos,
+    std::vector<int>& result,
+    std::vector<std::string>& names) {
+    for (auto algo : algos) {
+        param.hint_algo.value = algo;
+        if (ccl::global_data::get().algorithm_selector->get<coll_id>(param) == algo) {
+            result.push_back(algo);
+            names.push_back(ccl_coll_algorithm_to_str(algo));
+        }
+    }
+}
+
+ccl_adaptive_selector::ccl_adaptive_selector(size_t iters) : iters(iters) {
+    CCL_THROW_IF_NOT(iters > 0, "unexpected iteration count ", iters);
+}
+
+ccl_adaptive_selector::key_t ccl_adaptive_selector::get_key(const ccl_coll_param& param) {
+    /* the key must be the same on all ranks, so allgatherv uses the total recv count */
+    size_t count = param.count;
+    if (param.ctype == ccl_coll_allgatherv) {
+        count = std::accumulate(param.recv_counts.begin(), param.recv_counts.end(), size_t(0));
+    }
+
+    int bucket = -1;
+    for (size_t bytes = count * param.dtype.size(); bytes; bytes >>= 1) {
+        bucket++;
+    }
+
+    return std::make_tuple(static_cast<int>(param.ctype),
+                           static_cast<int>(param.dtype.idx()),
+                           bucket,
+                           param.comm->id(),
+                           param.comm->size());
+}
+
+void ccl_adaptive_selector::get_candidates(ccl_selector_param selector_param,
+                                           std::vector<int>& algos,
+                                           std::vector<std::string>& names) {
+    /* host algorithms which are safe to switch between on every call */
+    switch (selector_param.ctype) {
+        case ccl_coll_allgatherv:
+            filter_candidates<ccl_coll_allgatherv>(selector_param,
+                                                   { ccl_coll_allgatherv_naive,
+                                                     ccl_coll_allgatherv_ring },
+                                                   algos,
+                                                   names);
+            break;
+        case ccl_coll_allreduce:
+            filter_candidates<ccl_coll_allreduce>(selector_param,
+                                                  { ccl_coll_allreduce_rabenseifner,
+                                                    ccl_coll_allreduce_nreduce,
+                                                    ccl_coll_allreduce_ring,
+                                                    ccl_coll_allreduce_double_tree,
+                                                    ccl_coll_allreduce_recursive_doubling },
+                                                  algos,
+                                                  names);
+            break;
+        case ccl_coll_alltoall:
+            filter_candidates<ccl_coll_alltoall>(selector_param,
+                                                 { ccl_coll_alltoall_naive,
+                                                   ccl_coll_alltoall_scatter,
+                                                   ccl_coll_alltoall_pairwise,
+                                                   ccl_coll_alltoall_bruck },
+                                                 algos,
+                                                 names);
+            break;
+        case ccl_coll_bcast:
+            filter_candidates<ccl_coll_bcast>(
+                selector_param,
+                { ccl_coll_bcast_ring, ccl_coll_bcast_double_tree, ccl_coll_bcast_naive },
+                algos,
+                names);
+            break;
+        case ccl_coll_reduce:
+            filter_candidates<ccl_coll_reduce>(selector_param,
+                                               { ccl_coll_reduce_rabenseifner,
+                                                 ccl_coll_reduce_ring,
+                                                 ccl_coll_reduce_tree,
+                                                 ccl_coll_reduce_double_tree },
+                                               algos,
+                                               names);
+            break;
+        case ccl_coll_reduce_scatter:
+            filter_candidates<ccl_coll_reduce_scatter>(
+                selector_param,
+                { ccl_coll_reduce_scatter_naive, ccl_coll_reduce_scatter_ring },
+                algos,
+                names);
+            break;
+        /* alltoallv is skipped as its message size differs between ranks */
+        default: break;
+    }
+}
+
+bool ccl_adaptive_selector::select(ccl_coll_param& param,
+                                   ccl_selector_param& selector_param,
+                                   ccl_coll_attr& attr) {
+    if (is_agreement_active || group_impl::is_group_active || param.hint_algo.has_value() ||
+        param.stream || param.reduction == ccl::reduction::custom || attr.is_vector_buf ||
+        param.comm->size() == 1) {
+        return false;
+    }
+
+    auto key = get_key(param);
+
+    std::unique_lock<lock_t> lock{ guard };
+
+    auto it = states.find(key);
+    if (it == states.end()) {
+        state_t state;
+        get_candidates(selector_param, state.algos, state.algo_names);
+        state.time_usec.resize(state.algos.size(), 0);
+        state.samples.resize(state.algos.size(), 0);
+        /* nothing to explore, keep regular selection */
+        state.is_locked = (state.algos.size() < 2);
+        it = states.emplace(key, std::move(state)).first;
+    }
+    state_t& state = it->second;
+
+    size_t algo_count = state.algos.size();
+    if (!state.is_locked && state.call_idx == algo_count * (iters + 1)) {
+        lock_in(key, state, param.comm, lock);
+    }
+
+    if (state.is_locked) {
+        if (state.algo) {
+            param.hint_algo.value = state.algo;
+            selector_param.hint_algo = param.hint_algo;
+        }
+        return false;
+    }
+
+    /* every rank submits the same sequence of ops, so the round-robin order matches */
+    size_t round = state.call_idx / algo_count;
+    param.hint_algo.value = state.algos[state.call_idx % algo_count];
+    selector_param.hint_algo = param.hint_algo;
+    state.call_idx++;
+
+    /* cached sched would keep the algorithm it was built with */
+    attr.to_cache = 0;
+
+    /* the first round warms up the algorithms and is not timed */
+    return (round > 0);
+}
+
+void ccl_adaptive_selector::update(const ccl_coll_param& param, long double time_usec) {
+    auto key = get_key(param);
+
+    std::lock_guard<lock_t> lock{ guard };
+
+    auto it = states.find(key);
+    if (it == states.end() || it->second.is_locked) {
+        return;
+    }
+
+    state_t& state = it->second;
+    for (size_t idx = 0; idx < state.algos.size(); idx++) {
+        if (state.algos[idx] == param.hint_algo.value) {
+            state.time_usec[idx] += time_usec;
+            state.samples[idx]++;
+            break;
+        }
+    }
+}
+
+void ccl_adaptive_selector::lock_in(const key_t& key,
+                                    state_t& state,
+                                    ccl_comm* comm,
+                                    std::unique_lock<lock_t>& lock) {
+    size_t algo_count = state.algos.size();
+
+    /* time sums followed by sample counts */
+    std::vector<double> data(2 * algo_count);
+    for (size_t idx = 0; idx < algo_count; idx++) {
+        data[idx] = static_cast<double>(state.time_usec[idx]);
+        data[algo_count + idx] = static_cast<double>(state.samples[idx]);
+    }
+
+    /* the worker reports timings under the same lock, so release it while waiting */
+    lock.unlock();
+
+    is_agreement_active = true;
+    ccl_coll_attr attr{};
+    ccl_request* req = ccl_allreduce_impl(data.data(),
+                                          data.data(),
+                                          data.size(),
+                                          ccl::datatype::float64,
+                                          ccl::reduction::sum,
+                                          attr,
+                                          comm,
+                                          nullptr,
+                                          {});
+    is_agreement_active = false;
+    ccl_wait_impl(ccl::global_data::get().executor.get(), req);
+
+    lock.lock();
+
+    /* identical sums on all ranks, so the winner is identical too */
+    size_t best_idx = 0;
+    double best_time = 0;
+    for (size_t idx = 0; idx < algo_count; idx++) {
+        if (data[algo_count + idx] == 0) {
+            continue;
+        }
+        double time = data[idx] / data[algo_count + idx];
+        if (best_time == 0 || time < best_time) {
+            best_idx = idx;
+            best_time = time;
+        }
+    }
+
+    state.algo = state.algos[best_idx];
+    state.algo_name = state.algo_names[best_idx];
+    state.is_locked = true;
+
+    LOG_INFO("adaptive selection: coll ",
+             ccl_coll_type_to_str(static_cast<ccl_coll_type>(std::get<0>(key))),
+             ", dtype ",
+             ccl::global_data::get().dtypes->name(static_cast<ccl::datatype>(std::get<1>(key))),
+             ", bytes 2^",
+             std::get<2>(key),
+             ", comm ",
+             std::get<3>(key),
+             ", algo ",
+             state.algo_name,
+             ", avg time ",
+             best_time,
+             " usec");
+}
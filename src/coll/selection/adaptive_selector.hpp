@@ -0,0 +1,84 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "coll/coll_param.hpp"
+#include "coll/selection/selector.hpp"
+#include "common/utils/spinlock.hpp"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*
+   online algorithm selection: for each (coll, dtype, size bucket, comm)
+   the candidate algorithms are executed round-robin for a number of rounds,
+   completion times of the master scheds are accumulated and then summed
+   over all ranks of the comm, so every rank locks in the same winner
+*/
+class ccl_adaptive_selector {
+public:
+    explicit ccl_adaptive_selector(size_t iters);
+
+    ccl_adaptive_selector(const ccl_adaptive_selector& other) = delete;
+    ccl_adaptive_selector& operator=(const ccl_adaptive_selector& other) = delete;
+
+    /* sets hint algo for the operation, returns true if its execution should be timed */
+    bool select(ccl_coll_param& param, ccl_selector_param& selector_param, ccl_coll_attr& attr);
+
+    /* reports completion time of the timed operation */
+    void update(const ccl_coll_param& param, long double time_usec);
+
+private:
+    /* ctype, dtype, log2 of size in bytes, comm id, comm size */
+    using key_t = std::tuple<int, int, int, int, int>;
+
+    struct state_t {
+        /* candidate algorithms, empty if there is nothing to choose from */
+        std::vector<int> algos{};
+        std::vector<std::string> algo_names{};
+        std::vector<long double> time_usec{};
+        std::vector<size_t> samples{};
+        /* operations submitted while exploring */
+        size_t call_idx = 0;
+        int algo = 0;
+        std::string algo_name{};
+        bool is_locked = false;
+    };
+
+    static key_t get_key(const ccl_coll_param& param);
+    static void get_candidates(ccl_selector_param selector_param,
+                               std::vector<int>& algos,
+                               std::vector<std::string>& names);
+
+    using lock_t = ccl_spinlock;
+
+    void lock_in(const key_t& key,
+                 state_t& state,
+                 ccl_comm* comm,
+                 std::unique_lock<lock_t>& lock);
+
+    const size_t iters;
+
+    lock_t guard{};
+
+    std::map<key_t, state_t> states{};
+
+    /* set while the internal allreduce which agrees on the winner is being created */
+    static thread_local bool is_agreement_active;
+};
@@ -19,6 +19,9 @@
 #include "comm/comm.hpp"
 #include "common/global/global.hpp"
 
+#include <algorithm>
+#include <fstream>
+
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 #include "common/utils/sycl_utils.hpp"
 #include "sched/entry/ze/ze_primitives.hpp"
@@ -66,6 +69,88 @@ std::string to_string(const ccl_selector_param& param) {
     return ss.str();
 }
 
+std::string ccl_tuning_env_name(ccl_coll_type ctype) {
+    std::string name = std::string("CCL_") + ccl_coll_type_to_str(ctype);
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    return name;
+}
+
+static int ccl_parse_tuning_key_value(const std::string& str,
+                                      const std::string& path,
+                                      size_t line_idx) {
+    if (str == "*") {
+        return 0;
+    }
+    char* end = nullptr;
+    long value = std::strtol(str.c_str(), &end, 10);
+    CCL_THROW_IF_NOT(!str.empty() && *end == '\0' && value > 0,
+                     "tuning file ",
+                     path,
+                     ", line ",
+                     line_idx,
+                     ": unexpected comm_size or ranks_per_node value '",
+                     str,
+                     "'");
+    return static_cast<int>(value);
+}
+
+ccl_tuning_entries_t ccl_load_tuning_file(const std::string& path) {
+    /* format: <comm_size|*> <ranks_per_node|*> CCL_<COLL>=<selection string>, # for comments */
+    std::ifstream file(path);
+    CCL_THROW_IF_NOT(file.is_open(), "can not open tuning file ", path);
+
+    std::set<std::string> env_names;
+    for (auto ctype : { CCL_COLL_LIST }) {
+        env_names.insert(ccl_tuning_env_name(ctype));
+    }
+
+    ccl_tuning_entries_t entries;
+    std::string line;
+    size_t line_idx = 0;
+    while (std::getline(file, line)) {
+        line_idx++;
+        line = line.substr(0, line.find('#'));
+
+        std::stringstream line_stream(line);
+        std::string comm_size_str, ppn_str, selection_str, extra_str;
+        if (!(line_stream >> comm_size_str)) {
+            continue;
+        }
+        CCL_THROW_IF_NOT((line_stream >> ppn_str >> selection_str) && !(line_stream >> extra_str),
+                         "tuning file ",
+                         path,
+                         ", line ",
+                         line_idx,
+                         ": expected '<comm_size> <ranks_per_node> CCL_<COLL>=<algos>'");
+
+        size_t delim_pos = selection_str.find('=');
+        std::string env_name = selection_str.substr(0, delim_pos);
+        CCL_THROW_IF_NOT(delim_pos != std::string::npos && delim_pos + 1 < selection_str.size() &&
+                             env_names.count(env_name),
+                         "tuning file ",
+                         path,
+                         ", line ",
+                         line_idx,
+                         ": unexpected selection '",
+                         selection_str,
+                         "'");
+
+        ccl_tuning_key_t key{ ccl_parse_tuning_key_value(comm_size_str, path, line_idx),
+                              ccl_parse_tuning_key_value(ppn_str, path, line_idx) };
+        entries[env_name][key] = selection_str.substr(delim_pos + 1);
+    }
+
+    LOG_DEBUG("loaded tuning file ", path, ", colls ", entries.size());
+    return entries;
+}
+
+ccl_tuning_key_t ccl_get_tuning_key(const ccl_selector_param& param) {
+    // ranks_per_node is a part of the key only if it is the same on all nodes
+    int ppn = param.comm->get_topo_manager().has_same_ppn() ? param.comm->get_node_comm()->size()
+                                                            : -1;
+    return { param.comm->size(), ppn };
+}
+
 bool ccl_is_direct_algo(const ccl_selector_param& param) {
     bool res = false;
 
@@ -111,6 +196,33 @@ bool ccl_is_direct_algo(const ccl_selector_param& param) {
     return res;
 }
 
+bool ccl_is_shm_algo(const ccl_selector_param& param) {
+    bool res = false;
+
+    auto& selector = ccl::global_data::get().algorithm_selector;
+
+    if (param.ctype == ccl_coll_allgatherv) {
+        res = (selector->get<ccl_coll_allgatherv>(param) == ccl_coll_allgatherv_shm);
+    }
+    else if (param.ctype == ccl_coll_allreduce) {
+        auto algo = selector->get<ccl_coll_allreduce>(param);
+        // hier algo puts shm entries of node_comm into the schedule when the segment exists
+        res = (algo == ccl_coll_allreduce_shm) ||
+              (algo == ccl_coll_allreduce_hier && param.comm->get_node_comm()->get_shm_coll_ctx());
+    }
+    else if (param.ctype == ccl_coll_barrier) {
+        res = (selector->get<ccl_coll_barrier>(param) == ccl_coll_barrier_shm);
+    }
+    else if (param.ctype == ccl_coll_bcast) {
+        res = (selector->get<ccl_coll_bcast>(param) == ccl_coll_bcast_shm);
+    }
+    else if (param.ctype == ccl_coll_reduce_scatter) {
+        res = (selector->get<ccl_coll_reduce_scatter>(param) == ccl_coll_reduce_scatter_shm);
+    }
+
+    return res;
+}
+
 bool ccl_is_offload_pt2pt_algo(const ccl_selector_param& param) {
     bool res = false;
 
@@ -290,6 +402,79 @@ bool ccl_is_device_side_algo(const ccl_selector_param& param) {
     return ccl_is_device_side_algo(algo, param);
 }
 
+bool ccl_can_use_shm_algo(const ccl_selector_param& param) {
+    auto supported_colls = { ccl_coll_allgatherv,
+                             ccl_coll_allreduce,
+                             ccl_coll_barrier,
+                             ccl_coll_bcast,
+                             ccl_coll_reduce_scatter };
+    RETURN_FALSE_IF(!checkers::is_coll_supported(supported_colls, param.ctype),
+                    "coll is not supported");
+
+    const ccl_shm_coll_ctx* ctx = param.comm->get_shm_coll_ctx();
+    RETURN_FALSE_IF(!ctx, "no shm segment for comm ", param.comm->id());
+
+    RETURN_FALSE_IF(checkers::is_sycl_buf(param), "sycl buffer is not supported");
+    RETURN_FALSE_IF(checkers::is_gpu_stream(param), "gpu stream is not supported");
+    RETURN_FALSE_IF(param.is_vector_buf, "vector buffer is not supported");
+    RETURN_FALSE_IF(ccl::global_data::env().enable_unordered_coll,
+                    "unordered coll is not supported");
+    // fused schedules are started out of posting order
+    RETURN_FALSE_IF(ccl::global_data::env().enable_fusion, "fusion is not supported");
+
+    size_t dtype_size = param.dtype.size();
+    size_t bytes = param.count * dtype_size;
+    size_t step_bytes = ctx->get_chunk_size();
+    if (param.ctype == ccl_coll_allgatherv && param.recv_counts) {
+        bytes = *std::max_element(param.recv_counts, param.recv_counts + param.comm->size()) *
+                dtype_size;
+    }
+    else if (param.ctype == ccl_coll_reduce_scatter) {
+        // every step carries a part for each rank
+        step_bytes = step_bytes / (param.comm->size() * dtype_size) * dtype_size;
+        RETURN_FALSE_IF(!step_bytes, "too many ranks for shm chunk size");
+    }
+    // allreduce needs two steps per chunk and the step index has to fit into the flag
+    RETURN_FALSE_IF(bytes / step_bytes >= (ccl_shm_coll_ctx::done_step >> 2),
+                    "message is too large");
+
+    return true;
+}
+
+bool ccl_can_use_hier_algo(const ccl_selector_param& param) {
+    RETURN_FALSE_IF(param.ctype != ccl_coll_allreduce && param.ctype != ccl_coll_alltoallv &&
+                        param.ctype != ccl_coll_barrier,
+                    "coll is not supported");
+    RETURN_FALSE_IF(checkers::is_sycl_buf(param), "sycl buffer is not supported");
+    RETURN_FALSE_IF(checkers::is_gpu_stream(param), "gpu stream is not supported");
+    RETURN_FALSE_IF(param.is_vector_buf, "vector buffer is not supported");
+
+    if (param.ctype == ccl_coll_barrier) {
+        // barrier works with any ppn and on a single node,
+        // its node phase goes through shm and keeps the posting order
+        // sub-communicators return node comm and topology of the parent
+        RETURN_FALSE_IF(param.comm->get_parent_comm(), "sub-communicator is not supported");
+        RETURN_FALSE_IF(!param.comm->get_topo_manager().get_host_count(), "no host info");
+        RETURN_FALSE_IF(ccl::global_data::env().enable_unordered_coll,
+                        "unordered coll is not supported");
+        return true;
+    }
+
+    // node_comm and r2r_comm have to form a grid over the comm,
+    // with different ppn the checks below would differ between ranks
+    RETURN_FALSE_IF(!param.comm->get_topo_manager().has_same_ppn(),
+                    "ppn is not the same among the nodes");
+
+    int node_size = param.comm->get_node_comm()->size();
+    int r2r_size = param.comm->get_r2r_comm()->size();
+    RETURN_FALSE_IF(node_size < 2, "single rank per node");
+    RETURN_FALSE_IF(r2r_size < 2, "single node");
+    RETURN_FALSE_IF(node_size * r2r_size != param.comm->size(),
+                    "comm is not covered by node and r2r comms");
+
+    return true;
+}
+
 bool ccl_can_use_topo_algo(const ccl_selector_param& param) {
 #ifdef CCL_ENABLE_SYCL
     RETURN_FALSE_IF(!param.comm->get_env()->get_enable_topo_algo(), "topo algo is disabled");
@@ -522,6 +707,54 @@ bool ccl_can_use_datatype(ccl_coll_algo algo, const ccl_selector_param& param) {
     return can_use;
 }
 
+bool ccl_can_use_reduction(ccl_coll_algo algo, const ccl_selector_param& param) {
+    if (param.reduction != ccl::reduction::avg) {
+        return true;
+    }
+
+    // avg is divided within the last reduction step of host algorithms,
+    // the rest rely on transport or device reductions which don't support it
+    bool can_use = false;
+    switch (param.ctype) {
+        case ccl_coll_allreduce:
+            can_use = (algo.allreduce == ccl_coll_allreduce_rabenseifner ||
+                       algo.allreduce == ccl_coll_allreduce_nreduce ||
+                       algo.allreduce == ccl_coll_allreduce_ring ||
+                       algo.allreduce == ccl_coll_allreduce_double_tree ||
+                       algo.allreduce == ccl_coll_allreduce_recursive_doubling);
+            break;
+        case ccl_coll_reduce:
+            can_use = (algo.reduce == ccl_coll_reduce_rabenseifner ||
+                       algo.reduce == ccl_coll_reduce_ring || algo.reduce == ccl_coll_reduce_tree ||
+                       algo.reduce == ccl_coll_reduce_double_tree);
+            break;
+        case ccl_coll_reduce_scatter:
+            can_use = (algo.reduce_scatter == ccl_coll_reduce_scatter_naive ||
+                       algo.reduce_scatter == ccl_coll_reduce_scatter_ring);
+            break;
+        default: break;
+    }
+
+    if (!can_use) {
+        LOG_DEBUG("avg reduction is not supported by requested ",
+                  ccl_coll_type_to_str(param.ctype),
+                  " algorithm");
+    }
+
+    return can_use;
+}
+
+bool ccl_can_use_pairwise_alltoall(const ccl_selector_param& param, const std::string& algo_raw) {
+    // explicit selection is always respected
+    if (!algo_raw.empty() || !ccl::global_data::env().tuning_file.empty()) {
+        return true;
+    }
+
+    // by default scatter is kept on small comms, there are few messages in flight anyway
+    return static_cast<size_t>(param.comm->size()) >=
+           ccl::global_data::env().alltoall_pairwise_min_comm_size;
+}
+
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 void set_offload_pt2pt_mpi_env() {
     auto lib_attr = atl_mpi_ctx::get_lib_attr();
@@ -20,10 +20,15 @@
 bool ccl_is_direct_algo(const ccl_selector_param& param);
 bool ccl_is_device_side_algo(const ccl_selector_param& param);
 bool ccl_is_offload_pt2pt_algo(const ccl_selector_param& param);
+bool ccl_is_shm_algo(const ccl_selector_param& param);
 
 bool ccl_can_use_topo_algo(const ccl_selector_param& param);
+bool ccl_can_use_shm_algo(const ccl_selector_param& param);
+bool ccl_can_use_hier_algo(const ccl_selector_param& param);
 
 bool ccl_can_use_datatype(ccl_coll_algo algo, const ccl_selector_param& param);
+bool ccl_can_use_reduction(ccl_coll_algo algo, const ccl_selector_param& param);
+bool ccl_can_use_pairwise_alltoall(const ccl_selector_param& param, const std::string& algo_raw);
 
 // utils
 // pt2pt: send or recv is considered like a unique "collective"
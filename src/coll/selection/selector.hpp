@@ -26,6 +26,7 @@
 #define CCL_ALLGATHERV_SHORT_MSG_SIZE 32768
 #define CCL_ALLREDUCE_SHORT_MSG_SIZE  8192
 #define CCL_ALLREDUCE_MEDIUM_MSG_SIZE (1024 * 1024)
+#define CCL_ALLTOALL_SHORT_MSG_SIZE   256
 #define CCL_ALLTOALL_MEDIUM_MSG_SIZE  (1024 * 1024)
 #define CCL_BCAST_SHORT_MSG_SIZE      8192
 #define CCL_REDUCE_SHORT_MSG_SIZE     8192
@@ -88,6 +89,15 @@ struct ccl_selector_param {
     }
 };
 
+// <comm_size, ranks_per_node>, 0 matches any value
+using ccl_tuning_key_t = std::pair<int, int>;
+// selection strings of the tuning file: env name (e.g. CCL_ALLREDUCE) -> key -> string
+using ccl_tuning_entries_t = std::map<std::string, std::map<ccl_tuning_key_t, std::string>>;
+
+ccl_tuning_entries_t ccl_load_tuning_file(const std::string& path);
+std::string ccl_tuning_env_name(ccl_coll_type ctype);
+ccl_tuning_key_t ccl_get_tuning_key(const ccl_selector_param& param);
+
 template <ccl_coll_type coll_id>
 struct ccl_algorithm_selector;
 
@@ -99,8 +109,12 @@ struct ccl_algorithm_selector_base {
     ccl_selection_table_t<algo_group_type> main_table;
     ccl_selection_table_t<algo_group_type> fallback_table;
     ccl_selection_table_t<algo_group_type> scaleout_table;
-    void init();
+    // main tables from the tuning file, replace main_table for the matching comms
+    std::map<ccl_tuning_key_t, ccl_selection_table_t<algo_group_type>> tuned_tables;
+    void init(const ccl_tuning_entries_t& tuning_entries);
     void print() const;
+    const ccl_selection_table_t<algo_group_type>& get_main_table(
+        const ccl_selector_param& param) const;
     algo_group_type get(const ccl_selector_param& param) const;
     static void insert(ccl_selection_table_t<algo_group_type>& table,
                        size_t left,
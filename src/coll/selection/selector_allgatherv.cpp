@@ -25,6 +25,7 @@ std::map<ccl_coll_allgatherv_algo, std::string>
         std::make_pair(ccl_coll_allgatherv_ring, "ring"),
         std::make_pair(ccl_coll_allgatherv_flat, "flat"),
         std::make_pair(ccl_coll_allgatherv_multi_bcast, "multi_bcast"),
+        std::make_pair(ccl_coll_allgatherv_shm, "shm"),
 #ifdef CCL_ENABLE_SYCL
         std::make_pair(ccl_coll_allgatherv_topo, "topo")
 #endif // CCL_ENABLE_SYCL
@@ -44,6 +45,9 @@ ccl_algorithm_selector<ccl_coll_allgatherv>::ccl_algorithm_selector() {
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allgatherv_direct);
     }
+    if (ccl::global_data::env().enable_shm_coll) {
+        insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allgatherv_shm);
+    }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
     insert(scaleout_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allgatherv_ring);
     insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allgatherv_flat);
@@ -59,6 +63,9 @@ bool ccl_algorithm_selector_helper<ccl_coll_allgatherv_algo>::can_use(
     if (algo == ccl_coll_allgatherv_topo && !ccl_can_use_topo_algo(param)) {
         can_use = false;
     }
+    else if (algo == ccl_coll_allgatherv_shm && !ccl_can_use_shm_algo(param)) {
+        can_use = false;
+    }
     else if (param.is_vector_buf && algo != ccl_coll_allgatherv_flat &&
              algo != ccl_coll_allgatherv_multi_bcast && algo != ccl_coll_allgatherv_topo) {
         can_use = false;
@@ -26,6 +26,8 @@ std::map<ccl_coll_allreduce_algo, std::string>
         std::make_pair(ccl_coll_allreduce_double_tree, "double_tree"),
         std::make_pair(ccl_coll_allreduce_recursive_doubling, "recursive_doubling"),
         std::make_pair(ccl_coll_allreduce_2d, "2d"),
+        std::make_pair(ccl_coll_allreduce_shm, "shm"),
+        std::make_pair(ccl_coll_allreduce_hier, "hier"),
 #ifdef CCL_ENABLE_SYCL
         std::make_pair(ccl_coll_allreduce_topo, "topo"),
 #endif // CCL_ENABLE_SYCL
@@ -51,12 +53,24 @@ ccl_algorithm_selector<ccl_coll_allreduce>::ccl_algorithm_selector() {
                CCL_ALLREDUCE_SHORT_MSG_SIZE + 1,
                CCL_ALLREDUCE_MEDIUM_MSG_SIZE,
                ccl_coll_allreduce_nreduce);
+        insert(main_table,
+               CCL_ALLREDUCE_MEDIUM_MSG_SIZE + 1,
+               CCL_SELECTION_MAX_COLL_SIZE,
+               ccl_coll_allreduce_hier);
     }
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_direct);
     }
+    if (ccl::global_data::env().enable_shm_coll) {
+        insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_shm);
+    }
     insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_ring);
     insert(fallback_table, 0, CCL_ALLREDUCE_SHORT_MSG_SIZE, ccl_coll_allreduce_recursive_doubling);
+    // nreduce is not used on large comms, medium messages go to double_tree
+    insert(fallback_table,
+           CCL_ALLREDUCE_SHORT_MSG_SIZE + 1,
+           CCL_ALLREDUCE_MEDIUM_MSG_SIZE,
+           ccl_coll_allreduce_double_tree);
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
     insert(scaleout_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_ring);
 }
@@ -70,7 +84,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_allreduce_algo>::can_use(
 
     ccl_coll_algo algo_param;
     algo_param.allreduce = algo;
-    can_use = ccl_can_use_datatype(algo_param, param);
+    can_use = ccl_can_use_datatype(algo_param, param) && ccl_can_use_reduction(algo_param, param);
 
     if (algo == ccl_coll_allreduce_rabenseifner &&
         static_cast<int>(param.count) < param.comm->pof2())
@@ -79,11 +93,20 @@ bool ccl_algorithm_selector_helper<ccl_coll_allreduce_algo>::can_use(
         can_use = false;
     else if (algo == ccl_coll_allreduce_nreduce && !(param.count / param.comm->size()))
         can_use = false;
+    else if (algo == ccl_coll_allreduce_nreduce &&
+             static_cast<size_t>(param.comm->size()) >=
+                 ccl::global_data::env().allreduce_dtree_min_comm_size)
+        // log(p) steps of double_tree are preferred over p steps of nreduce on large comms
+        can_use = false;
     else if (algo == ccl_coll_allreduce_direct &&
              (ccl::global_data::env().atl_transport == ccl_atl_ofi))
         can_use = false;
     else if (algo == ccl_coll_allreduce_topo && !ccl_can_use_topo_algo(param))
         can_use = false;
+    else if (algo == ccl_coll_allreduce_shm && !ccl_can_use_shm_algo(param))
+        can_use = false;
+    else if (algo == ccl_coll_allreduce_hier && !ccl_can_use_hier_algo(param))
+        can_use = false;
     else if (algo == ccl_coll_allreduce_2d && param.is_scaleout)
         // MLSL-1762: scale-up topo + scale-out 2d combination fails.
         // Algorithms are not compatible.
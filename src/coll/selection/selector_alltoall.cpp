@@ -21,6 +21,8 @@ std::map<ccl_coll_alltoall_algo, std::string>
         std::make_pair(ccl_coll_alltoall_direct, "direct"),
         std::make_pair(ccl_coll_alltoall_naive, "naive"),
         std::make_pair(ccl_coll_alltoall_scatter, "scatter"),
+        std::make_pair(ccl_coll_alltoall_pairwise, "pairwise"),
+        std::make_pair(ccl_coll_alltoall_bruck, "bruck"),
 #ifdef CCL_ENABLE_SYCL
         std::make_pair(ccl_coll_alltoall_topo, "topo")
 #endif // CCL_ENABLE_SYCL
@@ -31,6 +33,12 @@ ccl_algorithm_selector<ccl_coll_alltoall>::ccl_algorithm_selector() {
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoall_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoall_scatter);
+    // large comms only, see can_use
+    insert(main_table, 0, CCL_ALLTOALL_SHORT_MSG_SIZE, ccl_coll_alltoall_bruck);
+    insert(main_table,
+           CCL_ALLTOALL_SHORT_MSG_SIZE + 1,
+           CCL_SELECTION_MAX_COLL_SIZE,
+           ccl_coll_alltoall_pairwise);
     if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
         insert(main_table, 0, CCL_ALLTOALL_MEDIUM_MSG_SIZE, ccl_coll_alltoall_direct);
     }
@@ -50,7 +58,12 @@ bool ccl_algorithm_selector_helper<ccl_coll_alltoall_algo>::can_use(
         can_use = false;
     }
     else if (param.is_vector_buf && algo != ccl_coll_alltoall_scatter &&
-             algo != ccl_coll_alltoall_naive && algo != ccl_coll_alltoall_topo) {
+             algo != ccl_coll_alltoall_naive && algo != ccl_coll_alltoall_pairwise &&
+             algo != ccl_coll_alltoall_bruck && algo != ccl_coll_alltoall_topo) {
+        can_use = false;
+    }
+    else if ((algo == ccl_coll_alltoall_pairwise || algo == ccl_coll_alltoall_bruck) &&
+             !ccl_can_use_pairwise_alltoall(param, ccl::global_data::env().alltoall_algo_raw)) {
         can_use = false;
     }
     else if (algo == ccl_coll_alltoall_direct &&
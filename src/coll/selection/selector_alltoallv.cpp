@@ -21,6 +21,8 @@ std::map<ccl_coll_alltoallv_algo, std::string>
         std::make_pair(ccl_coll_alltoallv_direct, "direct"),
         std::make_pair(ccl_coll_alltoallv_naive, "naive"),
         std::make_pair(ccl_coll_alltoallv_scatter, "scatter"),
+        std::make_pair(ccl_coll_alltoallv_pairwise, "pairwise"),
+        std::make_pair(ccl_coll_alltoallv_hier, "hier"),
 #ifdef CCL_ENABLE_SYCL
         std::make_pair(ccl_coll_alltoallv_topo, "topo")
 #endif // CCL_ENABLE_SYCL
@@ -31,6 +33,8 @@ ccl_algorithm_selector<ccl_coll_alltoallv>::ccl_algorithm_selector() {
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoallv_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoallv_scatter);
+    // large comms only, see can_use
+    insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoallv_pairwise);
     if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
         insert(main_table, 0, CCL_ALLTOALL_MEDIUM_MSG_SIZE, ccl_coll_alltoallv_direct);
     }
@@ -50,7 +54,15 @@ bool ccl_algorithm_selector_helper<ccl_coll_alltoallv_algo>::can_use(
         can_use = false;
     }
     else if (param.is_vector_buf && algo != ccl_coll_alltoallv_scatter &&
-             algo != ccl_coll_alltoallv_naive && algo != ccl_coll_alltoallv_topo) {
+             algo != ccl_coll_alltoallv_naive && algo != ccl_coll_alltoallv_pairwise &&
+             algo != ccl_coll_alltoallv_topo) {
+        can_use = false;
+    }
+    else if (algo == ccl_coll_alltoallv_pairwise &&
+             !ccl_can_use_pairwise_alltoall(param, ccl::global_data::env().alltoallv_algo_raw)) {
+        can_use = false;
+    }
+    else if (algo == ccl_coll_alltoallv_hier && !ccl_can_use_hier_algo(param)) {
         can_use = false;
     }
     else if (algo == ccl_coll_alltoallv_direct &&
@@ -19,7 +19,9 @@ template <>
 std::map<ccl_coll_barrier_algo, std::string>
     ccl_algorithm_selector_helper<ccl_coll_barrier_algo>::algo_names = {
         std::make_pair(ccl_coll_barrier_direct, "direct"),
-        std::make_pair(ccl_coll_barrier_ring, "ring")
+        std::make_pair(ccl_coll_barrier_ring, "ring"),
+        std::make_pair(ccl_coll_barrier_shm, "shm"),
+        std::make_pair(ccl_coll_barrier_hier, "hier")
     };
 
 ccl_algorithm_selector<ccl_coll_barrier>::ccl_algorithm_selector() {
@@ -28,6 +30,8 @@ ccl_algorithm_selector<ccl_coll_barrier>::ccl_algorithm_selector() {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_barrier_ring);
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi)
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_barrier_direct);
+    if (ccl::global_data::env().enable_shm_coll)
+        insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_barrier_hier);
     insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_barrier_ring);
 
     // barrier currently does not support scale-out selection, but the table
@@ -44,6 +48,10 @@ bool ccl_algorithm_selector_helper<ccl_coll_barrier_algo>::can_use(
 
     if (algo == ccl_coll_barrier_direct && (ccl::global_data::env().atl_transport == ccl_atl_ofi))
         can_use = false;
+    else if (algo == ccl_coll_barrier_shm && !ccl_can_use_shm_algo(param))
+        can_use = false;
+    else if (algo == ccl_coll_barrier_hier && !ccl_can_use_hier_algo(param))
+        can_use = false;
 
     return can_use;
 }
@@ -22,6 +22,7 @@ std::map<ccl_coll_bcast_algo, std::string>
         std::make_pair(ccl_coll_bcast_ring, "ring"),
         std::make_pair(ccl_coll_bcast_double_tree, "double_tree"),
         std::make_pair(ccl_coll_bcast_naive, "naive"),
+        std::make_pair(ccl_coll_bcast_shm, "shm"),
 #ifdef CCL_ENABLE_SYCL
         std::make_pair(ccl_coll_bcast_topo, "topo")
 #endif // CCL_ENABLE_SYCL
@@ -38,6 +39,9 @@ ccl_algorithm_selector<ccl_coll_bcast>::ccl_algorithm_selector() {
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_bcast_direct);
     }
+    if (ccl::global_data::env().enable_shm_coll) {
+        insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_bcast_shm);
+    }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
 
     insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_bcast_naive);
@@ -69,6 +73,9 @@ bool ccl_algorithm_selector_helper<ccl_coll_bcast_algo>::can_use(
     else if (algo == ccl_coll_bcast_topo && !ccl_can_use_topo_algo(param)) {
         can_use = false;
     }
+    else if (algo == ccl_coll_bcast_shm && !ccl_can_use_shm_algo(param)) {
+        can_use = false;
+    }
 
     return can_use;
 }
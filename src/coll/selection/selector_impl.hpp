@@ -150,7 +150,8 @@ void fill_table_from_str(const std::string& str_to_parse,
 }
 
 template <typename algo_group_type>
-void ccl_algorithm_selector_base<algo_group_type>::init() {
+void ccl_algorithm_selector_base<algo_group_type>::init(
+    const ccl_tuning_entries_t& tuning_entries) {
     const std::string& main_str_to_parse =
         ccl_algorithm_selector_helper<algo_group_type>::get_main_str_to_parse();
     const std::string& scaleout_str_to_parse =
@@ -160,12 +161,27 @@ void ccl_algorithm_selector_base<algo_group_type>::init() {
     algo_group_type elem_algo;
     ccl_selection_border_type elem_border;
 
+    // tuned tables start from the built-in defaults, explicit env strings still win
+    auto tuning_it = tuning_entries.find(
+        ccl_tuning_env_name(ccl_algorithm_selector_helper<algo_group_type>::get_coll_id()));
+    if (tuning_it != tuning_entries.end()) {
+        for (const auto& entry : tuning_it->second) {
+            auto table = main_table;
+            fill_table_from_str<algo_group_type>(entry.second, table);
+            fill_table_from_str<algo_group_type>(main_str_to_parse, table);
+            tuned_tables[entry.first] = std::move(table);
+        }
+    }
+
     fill_table_from_str<algo_group_type>(main_str_to_parse, main_table);
     fill_table_from_str<algo_group_type>(scaleout_str_to_parse, scaleout_table);
 
     auto tables_to_check = std::vector<const ccl_selection_table_t<algo_group_type>*>{
         &main_table, &fallback_table, &scaleout_table
     };
+    for (const auto& tuned_table : tuned_tables) {
+        tables_to_check.push_back(&tuned_table.second);
+    }
 
     for (const auto& table : tables_to_check) {
         CCL_THROW_IF_NOT(table->size() >= 2, "selection table should have at least 2 entries");
@@ -223,6 +239,11 @@ void ccl_algorithm_selector_base<algo_group_type>::print() const {
         str << "  " << table_name << std::endl;
         str << ccl_algorithm_selector_base<algo_group_type>::table_to_str(*table);
     }
+    for (const auto& tuned_table : tuned_tables) {
+        str << "  tuned table: comm_size " << tuned_table.first.first << ", ranks_per_node "
+            << tuned_table.first.second << std::endl;
+        str << ccl_algorithm_selector_base<algo_group_type>::table_to_str(tuned_table.second);
+    }
     LOG_DEBUG(str.str());
 }
 
@@ -283,6 +304,26 @@ algo_group_type ccl_algorithm_selector_base<algo_group_type>::get_value_from_tab
     return elem_algo;
 }
 
+template <typename algo_group_type>
+const ccl_selection_table_t<algo_group_type>& ccl_algorithm_selector_base<
+    algo_group_type>::get_main_table(const ccl_selector_param& param) const {
+    if (tuned_tables.empty() || !param.comm) {
+        return main_table;
+    }
+
+    ccl_tuning_key_t comm_key = ccl_get_tuning_key(param);
+    for (const auto& key : { comm_key,
+                             ccl_tuning_key_t{ comm_key.first, 0 },
+                             ccl_tuning_key_t{ 0, comm_key.second },
+                             ccl_tuning_key_t{ 0, 0 } }) {
+        auto it = tuned_tables.find(key);
+        if (it != tuned_tables.end()) {
+            return it->second;
+        }
+    }
+    return main_table;
+}
+
 template <typename algo_group_type>
 algo_group_type ccl_algorithm_selector_base<algo_group_type>::get(
     const ccl_selector_param& param) const {
@@ -337,11 +378,12 @@ algo_group_type ccl_algorithm_selector_base<algo_group_type>::get(
         }
     }
 
-    auto lower_bound = main_table.lower_bound(size);
-    ccl_selection_unpack_elem(elem_size, elem_algo, elem_border, lower_bound, main_table);
+    const auto& table = get_main_table(param);
+    auto lower_bound = table.lower_bound(size);
+    ccl_selection_unpack_elem(elem_size, elem_algo, elem_border, lower_bound, table);
 
-    if (lower_bound == main_table.end() ||
-        !ccl_algorithm_selector_helper<algo_group_type>::can_use(elem_algo, param, main_table)) {
+    if (lower_bound == table.end() ||
+        !ccl_algorithm_selector_helper<algo_group_type>::can_use(elem_algo, param, table)) {
         CCL_THROW_IF_NOT(ccl::global_data::env().enable_algo_fallback,
                          "can not select algo from main table and fallback is disabled",
                          ", coll ",
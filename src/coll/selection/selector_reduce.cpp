@@ -52,7 +52,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_reduce_algo>::can_use(
 
     ccl_coll_algo algo_param;
     algo_param.reduce = algo;
-    can_use = ccl_can_use_datatype(algo_param, param);
+    can_use = ccl_can_use_datatype(algo_param, param) && ccl_can_use_reduction(algo_param, param);
 
     if (algo == ccl_coll_reduce_rabenseifner && (int)param.count < param.comm->pof2())
         can_use = false;
@@ -21,6 +21,7 @@ std::map<ccl_coll_reduce_scatter_algo, std::string>
         std::make_pair(ccl_coll_reduce_scatter_direct, "direct"),
         std::make_pair(ccl_coll_reduce_scatter_naive, "naive"),
         std::make_pair(ccl_coll_reduce_scatter_ring, "ring"),
+        std::make_pair(ccl_coll_reduce_scatter_shm, "shm"),
 #ifdef CCL_ENABLE_SYCL
         std::make_pair(ccl_coll_reduce_scatter_topo, "topo"),
 #endif // CCL_ENABLE_SYCL
@@ -36,6 +37,9 @@ ccl_algorithm_selector<ccl_coll_reduce_scatter>::ccl_algorithm_selector() {
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_reduce_scatter_direct);
     }
+    if (ccl::global_data::env().enable_shm_coll) {
+        insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_reduce_scatter_shm);
+    }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
     insert(scaleout_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_reduce_scatter_naive);
     insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_reduce_scatter_naive);
@@ -48,12 +52,18 @@ bool ccl_algorithm_selector_helper<ccl_coll_reduce_scatter_algo>::can_use(
     const ccl_selection_table_t<ccl_coll_reduce_scatter_algo>& table) {
     bool can_use = true;
 
+    ccl_coll_algo algo_param;
+    algo_param.reduce_scatter = algo;
+    can_use = ccl_can_use_reduction(algo_param, param);
+
     if (algo == ccl_coll_reduce_scatter_topo && !ccl_can_use_topo_algo(param)) {
         can_use = false;
     }
     else if (algo == ccl_coll_reduce_scatter_direct &&
              (ccl::global_data::env().atl_transport == ccl_atl_ofi))
         can_use = false;
+    else if (algo == ccl_coll_reduce_scatter_shm && !ccl_can_use_shm_algo(param))
+        can_use = false;
 
     return can_use;
 }
@@ -24,9 +24,11 @@ template <ccl_coll_type... registered_coll_id>
 class ccl_algorithm_selector_wrapper {
 public:
     struct selector_init_functor {
+        const ccl_tuning_entries_t& tuning_entries;
+
         template <typename T>
         void operator()(T& t) const {
-            t.init();
+            t.init(tuning_entries);
         }
     };
 
@@ -38,7 +40,12 @@ public:
     };
 
     void init() {
-        ccl_tuple_for_each(selectors, selector_init_functor());
+        ccl_tuning_entries_t tuning_entries;
+        const std::string& tuning_file = ccl::global_data::env().tuning_file;
+        if (!tuning_file.empty()) {
+            tuning_entries = ccl_load_tuning_file(tuning_file);
+        }
+        ccl_tuple_for_each(selectors, selector_init_functor{ tuning_entries });
     }
 
     void print() {
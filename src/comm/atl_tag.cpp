@@ -46,6 +46,11 @@ std::tuple<ccl_sched_id_t, ccl_sched_id_t> ccl_atl_tag_impl<Layout>::get_pt2pt_s
     return std::make_tuple(ack_first, ack_second);
 }
 
+template <typename Layout>
+ccl_sched_id_t ccl_atl_tag_impl<Layout>::get_barrier_sched_id() {
+    return Layout::barrier_sched_id;
+}
+
 template <typename Layout>
 uint64_t ccl_atl_tag_impl<Layout>::create(int rank,
                                           ccl_comm_id_t comm_id,
@@ -44,8 +44,10 @@ struct pt2pt_tag_layout {
     static constexpr ccl_sched_id_t pt2pt_ack_tag = pt2pt_sched_id - 1;
     static constexpr ccl_sched_id_t pt2pt_ack_first = pt2pt_sched_id - 2;
     static constexpr ccl_sched_id_t pt2pt_ack_second = pt2pt_sched_id - 3;
+    // reserved for the barrier which runs without schedule
+    static constexpr ccl_sched_id_t barrier_sched_id = pt2pt_sched_id - 4;
     // maximum value of schedule id in scope of the current communicator
-    static constexpr ccl_sched_id_t max_sched_count = pt2pt_sched_id - 4;
+    static constexpr ccl_sched_id_t max_sched_count = pt2pt_sched_id - 5;
 };
 
 /*
@@ -166,6 +168,7 @@ public:
     virtual ccl_sched_id_t get_pt2pt_sched_id() = 0;
     virtual ccl_sched_id_t get_pt2pt_ack_tag() = 0;
     virtual std::tuple<ccl_sched_id_t, ccl_sched_id_t> get_pt2pt_sync_tags() = 0;
+    virtual ccl_sched_id_t get_barrier_sched_id() = 0;
 
 protected:
     size_t tag_bits;
@@ -187,4 +190,5 @@ public:
     ccl_sched_id_t get_pt2pt_sched_id();
     ccl_sched_id_t get_pt2pt_ack_tag();
     std::tuple<ccl_sched_id_t, ccl_sched_id_t> get_pt2pt_sync_tags();
+    ccl_sched_id_t get_barrier_sched_id();
 };
@@ -145,6 +145,9 @@ void ccl_comm::init(int comm_id,
             LOG_INFO("topo_manager:", topo_manager.to_string());
         }
         create_topo_subcomms(atl_comm);
+        if (ccl::global_data::env().enable_shm_coll) {
+            init_shm_coll_ctx();
+        }
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
         // init of fd manager is based on node comm,
         // it initializes for every creation of comm in multi comms case
@@ -222,6 +225,7 @@ ccl_comm::ccl_comm(const ccl_comm& src, int comm_id)
     node_comm = src.node_comm;
     even_comm = src.even_comm;
     pair_comm = src.pair_comm;
+    shm_coll_ctx = src.shm_coll_ctx;
 }
 
 std::shared_ptr<ikvs_wrapper> ccl_comm::get_kvs_wrapper(std::shared_ptr<ccl::kvs_interface> kvs) {
@@ -271,6 +275,19 @@ void ccl_comm::create_topo_subcomms(std::shared_ptr<atl_base_comm> atl_comm) {
         topo_manager.get_inter_card_color(atl_comm->get_rank()) % topo_manager.max_ranks_per_card));
 }
 
+void ccl_comm::init_shm_coll_ctx() {
+    if (node_comm->size() < 2) {
+        return;
+    }
+
+    // the segment belongs to node_comm, the parent comm reuses it
+    // when it does not span other nodes, ranks of both comms match then
+    node_comm->shm_coll_ctx = ccl_shm_coll_ctx::create(node_comm.get());
+    if (node_comm->size() == comm_size) {
+        shm_coll_ctx = node_comm->shm_coll_ctx;
+    }
+}
+
 ccl_comm* ccl_comm::create_subcomm(int color, int key) const {
     std::shared_ptr<atl_base_comm> new_atl_comm = get_atl_comm()->comm_split(color, key);
     ccl_comm* comm = new ccl_comm(
@@ -969,6 +986,15 @@ ccl::event ccl_comm::allreduce_impl(const void* send_buf,
         send_buf, recv_buf, count, dtype, reduction, attr, this, get_stream_ptr(stream), deps);
 }
 
+ccl::persistent_request ccl_comm::allreduce_init(const void* send_buf,
+                                                 void* recv_buf,
+                                                 size_t count,
+                                                 ccl::datatype dtype,
+                                                 ccl::reduction reduction,
+                                                 const ccl::allreduce_attr& attr) {
+    return ccl_allreduce_init(send_buf, recv_buf, count, dtype, reduction, attr, this);
+}
+
 /* alltoall */
 ccl::event ccl_comm::alltoall_impl(const void* send_buf,
                                    void* recv_buf,
@@ -21,6 +21,7 @@
 #include "comm/comm_common_attr.hpp"
 #include "comm/comm_interface.hpp"
 #include "comm/atl_tag.hpp"
+#include "comm/shm_coll_ctx.hpp"
 #include "common/log/log.hpp"
 #include "common/stream/stream.hpp"
 #include "common/utils/tree.hpp"
@@ -658,6 +659,11 @@ public:
         return pair_comm;
     }
 
+    // set only for communicators whose ranks all reside on the same node
+    ccl_shm_coll_ctx* get_shm_coll_ctx() const {
+        return shm_coll_ctx.get();
+    }
+
     const ccl_rank2rank_map& get_local2global_map() const {
         return local2global_map;
     }
@@ -808,6 +814,13 @@ public:
     SYCL_COMM_INTERFACE_COLL_METHODS(DEFINITION);
 #endif // CCL_ENABLE_SYCL
 
+    ccl::persistent_request allreduce_init(const void* send_buf,
+                                           void* recv_buf,
+                                           size_t count,
+                                           ccl::datatype dtype,
+                                           ccl::reduction reduction,
+                                           const ccl::allreduce_attr& attr) override;
+
     COMM_IMPL_DECLARATION;
     COMM_IMPL_CLASS_DECLARATION
     int global_current_id = invalid_id;
@@ -831,6 +844,9 @@ private:
     std::shared_ptr<ccl_comm> even_comm;
     std::shared_ptr<ccl_comm> pair_comm;
 
+    std::shared_ptr<ccl_shm_coll_ctx> shm_coll_ctx;
+    void init_shm_coll_ctx();
+
     // these fields are duplicate with the ones in ccl_internal_comm
     // but having them here allows to get them without going
     // through the shared_ptr indirection
@@ -19,6 +19,7 @@
 #include "oneapi/ccl/type_traits.hpp"
 #include "oneapi/ccl/types_policy.hpp"
 #include "oneapi/ccl/event.hpp"
+#include "oneapi/ccl/persistent_request.hpp"
 
 #include "oneapi/ccl/comm_split_attr_ids.hpp"
 #include "oneapi/ccl/comm_split_attr_ids_traits.hpp"
@@ -122,5 +123,13 @@ struct comm_interface : public comm_selector {
 #ifdef CCL_ENABLE_SYCL
     SYCL_COMM_INTERFACE_COLL_METHODS(DECLARATION);
 #endif // CCL_ENABLE_SYCL
+
+    // persistent operations declarations
+    virtual ccl::persistent_request allreduce_init(const void* send_buf,
+                                                   void* recv_buf,
+                                                   size_t count,
+                                                   ccl::datatype dtype,
+                                                   ccl::reduction reduction,
+                                                   const allreduce_attr& attr) = 0;
 };
 } // namespace ccl
@@ -0,0 +1,179 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "comm/comm.hpp"
+#include "comm/shm_coll_ctx.hpp"
+#include "common/global/global.hpp"
+#include "common/utils/exchange_utils.hpp"
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "shm flags require plain 64-bit atomics");
+
+constexpr size_t ccl_shm_coll_ctx::slot_count;
+constexpr size_t ccl_shm_coll_ctx::buf_count;
+constexpr uint64_t ccl_shm_coll_ctx::step_bits;
+constexpr uint64_t ccl_shm_coll_ctx::done_step;
+
+namespace {
+constexpr size_t shm_coll_name_size = 64;
+constexpr size_t shm_coll_page_size = 4096;
+std::atomic<size_t> shm_coll_name_counter{ 0 };
+} // namespace
+
+ccl_shm_coll_ctx::ccl_shm_coll_ctx(int comm_rank, int comm_size, size_t chunk_size)
+        : comm_rank(comm_rank),
+          comm_size(comm_size),
+          chunk_size(chunk_size) {
+    flags_size = slot_count * comm_size * CACHELINE_SIZE;
+    flags_size = (flags_size + shm_coll_page_size - 1) / shm_coll_page_size * shm_coll_page_size;
+    total_size = flags_size + slot_count * comm_size * buf_count * chunk_size;
+}
+
+ccl_shm_coll_ctx::~ccl_shm_coll_ctx() {
+    if (base) {
+        munmap(base, total_size);
+        base = nullptr;
+    }
+}
+
+bool ccl_shm_coll_ctx::map(const std::string& shm_name, bool create) {
+    name = shm_name;
+
+    int fd = shm_open(name.c_str(), O_RDWR | (create ? (O_CREAT | O_EXCL) : 0), S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        LOG_WARN("shm_open failed for ", name, ": ", strerror(errno));
+        return false;
+    }
+
+    if (create) {
+        // allocate the pages right away so that a small /dev/shm is reported here
+        // instead of SIGBUS in the middle of a collective
+        int ret = ftruncate(fd, total_size);
+        if (!ret) {
+            ret = posix_fallocate(fd, 0, total_size);
+        }
+        if (ret) {
+            LOG_WARN("can not allocate ", total_size, " bytes for ", name);
+            close(fd);
+            shm_unlink(name.c_str());
+            return false;
+        }
+    }
+
+    void* ptr = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        LOG_WARN("mmap failed for ", name, ": ", strerror(errno));
+        if (create) {
+            shm_unlink(name.c_str());
+        }
+        return false;
+    }
+    base = static_cast<char*>(ptr);
+
+    return true;
+}
+
+std::shared_ptr<ccl_shm_coll_ctx> ccl_shm_coll_ctx::create(ccl_comm* comm) {
+    auto atl_comm = comm->get_atl_comm();
+    int rank = comm->rank();
+    int size = comm->size();
+
+    std::shared_ptr<ccl_shm_coll_ctx> ctx(
+        new ccl_shm_coll_ctx(rank, size, ccl::global_data::env().shm_coll_chunk_size));
+
+    // root creates the segment and shares its name, empty name means failure
+    char shm_name[shm_coll_name_size] = {};
+    if (rank == 0) {
+        snprintf(shm_name,
+                 sizeof(shm_name),
+                 "/ccl-shm-coll-%d-%d-%zu",
+                 getpid(),
+                 comm->id(),
+                 shm_coll_name_counter++);
+        if (!ctx->map(shm_name, true)) {
+            shm_name[0] = '\0';
+        }
+    }
+
+    std::vector<char> all_names(size * sizeof(shm_name));
+    CCL_THROW_IF_NOT(ccl::utils::allgather(atl_comm, shm_name, all_names.data(), sizeof(shm_name)),
+                     "allgather of shm coll segment name failed");
+
+    int is_mapped = (all_names[0] != '\0');
+    if (rank != 0 && is_mapped) {
+        is_mapped = ctx->map(std::string(all_names.data()), false);
+    }
+
+    std::vector<int> all_mapped(size);
+    CCL_THROW_IF_NOT(ccl::utils::allgather(atl_comm, &is_mapped, all_mapped.data(), sizeof(int)),
+                     "allgather of shm coll segment status failed");
+
+    // all ranks have opened the segment, the name is not needed anymore
+    if (rank == 0 && all_names[0] != '\0') {
+        shm_unlink(all_names.data());
+    }
+
+    for (int idx = 0; idx < size; idx++) {
+        if (!all_mapped[idx]) {
+            LOG_WARN("can not map shm coll segment on rank ", idx, ", shm algorithms are disabled");
+            return nullptr;
+        }
+    }
+
+    LOG_DEBUG(ctx->to_string());
+
+    return ctx;
+}
+
+std::atomic<uint64_t>* ccl_shm_coll_ctx::get_flag(uint64_t seq, int rank) const {
+    size_t slot = seq % slot_count;
+    return reinterpret_cast<std::atomic<uint64_t>*>(base +
+                                                    (slot * comm_size + rank) * CACHELINE_SIZE);
+}
+
+char* ccl_shm_coll_ctx::get_buf(uint64_t seq, int rank, size_t buf_idx) const {
+    size_t slot = seq % slot_count;
+    return base + flags_size + ((slot * comm_size + rank) * buf_count + buf_idx) * chunk_size;
+}
+
+bool ccl_shm_coll_ctx::is_step_reached(uint64_t seq, uint64_t step) const {
+    uint64_t value = make_flag(seq, step);
+    // own flag is checked as well, an earlier collective of this rank
+    // may still be running in the slot when a later one starts
+    for (int idx = 0; idx < comm_size; idx++) {
+        if (get_flag(seq, idx)->load(std::memory_order_acquire) < value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ccl_shm_coll_ctx::publish(uint64_t seq, uint64_t step) {
+    get_flag(seq, comm_rank)->store(make_flag(seq, step), std::memory_order_release);
+}
+
+std::string ccl_shm_coll_ctx::to_string() const {
+    std::stringstream ss;
+    ss << "shm coll ctx: { name: " << name << ", rank: " << comm_rank << ", size: " << comm_size
+       << ", slots: " << slot_count << ", chunk_size: " << chunk_size
+       << ", total_size: " << total_size << " }";
+    return ss.str();
+}
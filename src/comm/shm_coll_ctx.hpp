@@ -0,0 +1,88 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+class ccl_comm;
+
+// shared memory segment of the ranks of one node communicator
+//
+// the segment is split into slot_count slots so that several collectives can run concurrently,
+// each slot holds one progress flag and two data buffers of chunk_size bytes per rank.
+// collectives get monotonic sequence numbers in the order they are posted, which is the same
+// on all ranks, and occupy the slot seq % slot_count. the flag of a rank encodes
+// (seq << step_bits) | step, a rank reuses a slot only after all ranks have set
+// the done step of the previous collective in that slot
+class ccl_shm_coll_ctx {
+public:
+    static constexpr size_t slot_count = 4;
+    static constexpr size_t buf_count = 2;
+    static constexpr uint64_t step_bits = 24;
+    static constexpr uint64_t done_step = (1UL << step_bits) - 1;
+
+    ccl_shm_coll_ctx(const ccl_shm_coll_ctx&) = delete;
+    ccl_shm_coll_ctx& operator=(const ccl_shm_coll_ctx&) = delete;
+    ~ccl_shm_coll_ctx();
+
+    // collective over comm, returns nullptr on all ranks if any rank fails to map the segment
+    static std::shared_ptr<ccl_shm_coll_ctx> create(ccl_comm* comm);
+
+    int rank() const {
+        return comm_rank;
+    }
+
+    int size() const {
+        return comm_size;
+    }
+
+    size_t get_chunk_size() const {
+        return chunk_size;
+    }
+
+    uint64_t acquire_seq() {
+        return next_seq.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static uint64_t make_flag(uint64_t seq, uint64_t step) {
+        return (seq << step_bits) | step;
+    }
+
+    std::atomic<uint64_t>* get_flag(uint64_t seq, int rank) const;
+    char* get_buf(uint64_t seq, int rank, size_t buf_idx) const;
+
+    // true once all ranks have set at least the given step of collective seq
+    bool is_step_reached(uint64_t seq, uint64_t step) const;
+    void publish(uint64_t seq, uint64_t step);
+
+    std::string to_string() const;
+
+private:
+    ccl_shm_coll_ctx(int comm_rank, int comm_size, size_t chunk_size);
+
+    bool map(const std::string& name, bool create);
+
+    const int comm_rank;
+    const int comm_size;
+    const size_t chunk_size;
+    size_t flags_size{};
+    size_t total_size{};
+    std::string name;
+    char* base{ nullptr };
+    std::atomic<uint64_t> next_seq{ 0 };
+};
@@ -206,6 +206,15 @@ ccl::event stub_comm::send_impl(void* send_buf,
     return process_stub_backend();
 }
 
+ccl::persistent_request stub_comm::allreduce_init(const void* send_buf,
+                                                  void* recv_buf,
+                                                  size_t count,
+                                                  ccl::datatype dtype,
+                                                  ccl::reduction reduction,
+                                                  const ccl::allreduce_attr& attr) {
+    CCL_THROW("persistent operations are not supported by stub backend");
+}
+
 ccl::event stub_comm::process_stub_backend() {
     std::stringstream s;
     s << "running stub communicator id: " << kvs_impl->get_id();
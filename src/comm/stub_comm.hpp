@@ -77,6 +77,13 @@ public:
 
     COMM_IMPL_DECLARATION_VOID_REQUIRED
 
+    ccl::persistent_request allreduce_init(const void* send_buf,
+                                           void* recv_buf,
+                                           size_t count,
+                                           ccl::datatype dtype,
+                                           ccl::reduction reduction,
+                                           const ccl::allreduce_attr& attr) override;
+
     ccl::comm_interface_ptr split(int color, int key, bool split_external_use) override {
         return static_cast<ccl::comm_interface_ptr>(this);
     }
@@ -60,6 +60,12 @@ std::map<ccl_staging_buffer, std::string> env_data::staging_buffer_names = {
     std::make_pair(ccl_staging_usm, "usm")
 };
 
+std::map<ccl_compression_type, std::string> env_data::compression_names = {
+    std::make_pair(ccl_compression_none, "none"),
+    std::make_pair(ccl_compression_bf16, "bf16"),
+    std::make_pair(ccl_compression_fp16, "fp16")
+};
+
 std::map<backend_mode, std::string> env_data::backend_names = {
     std::make_pair(backend_mode::native, "native"),
 #ifdef CCL_ENABLE_STUB_BACKEND
@@ -93,6 +99,8 @@ env_data::env_data()
           worker_count(1),
           worker_offload(true),
           worker_wait(true),
+          worker_steal(false),
+          worker_hybrid_wait(false),
           worker_affinity_set(0),
 #ifdef CCL_ENABLE_MPI
           atl_transport(ccl_atl_mpi),
@@ -108,6 +116,7 @@ env_data::env_data()
           enable_hmem(0),
           atl_send_proxy(ccl_atl_send_proxy_none),
           enable_atl_cache(1),
+          atl_cache_max_size(4294967296),
           enable_sync_coll(0),
           enable_extra_ep(0),
           enable_auto_cache(0),
@@ -120,15 +129,22 @@ env_data::env_data()
           mnic_type(ATL_MNIC_NONE),
           mnic_count(CCL_ENV_SIZET_NOT_SPECIFIED),
           mnic_offset(ATL_MNIC_OFFSET_NONE),
+          mnic_stripe_size(0),
 
           enable_algo_fallback(1),
+          enable_algo_adaptive(0),
+          algo_adaptive_iters(8),
           enable_unordered_coll(0),
+          enable_shm_coll(0),
+          shm_coll_chunk_size(131072),
 
           enable_fusion(0),
           fusion_bytes_threshold(16384),
           fusion_count_threshold(256),
           fusion_check_urgent(1),
           fusion_cycle_ms(0.2),
+          fusion_adaptive(1),
+          fusion_zero_copy(0),
 
           priority_mode(ccl_priority_none),
           spin_count(100),
@@ -141,6 +157,8 @@ env_data::env_data()
 #else // CCL_ENABLE_SYCL
           enable_cache_flush(0),
 #endif // CCL_ENABLE_SYCL
+          cache_max_bytes(0),
+          cache_max_entries(0),
           enable_buffer_cache(1),
           enable_strict_order(0),
           staging_buffer(ccl_staging_regular),
@@ -237,11 +255,19 @@ env_data::env_data()
           allreduce_2d_min_chunk_size(65536),
           allreduce_2d_switch_dims(0),
 
+          allreduce_hier_chunk_size(1048576),
+          allreduce_eager_msg_size(256),
+          allreduce_ring_segment_size(0),
+          allreduce_dtree_min_comm_size(64),
+          allreduce_compression(ccl_compression_none),
+
           dtree_partition_count(CCL_ENV_SIZET_NOT_SPECIFIED),
 
           check_inplace_aliasing(1),
 
           alltoall_scatter_max_ops(CCL_ENV_SIZET_NOT_SPECIFIED),
+          alltoall_pairwise_min_comm_size(256),
+          enable_barrier_fast_path(1),
 
           backend(backend_mode::native),
 
@@ -364,7 +390,8 @@ env_data::env_data()
           enable_profiling(0),
 
           bf16_impl_type(ccl_bf16_scalar),
-          fp16_impl_type(ccl_fp16_no_compiler_support) {
+          fp16_impl_type(ccl_fp16_no_compiler_support),
+          simd_impl_type(ccl_simd_scalar) {
 }
 
 void env_data::parse() {
@@ -411,6 +438,8 @@ void env_data::parse() {
     CCL_THROW_IF_NOT(worker_count >= 1, "incorrect ", CCL_WORKER_COUNT, " ", worker_count);
     p.env_2_type(CCL_WORKER_OFFLOAD, worker_offload);
     p.env_2_type(CCL_WORKER_WAIT, worker_wait);
+    p.env_2_type(CCL_WORKER_STEAL, worker_steal);
+    p.env_2_type(CCL_WORKER_HYBRID_WAIT, worker_hybrid_wait);
 
     p.env_2_atl_transport(atl_transport_names, atl_transport);
     p.env_2_enum(CCL_KVS_MODE, kvs_mode_names, kvs_init_mode);
@@ -426,6 +455,7 @@ void env_data::parse() {
     }
     p.env_2_enum(CCL_ATL_SEND_PROXY, atl_send_proxy_names, atl_send_proxy);
     p.env_2_type(CCL_ATL_CACHE, enable_atl_cache);
+    p.env_2_type(CCL_ATL_CACHE_MAX_SIZE, atl_cache_max_size);
     p.env_2_type(CCL_ATL_SYNC_COLL, enable_sync_coll);
     p.env_2_type(CCL_ATL_EXTRA_EP, enable_extra_ep);
     p.env_2_type(CCL_ENABLE_AUTO_CACHE, enable_auto_cache);
@@ -442,8 +472,14 @@ void env_data::parse() {
         mnic_count = worker_count;
     }
     p.env_2_enum(CCL_MNIC_OFFSET, mnic_offset_names, mnic_offset);
+    p.env_2_type(CCL_MNIC_STRIPE_SIZE, mnic_stripe_size);
+    p.env_2_type(CCL_MNIC_STRIPE_WEIGHTS, mnic_stripe_weights_raw);
 
     p.env_2_type(CCL_ALGO_FALLBACK, enable_algo_fallback);
+    p.env_2_type(CCL_TUNING_FILE, tuning_file);
+    p.env_2_type(CCL_ALGO_ADAPTIVE, enable_algo_adaptive);
+    p.env_2_type(CCL_ALGO_ADAPTIVE_ITERS, algo_adaptive_iters);
+    CCL_THROW_IF_NOT(algo_adaptive_iters > 0, "incorrect ", CCL_ALGO_ADAPTIVE_ITERS);
     // main algorithm selection
     p.env_2_type(CCL_ALLGATHER, allgather_algo_raw);
     p.env_2_type(CCL_ALLGATHERV, allgatherv_algo_raw);
@@ -470,12 +506,24 @@ void env_data::parse() {
     if (enable_unordered_coll && atl_transport != ccl_atl_ofi) {
         CCL_THROW("unordered collectives are supported for OFI transport only");
     }
+    p.env_2_type(CCL_SHM_COLL, enable_shm_coll);
+    p.env_2_type(CCL_SHM_COLL_CHUNK_SIZE, shm_coll_chunk_size);
+    CCL_THROW_IF_NOT(shm_coll_chunk_size >= 4096 && shm_coll_chunk_size % CACHELINE_SIZE == 0,
+                     "incorrect ",
+                     CCL_SHM_COLL_CHUNK_SIZE,
+                     " ",
+                     shm_coll_chunk_size,
+                     ", expected multiple of ",
+                     CACHELINE_SIZE,
+                     " not less than 4096");
 
     p.env_2_type(CCL_FUSION, enable_fusion);
     p.env_2_type(CCL_FUSION_BYTES_THRESHOLD, fusion_bytes_threshold);
     p.env_2_type(CCL_FUSION_COUNT_THRESHOLD, fusion_count_threshold);
     p.env_2_type(CCL_FUSION_CHECK_URGENT, fusion_check_urgent);
     p.env_2_type(CCL_FUSION_CYCLE_MS, fusion_cycle_ms);
+    p.env_2_type(CCL_FUSION_ADAPTIVE, fusion_adaptive);
+    p.env_2_type(CCL_FUSION_ZERO_COPY, fusion_zero_copy);
     if (enable_fusion) {
         CCL_THROW_IF_NOT(fusion_bytes_threshold >= 1,
                          "incorrect ",
@@ -492,6 +540,9 @@ void env_data::parse() {
     if (!worker_offload || enable_fusion)
         worker_wait = false;
 
+    if (!worker_offload)
+        worker_hybrid_wait = false;
+
     if (worker_wait)
         spin_count = 1000;
 
@@ -502,6 +553,8 @@ void env_data::parse() {
     p.env_2_type(CCL_BCAST_PART_COUNT, (size_t&)bcast_part_count);
     p.env_2_enum(CCL_CACHE_KEY, ccl_sched_key::key_type_names, cache_key_type);
     p.env_2_type(CCL_CACHE_FLUSH, enable_cache_flush);
+    p.env_2_type(CCL_CACHE_MAX_BYTES, cache_max_bytes);
+    p.env_2_type(CCL_CACHE_MAX_ENTRIES, cache_max_entries);
     p.env_2_type(CCL_BUFFER_CACHE, enable_buffer_cache);
     p.env_2_type(CCL_STRICT_ORDER, enable_strict_order);
     if (enable_unordered_coll && enable_strict_order) {
@@ -616,9 +669,22 @@ void env_data::parse() {
                      allreduce_2d_min_chunk_size);
     p.env_2_type(CCL_ALLREDUCE_2D_SWITCH_DIMS, allreduce_2d_switch_dims);
 
+    p.env_2_type(CCL_ALLREDUCE_HIER_CHUNK_SIZE, allreduce_hier_chunk_size);
+    CCL_THROW_IF_NOT(allreduce_hier_chunk_size >= 1,
+                     "incorrect ",
+                     CCL_ALLREDUCE_HIER_CHUNK_SIZE,
+                     " ",
+                     allreduce_hier_chunk_size);
+    p.env_2_type(CCL_ALLREDUCE_EAGER_MSG_SIZE, allreduce_eager_msg_size);
+    p.env_2_type(CCL_ALLREDUCE_RING_SEGMENT_SIZE, allreduce_ring_segment_size);
+    p.env_2_type(CCL_ALLREDUCE_DTREE_MIN_COMM_SIZE, allreduce_dtree_min_comm_size);
+    p.env_2_enum(CCL_ALLREDUCE_COMPRESSION, compression_names, allreduce_compression);
+
     p.env_2_type(CCL_CHECK_INPLACE_ALIASING, check_inplace_aliasing);
 
     p.env_2_type(CCL_ALLTOALL_SCATTER_MAX_OPS, (size_t&)alltoall_scatter_max_ops);
+    p.env_2_type(CCL_ALLTOALL_PAIRWISE_MIN_COMM_SIZE, alltoall_pairwise_min_comm_size);
+    p.env_2_type(CCL_BARRIER_FAST_PATH, enable_barrier_fast_path);
 
     p.env_2_enum(CCL_BACKEND, backend_names, backend);
 
@@ -787,6 +853,17 @@ void env_data::parse() {
     CCL_THROW_IF_NOT(fp16_impl_types.find(fp16_impl_type) != fp16_impl_types.end(),
                      "unsupported FP16 impl type: ",
                      fp16_env_impl_names[fp16_impl_type]);
+    CCL_THROW_IF_NOT(
+        allreduce_compression != ccl_compression_fp16 || fp16_impl_type >= ccl_fp16_f16c,
+        "FP16 compression requires FP16 support: ",
+        fp16_impl_names[fp16_impl_type]);
+
+    auto simd_impl_types = ccl_simd_get_impl_types();
+    simd_impl_type = *simd_impl_types.rbegin();
+    p.env_2_enum(CCL_REDUCE_IMPL, simd_impl_names, simd_impl_type);
+    CCL_THROW_IF_NOT(simd_impl_types.find(simd_impl_type) != simd_impl_types.end(),
+                     "unsupported reduction impl type: ",
+                     simd_impl_names[simd_impl_type]);
 
     p.warn_about_unused_var();
 }
@@ -864,6 +941,8 @@ void env_data::print(int rank, bool is_profile_mode, bool is_mt_enabled) {
     LOG_INFO_PROFILED(CCL_WORKER_COUNT, ": ", worker_count);
     LOG_INFO_PROFILED(CCL_WORKER_OFFLOAD, ": ", worker_offload);
     LOG_INFO_PROFILED(CCL_WORKER_WAIT, ": ", worker_wait);
+    LOG_INFO_PROFILED(CCL_WORKER_STEAL, ": ", worker_steal);
+    LOG_INFO_PROFILED(CCL_WORKER_HYBRID_WAIT, ": ", worker_hybrid_wait);
 
     LOG_INFO_PROFILED(CCL_LOG_LEVEL, ": ", str_by_enum(ccl_logger::level_names, log_level));
     LOG_INFO_PROFILED(CCL_ABORT_ON_THROW, ": ", abort_on_throw);
@@ -888,6 +967,7 @@ void env_data::print(int rank, bool is_profile_mode, bool is_mt_enabled) {
     LOG_INFO_PROFILED(CCL_ATL_HMEM, ": ", enable_hmem);
     LOG_INFO_PROFILED(CCL_ATL_SEND_PROXY, ": ", str_by_enum(atl_send_proxy_names, atl_send_proxy));
     LOG_INFO_PROFILED(CCL_ATL_CACHE, ": ", enable_atl_cache);
+    LOG_INFO_PROFILED(CCL_ATL_CACHE_MAX_SIZE, ": ", atl_cache_max_size);
     LOG_DEBUG(CCL_ATL_SYNC_COLL, ": ", enable_sync_coll);
     LOG_DEBUG(CCL_ATL_EXTRA_EP, ": ", enable_extra_ep);
     LOG_DEBUG(CCL_ENABLE_AUTO_CACHE, ": ", enable_auto_cache);
@@ -902,8 +982,19 @@ void env_data::print(int rank, bool is_profile_mode, bool is_mt_enabled) {
         CCL_MNIC_NAME, ": ", (mnic_name_raw.length()) ? mnic_name_raw : CCL_ENV_STR_NOT_SPECIFIED);
     LOG_INFO_PROFILED(CCL_MNIC_COUNT, ": ", mnic_count);
     LOG_INFO_PROFILED(CCL_MNIC_OFFSET, ": ", str_by_enum(mnic_offset_names, mnic_offset));
+    LOG_INFO_PROFILED(CCL_MNIC_STRIPE_SIZE, ": ", mnic_stripe_size);
+    LOG_INFO_PROFILED(CCL_MNIC_STRIPE_WEIGHTS,
+                      ": ",
+                      (mnic_stripe_weights_raw.length()) ? mnic_stripe_weights_raw
+                                                         : CCL_ENV_STR_NOT_SPECIFIED);
 
     LOG_INFO_PROFILED(CCL_ALGO_FALLBACK, ": ", enable_algo_fallback);
+    LOG_INFO_PROFILED(
+        CCL_TUNING_FILE, ": ", (tuning_file.length()) ? tuning_file : CCL_ENV_STR_NOT_SPECIFIED);
+    LOG_INFO_PROFILED(CCL_ALGO_ADAPTIVE, ": ", enable_algo_adaptive);
+    if (enable_algo_adaptive) {
+        LOG_INFO_PROFILED(CCL_ALGO_ADAPTIVE_ITERS, ": ", algo_adaptive_iters);
+    }
     LOG_INFO_PROFILED(CCL_ALLGATHER,
                       ": ",
                       (allgather_algo_raw.length()) ? allgather_algo_raw : CCL_ENV_STR_NOT_SPECIFIED);
@@ -963,12 +1054,16 @@ void env_data::print(int rank, bool is_profile_mode, bool is_mt_enabled) {
         ": ",
         (reduce_scatter_scaleout_algo_raw.length()) ? reduce_scatter_scaleout_algo_raw : CCL_ENV_STR_NOT_SPECIFIED);
     LOG_INFO_PROFILED(CCL_UNORDERED_COLL, ": ", enable_unordered_coll);
+    LOG_INFO_PROFILED(CCL_SHM_COLL, ": ", enable_shm_coll);
+    LOG_INFO_PROFILED(CCL_SHM_COLL_CHUNK_SIZE, ": ", shm_coll_chunk_size);
 
     LOG_INFO_PROFILED(CCL_FUSION, ": ", enable_fusion);
     LOG_INFO_PROFILED(CCL_FUSION_BYTES_THRESHOLD, ": ", fusion_bytes_threshold);
     LOG_INFO_PROFILED(CCL_FUSION_COUNT_THRESHOLD, ": ", fusion_count_threshold);
     LOG_INFO_PROFILED(CCL_FUSION_CHECK_URGENT, ": ", fusion_check_urgent);
     LOG_INFO_PROFILED(CCL_FUSION_CYCLE_MS, ": ", fusion_cycle_ms);
+    LOG_INFO_PROFILED(CCL_FUSION_ADAPTIVE, ": ", fusion_adaptive);
+    LOG_INFO_PROFILED(CCL_FUSION_ZERO_COPY, ": ", fusion_zero_copy);
 
     LOG_INFO_PROFILED(CCL_PRIORITY, ": ", str_by_enum(priority_mode_names, priority_mode));
     LOG_INFO_PROFILED(CCL_SPIN_COUNT, ": ", spin_count);
@@ -980,6 +1075,8 @@ void env_data::print(int rank, bool is_profile_mode, bool is_mt_enabled) {
                                                                         : CCL_ENV_STR_NOT_SPECIFIED);
     LOG_INFO_PROFILED(CCL_CACHE_KEY, ": ", str_by_enum(ccl_sched_key::key_type_names, cache_key_type));
     LOG_INFO_PROFILED(CCL_CACHE_FLUSH, ": ", enable_cache_flush);
+    LOG_INFO_PROFILED(CCL_CACHE_MAX_BYTES, ": ", cache_max_bytes);
+    LOG_INFO_PROFILED(CCL_CACHE_MAX_ENTRIES, ": ", cache_max_entries);
     LOG_INFO_PROFILED(CCL_BUFFER_CACHE, ": ", enable_buffer_cache);
     LOG_INFO_PROFILED(CCL_STRICT_ORDER, ": ", enable_strict_order);
     LOG_INFO_PROFILED(CCL_STAGING_BUFFER, ": ", str_by_enum(staging_buffer_names, staging_buffer));
@@ -1081,6 +1178,14 @@ void env_data::print(int rank, bool is_profile_mode, bool is_mt_enabled) {
     LOG_INFO_PROFILED(CCL_ALLREDUCE_2D_MIN_CHUNK_SIZE, ": ", allreduce_2d_min_chunk_size);
     LOG_INFO_PROFILED(CCL_ALLREDUCE_2D_SWITCH_DIMS, ": ", allreduce_2d_switch_dims);
 
+    LOG_INFO_PROFILED(CCL_ALLREDUCE_HIER_CHUNK_SIZE, ": ", allreduce_hier_chunk_size);
+    LOG_INFO_PROFILED(CCL_ALLREDUCE_EAGER_MSG_SIZE, ": ", allreduce_eager_msg_size);
+    LOG_INFO_PROFILED(CCL_ALLREDUCE_RING_SEGMENT_SIZE, ": ", allreduce_ring_segment_size);
+    LOG_INFO_PROFILED(CCL_ALLREDUCE_DTREE_MIN_COMM_SIZE, ": ", allreduce_dtree_min_comm_size);
+    LOG_INFO_PROFILED(CCL_ALLREDUCE_COMPRESSION,
+                      ": ",
+                      str_by_enum(compression_names, allreduce_compression));
+
     LOG_INFO_PROFILED(CCL_CHECK_INPLACE_ALIASING, ": ", check_inplace_aliasing);
 
     LOG_INFO_PROFILED(CCL_ALLTOALL_SCATTER_MAX_OPS,
@@ -1088,6 +1193,8 @@ void env_data::print(int rank, bool is_profile_mode, bool is_mt_enabled) {
                       (alltoall_scatter_max_ops != CCL_ENV_SIZET_NOT_SPECIFIED)
                           ? std::to_string(alltoall_scatter_max_ops)
                           : CCL_ENV_STR_NOT_SPECIFIED);
+    LOG_INFO_PROFILED(CCL_ALLTOALL_PAIRWISE_MIN_COMM_SIZE, ": ", alltoall_pairwise_min_comm_size);
+    LOG_INFO_PROFILED(CCL_BARRIER_FAST_PATH, ": ", enable_barrier_fast_path);
 
     LOG_INFO_PROFILED(CCL_BACKEND, ": ", str_by_enum(backend_names, backend));
 
@@ -1221,6 +1328,7 @@ void env_data::print(int rank, bool is_profile_mode, bool is_mt_enabled) {
 
     LOG_INFO_PROFILED(CCL_BF16, ": ", str_by_enum(bf16_impl_names, bf16_impl_type));
     LOG_INFO_PROFILED(CCL_FP16, ": ", str_by_enum(fp16_impl_names, fp16_impl_type));
+    LOG_INFO_PROFILED(CCL_REDUCE_IMPL, ": ", str_by_enum(simd_impl_names, simd_impl_type));
 
     char* ccl_root = getenv("CCL_ROOT");
     LOG_INFO_PROFILED("CCL_ROOT: ", (ccl_root) ? ccl_root : CCL_ENV_STR_NOT_SPECIFIED);
@@ -29,6 +29,7 @@
 #include "common/utils/yield.hpp"
 #include "comp/bf16/bf16_utils.hpp"
 #include "comp/fp16/fp16_utils.hpp"
+#include "comp/simd/simd_utils.hpp"
 #include "sched/cache/cache.hpp"
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 #include "common/global/ze/ze_fd_manager.hpp"
@@ -55,6 +56,8 @@ enum ccl_atl_send_proxy {
 enum ccl_staging_buffer { ccl_staging_regular,
                           ccl_staging_usm };
 
+enum ccl_compression_type { ccl_compression_none, ccl_compression_bf16, ccl_compression_fp16 };
+
 enum class backend_mode {
     native,
 #ifdef CCL_ENABLE_STUB_BACKEND
@@ -121,6 +124,8 @@ public:
     size_t worker_count;
     bool worker_offload;
     bool worker_wait;
+    bool worker_steal;
+    bool worker_hybrid_wait;
     bool worker_affinity_set;
     std::vector<ssize_t> worker_affinity;
     std::vector<ssize_t> worker_mem_affinity;
@@ -135,6 +140,7 @@ public:
     bool enable_hmem;
     ccl_atl_send_proxy atl_send_proxy;
     bool enable_atl_cache;
+    size_t atl_cache_max_size;
     bool enable_sync_coll;
     bool enable_extra_ep;
     bool enable_auto_cache;
@@ -149,6 +155,8 @@ public:
     std::string mnic_name_raw;
     ssize_t mnic_count;
     atl_mnic_offset_t mnic_offset;
+    size_t mnic_stripe_size;
+    std::string mnic_stripe_weights_raw;
 
     /*
        parsing logic can be quite complex
@@ -158,6 +166,9 @@ public:
     std::shared_ptr<ccl_selection_table_t<ccl_coll_recv_algo>> fallback_recv, store_fallback_recv;
     std::shared_ptr<ccl_selection_table_t<ccl_coll_send_algo>> fallback_send, store_fallback_send;
     bool enable_algo_fallback;
+    std::string tuning_file;
+    bool enable_algo_adaptive;
+    size_t algo_adaptive_iters;
     // main algorithm selection
     std::string allgather_algo_raw;
     std::string allgatherv_algo_raw;
@@ -185,12 +196,16 @@ public:
     std::string reduce_scatter_scaleout_algo_raw;
     std::string send_scaleout_algo_raw;
     bool enable_unordered_coll;
+    bool enable_shm_coll;
+    size_t shm_coll_chunk_size;
 
     bool enable_fusion;
     int fusion_bytes_threshold;
     int fusion_count_threshold;
     bool fusion_check_urgent;
     float fusion_cycle_ms;
+    bool fusion_adaptive;
+    bool fusion_zero_copy;
 
     ccl_priority_mode priority_mode;
     size_t spin_count;
@@ -199,6 +214,8 @@ public:
     ssize_t bcast_part_count;
     ccl_cache_key_type cache_key_type;
     bool enable_cache_flush;
+    size_t cache_max_bytes;
+    size_t cache_max_entries;
     bool enable_buffer_cache;
     bool enable_strict_order;
     ccl_staging_buffer staging_buffer;
@@ -289,11 +306,19 @@ public:
     size_t allreduce_2d_min_chunk_size;
     bool allreduce_2d_switch_dims;
 
+    size_t allreduce_hier_chunk_size;
+    size_t allreduce_eager_msg_size;
+    size_t allreduce_ring_segment_size;
+    size_t allreduce_dtree_min_comm_size;
+    ccl_compression_type allreduce_compression;
+
     ssize_t dtree_partition_count;
 
     bool check_inplace_aliasing;
 
     ssize_t alltoall_scatter_max_ops;
+    size_t alltoall_pairwise_min_comm_size;
+    bool enable_barrier_fast_path;
 
     backend_mode backend;
 
@@ -398,6 +423,7 @@ public:
 
     ccl_bf16_impl_type bf16_impl_type;
     ccl_fp16_impl_type fp16_impl_type;
+    ccl_simd_impl_type simd_impl_type;
 
     template <class T>
     static std::string str_by_enum(const std::map<T, std::string>& values, const T& val) {
@@ -417,6 +443,7 @@ public:
     static std::map<ccl_atl_transport, std::string> atl_transport_names;
     static std::map<ccl_atl_send_proxy, std::string> atl_send_proxy_names;
     static std::map<ccl_staging_buffer, std::string> staging_buffer_names;
+    static std::map<ccl_compression_type, std::string> compression_names;
     static std::map<backend_mode, std::string> backend_names;
     static std::map<process_launcher_mode, std::string> process_launcher_names;
 
@@ -79,6 +79,8 @@ constexpr const char* CCL_WORKER_COUNT = "CCL_WORKER_COUNT";
 
 constexpr const char* CCL_WORKER_OFFLOAD = "CCL_WORKER_OFFLOAD";
 constexpr const char* CCL_WORKER_WAIT = "CCL_WORKER_WAIT";
+constexpr const char* CCL_WORKER_STEAL = "CCL_WORKER_STEAL";
+constexpr const char* CCL_WORKER_HYBRID_WAIT = "CCL_WORKER_HYBRID_WAIT";
 
 /**
  * @addtogroup OneCCLvars
@@ -205,6 +207,7 @@ constexpr const char* CCL_ATL_SEND_PROXY = "CCL_ATL_SEND_PROXY";
 constexpr const char* CCL_ATL_SYNC_COLL = "CCL_ATL_SYNC_COLL";
 constexpr const char* CCL_ATL_EXTRA_EP = "CCL_ATL_EXTRA_EP";
 constexpr const char* CCL_ATL_CACHE = "CCL_ATL_CACHE";
+constexpr const char* CCL_ATL_CACHE_MAX_SIZE = "CCL_ATL_CACHE_MAX_SIZE";
 /**
  * @addtogroup OneCCLvars
  * @{
@@ -259,8 +262,18 @@ constexpr const char* CCL_MNIC = "CCL_MNIC";
 constexpr const char* CCL_MNIC_NAME = "CCL_MNIC_NAME";
 constexpr const char* CCL_MNIC_COUNT = "CCL_MNIC_COUNT";
 constexpr const char* CCL_MNIC_OFFSET = "CCL_MNIC_OFFSET";
+/* messages of at least this size are striped across all selected NICs, 0 disables striping */
+constexpr const char* CCL_MNIC_STRIPE_SIZE = "CCL_MNIC_STRIPE_SIZE";
+/* comma-separated relative per-NIC weights for striping, equal weights if not set */
+constexpr const char* CCL_MNIC_STRIPE_WEIGHTS = "CCL_MNIC_STRIPE_WEIGHTS";
 
 constexpr const char* CCL_ALGO_FALLBACK = "CCL_ALGO_FALLBACK";
+/* file with per comm size and ranks per node selection strings, see benchmark autotune.sh */
+constexpr const char* CCL_TUNING_FILE = "CCL_TUNING_FILE";
+/* explore candidate algorithms at runtime and lock in the fastest one per message size bucket */
+constexpr const char* CCL_ALGO_ADAPTIVE = "CCL_ALGO_ADAPTIVE";
+/* number of timed calls per candidate algorithm before the choice is made */
+constexpr const char* CCL_ALGO_ADAPTIVE_ITERS = "CCL_ALGO_ADAPTIVE_ITERS";
 /**
  * @addtogroup OneCCLvars
  * @{
@@ -292,6 +305,7 @@ constexpr const char* CCL_ALLGATHER = "CCL_ALLGATHER";
  *  - ring      Alltoall-based algorithm
  *  - flat      Alltoall-based algorithm
  *  - multi_bcast   Series of broadcast operations with different root ranks
+ *  - shm       Copies through the shm segment of the node, requires CCL_SHM_COLL=1
  *  - topo	     Topo scaleup algorithm
  *
  *
@@ -307,12 +321,23 @@ constexpr const char* CCL_ALLGATHERV = "CCL_ALLGATHERV";
  *  - direct        Based on MPI_Iallreduce
  *  - rabenseifner  Rabenseifner’s algorithm
  *  - nreduce       May be beneficial for imbalanced workloads
- *  - ring          Reduce_scatter + allgather ring. Use CCL_RS_CHUNK_COUNT
- *      and CCL_RS_MIN_CHUNK_SIZE to control pipelining on reduce_scatter phase.
- *  - double_tree   Double-tree algorithm
- *  - recursive_doubling    Recursive doubling algorithm
+ *  - ring          Reduce_scatter + allgather ring. Host (CPU) messages are split into
+ *      segments of CCL_ALLREDUCE_RING_SEGMENT_SIZE bytes (0 - auto) pipelined over the ring.
+ *      Otherwise use CCL_RS_CHUNK_COUNT and CCL_RS_MIN_CHUNK_SIZE to control pipelining
+ *      on reduce_scatter phase. Host float32 sum/avg data is sent in 16-bit format
+ *      if CCL_ALLREDUCE_COMPRESSION is set.
+ *  - double_tree   Double-tree algorithm. Host (CPU) messages are reduced and broadcast
+ *      in chunks pipelined over both trees, CCL_DTREE_PARTITION_COUNT sets the number of chunks
+ *      (auto by default). Used by default for medium messages on communicators with at least
+ *      CCL_ALLREDUCE_DTREE_MIN_COMM_SIZE ranks.
+ *  - recursive_doubling    Recursive doubling algorithm. Host (CPU) messages up to
+ *      CCL_ALLREDUCE_EAGER_MSG_SIZE bytes are exchanged by a single entry with pre-posted receives.
  *  - 2d            Two-dimensional algorithm (reduce_scatter + allreduce + allgather).
  *                  Only available for Host (CPU) buffers.
+ *  - shm           Reduction through the shm segment of the node, requires CCL_SHM_COLL=1
+ *  - hier          Pipelined node reduce_scatter + inter-node allreduce + node allgather.
+ *                  Only available for Host (CPU) buffers with the same number of ranks per node.
+ *                  Use CCL_ALLREDUCE_HIER_CHUNK_SIZE to control pipelining.
  *  - topo          Topo scaleup algorithm (available if sycl and l0 are enabled)
  *
  *
@@ -327,9 +352,12 @@ constexpr const char* CCL_ALLREDUCE = "CCL_ALLREDUCE";
  *  - direct    Based on MPI_Ialltoallv
  *  - naive     Send to all, receive from all
  *  - scatter   Scatter-based algorithm
+ *  - pairwise  Exchange with a single peer per step (XOR or shifted peers)
+ *  - bruck     Bruck algorithm, log(p) steps, for short messages
  *  - topo	    Topo scaleup algorithm (available if sycl and l0 are enabled)
  *
- * By-default: "topo", if sycl and l0 are enable, otherwise "scatter"
+ * By-default: "topo", if sycl and l0 are enable, otherwise "scatter",
+ * "bruck" and "pairwise" on comms of at least CCL_ALLTOALL_PAIRWISE_MIN_COMM_SIZE ranks
  */
 constexpr const char* CCL_ALLTOALL = "CCL_ALLTOALL";
 /**
@@ -339,9 +367,13 @@ constexpr const char* CCL_ALLTOALL = "CCL_ALLTOALL";
  * ALLTOALLV algorithms
  *  - direct    Based on MPI_Ialltoallv
  *  - naive     Send to all, receive from all
+ *  - scatter   Scatter-based algorithm
+ *  - pairwise  Exchange with a single peer per step (XOR or shifted peers)
+ *  - hier      Data is aggregated per node, a single message per node pair between nodes
  *  - topo      Topo scaleup algorithm (available if sycl and l0 are enabled)
  *
- * By-default: "topo", if sycl and l0 are enable, otherwise "scatter"
+ * By-default: "topo", if sycl and l0 are enable, otherwise "scatter",
+ * "pairwise" on comms of at least CCL_ALLTOALL_PAIRWISE_MIN_COMM_SIZE ranks
  */
 constexpr const char* CCL_ALLTOALLV = "CCL_ALLTOALLV";
 /**
@@ -351,11 +383,13 @@ constexpr const char* CCL_ALLTOALLV = "CCL_ALLTOALLV";
  * BARRIER algorithms
  *  - direct    Based on MPI_Ibarrier
  *  - ring      Ring-based algorithm
+ *  - shm       Flags in the shm segment of the node, requires CCL_SHM_COLL=1
+ *  - hier      Node barrier through shm, dissemination among the node leaders, node barrier
  *
  * Note: BARRIER does not support the CCL_BARRIER_SCALEOUT environment
  * variable. To change the algorithm for scaleout, use CCL_BARRIER.
  *
- * By-default: "direct"
+ * By-default: "direct", "hier" with CCL_SHM_COLL=1
  */
 constexpr const char* CCL_BARRIER = "CCL_BARRIER";
 /**
@@ -367,6 +401,7 @@ constexpr const char* CCL_BARRIER = "CCL_BARRIER";
  *  - ring          Ring
  *  - double_tree   Double-tree algorithm
  *  - naive         Send to all from root rank
+ *  - shm           Copies through the shm segment of the node, requires CCL_SHM_COLL=1
  *
  *  Note: BCAST algorithm does not support yet the  CCL_BCAST_SCALEOUT
  * environment variable. To change the algorithm for BCAST, use CCL_BCAST.
@@ -414,6 +449,7 @@ constexpr const char* CCL_REDUCE = "CCL_REDUCE";
  *  - direct    Based on MPI_Ireduce_scatter_block
  *  - naive     Send to all, receive and reduce from all
  *  - ring      Ring-based algorithm. Use CCL_RS_CHUNK_COUNT and CCL_RS_MIN_CHUNK_SIZE to control pipelining.
+ *  - shm       Reduction through the shm segment of the node, requires CCL_SHM_COLL=1
  *  - topo      Topo algorithm (available if sycl and l0 are enabled, scaleup only)
  *
  * By-default: "topo" if sycl and l0 are enabled,
@@ -456,6 +492,22 @@ constexpr const char* CCL_SEND = "CCL_SEND";
 /** @} */
 
 constexpr const char* CCL_UNORDERED_COLL = "CCL_UNORDERED_COLL";
+/**
+ * @brief Enable shared memory collectives for host buffers of ranks on the same node
+ *
+ * @details
+ * Each node maps a segment per communicator, "shm" algorithms of allreduce, reduce_scatter,
+ * allgatherv, bcast and barrier work on it through direct loads and stores
+ *
+ * By-default: "0"
+ */
+constexpr const char* CCL_SHM_COLL = "CCL_SHM_COLL";
+/**
+ * @brief Set the size of the per-rank buffer used by one step of shared memory collectives
+ *
+ * By-default: "131072"
+ */
+constexpr const char* CCL_SHM_COLL_CHUNK_SIZE = "CCL_SHM_COLL_CHUNK_SIZE";
 /*
  * SCALEOUT
  *
@@ -596,6 +648,8 @@ constexpr const char* CCL_FUSION_BYTES_THRESHOLD = "CCL_FUSION_BYTES_THRESHOLD";
 constexpr const char* CCL_FUSION_COUNT_THRESHOLD = "CCL_FUSION_COUNT_THRESHOLD";
 constexpr const char* CCL_FUSION_CHECK_URGENT = "CCL_FUSION_CHECK_URGENT";
 constexpr const char* CCL_FUSION_CYCLE_MS = "CCL_FUSION_CYCLE_MS";
+constexpr const char* CCL_FUSION_ADAPTIVE = "CCL_FUSION_ADAPTIVE";
+constexpr const char* CCL_FUSION_ZERO_COPY = "CCL_FUSION_ZERO_COPY";
 
 constexpr const char* CCL_PRIORITY = "CCL_PRIORITY";
 constexpr const char* CCL_SPIN_COUNT = "CCL_SPIN_COUNT";
@@ -604,6 +658,8 @@ constexpr const char* CCL_MAX_SHORT_SIZE = "CCL_MAX_SHORT_SIZE";
 constexpr const char* CCL_BCAST_PART_COUNT = "CCL_BCAST_PART_COUNT";
 constexpr const char* CCL_CACHE_KEY = "CCL_CACHE_KEY";
 constexpr const char* CCL_CACHE_FLUSH = "CCL_CACHE_FLUSH";
+constexpr const char* CCL_CACHE_MAX_BYTES = "CCL_CACHE_MAX_BYTES";
+constexpr const char* CCL_CACHE_MAX_ENTRIES = "CCL_CACHE_MAX_ENTRIES";
 constexpr const char* CCL_BUFFER_CACHE = "CCL_BUFFER_CACHE";
 constexpr const char* CCL_STRICT_ORDER = "CCL_STRICT_ORDER";
 constexpr const char* CCL_STAGING_BUFFER = "CCL_STAGING_BUFFER";
@@ -931,11 +987,22 @@ constexpr const char* CCL_ALLREDUCE_2D_CHUNK_COUNT = "CCL_ALLREDUCE_2D_CHUNK_COU
 constexpr const char* CCL_ALLREDUCE_2D_MIN_CHUNK_SIZE = "CCL_ALLREDUCE_2D_MIN_CHUNK_SIZE";
 constexpr const char* CCL_ALLREDUCE_2D_SWITCH_DIMS = "CCL_ALLREDUCE_2D_SWITCH_DIMS";
 
+constexpr const char* CCL_ALLREDUCE_HIER_CHUNK_SIZE = "CCL_ALLREDUCE_HIER_CHUNK_SIZE";
+constexpr const char* CCL_ALLREDUCE_EAGER_MSG_SIZE = "CCL_ALLREDUCE_EAGER_MSG_SIZE";
+constexpr const char* CCL_ALLREDUCE_RING_SEGMENT_SIZE = "CCL_ALLREDUCE_RING_SEGMENT_SIZE";
+constexpr const char* CCL_ALLREDUCE_DTREE_MIN_COMM_SIZE = "CCL_ALLREDUCE_DTREE_MIN_COMM_SIZE";
+// none, bf16 or fp16: float32 sum/avg data is sent in 16-bit format by the ring allreduce
+constexpr const char* CCL_ALLREDUCE_COMPRESSION = "CCL_ALLREDUCE_COMPRESSION";
+
 constexpr const char* CCL_DTREE_PARTITION_COUNT = "CCL_DTREE_PARTITION_COUNT";
 
 constexpr const char* CCL_CHECK_INPLACE_ALIASING = "CCL_CHECK_INPLACE_ALIASING";
 
 constexpr const char* CCL_ALLTOALL_SCATTER_MAX_OPS = "CCL_ALLTOALL_SCATTER_MAX_OPS";
+// bruck (short messages) and pairwise are used by default on comms starting from this size
+constexpr const char* CCL_ALLTOALL_PAIRWISE_MIN_COMM_SIZE = "CCL_ALLTOALL_PAIRWISE_MIN_COMM_SIZE";
+// host barrier with hier algorithm is completed by the calling thread, without schedule
+constexpr const char* CCL_BARRIER_FAST_PATH = "CCL_BARRIER_FAST_PATH";
 
 constexpr const char* CCL_BACKEND = "CCL_BACKEND";
 
@@ -1237,3 +1304,11 @@ constexpr const char* CCL_PROFILING_ENABLE = "CCL_PROFILING_ENABLE";
 
 constexpr const char* CCL_BF16 = "CCL_BF16";
 constexpr const char* CCL_FP16 = "CCL_FP16";
+/**
+ * @brief Set to select SIMD implementation of reduction for integer and FP32/FP64 types
+ *
+ * @details "scalar", "sse42", "avx2", "avx512f"
+ *
+ * By-default: the widest instruction set supported by CPU
+ */
+constexpr const char* CCL_REDUCE_IMPL = "CCL_REDUCE_IMPL";
@@ -13,6 +13,7 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include "coll/selection/adaptive_selector.hpp"
 #include "coll/selection/selection.hpp"
 #include "common/api_wrapper/api_wrapper.hpp"
 #include "common/api_wrapper/pmix_api_wrapper.hpp"
@@ -140,6 +141,10 @@ void global_data::init_resize_independent_objects() {
     algorithm_selector.reset(new ccl_algorithm_selector_wrapper<CCL_COLL_LIST>());
     algorithm_selector->init();
 
+    if (env_object.enable_algo_adaptive) {
+        adaptive_selector.reset(new ccl_adaptive_selector(env_object.algo_adaptive_iters));
+    }
+
     hwloc_wrapper.reset(new ccl_hwloc_wrapper());
 
     metrics_profiler.reset(new profile::metrics_manager());
@@ -156,6 +161,7 @@ void global_data::reset_resize_dependent_objects() {
 
 void global_data::reset_resize_independent_objects() {
     parallelizer.reset();
+    adaptive_selector.reset();
     algorithm_selector.reset();
     hwloc_wrapper.reset();
     metrics_profiler.reset();
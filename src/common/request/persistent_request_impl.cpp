@@ -0,0 +1,56 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "common/global/global.hpp"
+#include "common/request/persistent_request_impl.hpp"
+#include "common/request/request.hpp"
+#include "exec/exec.hpp"
+#include "sched/sched.hpp"
+
+namespace ccl {
+
+persistent_request_impl::persistent_request_impl(ccl_sched* sched) : sched(sched) {
+    CCL_THROW_IF_NOT(sched, "no sched for persistent request");
+}
+
+persistent_request_impl::~persistent_request_impl() {
+    if (req) {
+        LOG_ERROR("persistent request is destroyed while its operation is in progress");
+        wait();
+    }
+    delete sched;
+}
+
+void persistent_request_impl::start() {
+    CCL_THROW_IF_NOT(!req || req->is_completed(),
+                     "persistent request is started while its previous start is in progress");
+    req = sched->start_persistent(ccl::global_data::get().executor.get());
+}
+
+void persistent_request_impl::wait() {
+    if (req) {
+        ccl::global_data::get().executor.get()->wait(req);
+        req = nullptr;
+    }
+}
+
+bool persistent_request_impl::test() {
+    if (req && ccl::global_data::get().executor.get()->test(req)) {
+        req = nullptr;
+    }
+    return (req == nullptr);
+}
+
+} // namespace ccl
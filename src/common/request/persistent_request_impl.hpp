@@ -0,0 +1,45 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "oneapi/ccl/types.hpp"
+
+class ccl_request;
+class ccl_sched;
+
+namespace ccl {
+
+// owns the schedule of a persistent operation, the schedule is built once
+// and restarted on every start() without parameter processing and selection
+class persistent_request_impl {
+public:
+    explicit persistent_request_impl(ccl_sched* sched);
+    ~persistent_request_impl();
+
+    persistent_request_impl(const persistent_request_impl&) = delete;
+    persistent_request_impl& operator=(const persistent_request_impl&) = delete;
+
+    void start();
+    void wait();
+    bool test();
+
+private:
+    ccl_sched* sched = nullptr;
+    // request of the last start, nullptr if the operation is not in progress
+    ccl_request* req = nullptr;
+};
+
+} // namespace ccl
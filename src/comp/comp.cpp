@@ -16,6 +16,7 @@
 #include "comp/bf16/bf16.hpp"
 #include "comp/comp.hpp"
 #include "comp/fp16/fp16.hpp"
+#include "comp/simd/simd.hpp"
 #include "common/log/log.hpp"
 #include "common/global/global.hpp"
 #include "common/utils/enums.hpp"
@@ -58,7 +59,7 @@
     } while (0)
 
 ccl::status ccl_comp_copy(const void* in_buf, void* out_buf, size_t bytes, bool use_nontemporal) {
-    if (bytes == 0) {
+    if (bytes == 0 || in_buf == out_buf) {
         return ccl::status::success;
     }
 
@@ -73,6 +74,92 @@ ccl::status ccl_comp_copy(const void* in_buf, void* out_buf, size_t bytes, bool
     return ccl::status::success;
 }
 
+/* elements processed at once by the fused kernels, the block stays in L1 between the steps */
+#define CCL_COMP_BLOCK_COUNT 2048
+
+/* fp16 conversions work on vectors, the tail goes through a padded copy */
+#define CCL_COMP_FP16_VEC_COUNT 8
+
+static void ccl_comp_convert_to_fp32(const void* in_buf,
+                                     float* out_buf,
+                                     size_t count,
+                                     ccl::datatype dtype) {
+    switch (dtype) {
+        case ccl::datatype::bfloat16:
+            ccl_convert_bf16_to_fp32_arrays(const_cast<void*>(in_buf), out_buf, count);
+            break;
+        case ccl::datatype::float16: {
+            const uint16_t* in = static_cast<const uint16_t*>(in_buf);
+            size_t vec_limit = count / CCL_COMP_FP16_VEC_COUNT * CCL_COMP_FP16_VEC_COUNT;
+            for (size_t i = 0; i < vec_limit; i += CCL_COMP_FP16_VEC_COUNT) {
+                ccl_convert_fp16_to_fp32(in + i, out_buf + i);
+            }
+            if (vec_limit < count) {
+                uint16_t in_tail[CCL_COMP_FP16_VEC_COUNT] = {};
+                float out_tail[CCL_COMP_FP16_VEC_COUNT];
+                memcpy(in_tail, in + vec_limit, (count - vec_limit) * sizeof(uint16_t));
+                ccl_convert_fp16_to_fp32(in_tail, out_tail);
+                memcpy(out_buf + vec_limit, out_tail, (count - vec_limit) * sizeof(float));
+            }
+            break;
+        }
+        default: CCL_FATAL("unexpected value ", dtype); break;
+    }
+}
+
+static void ccl_comp_convert_from_fp32(const float* in_buf,
+                                       void* out_buf,
+                                       size_t count,
+                                       ccl::datatype dtype) {
+    switch (dtype) {
+        case ccl::datatype::bfloat16:
+            ccl_convert_fp32_to_bf16_arrays(const_cast<float*>(in_buf), out_buf, count);
+            break;
+        case ccl::datatype::float16: {
+            uint16_t* out = static_cast<uint16_t*>(out_buf);
+            size_t vec_limit = count / CCL_COMP_FP16_VEC_COUNT * CCL_COMP_FP16_VEC_COUNT;
+            for (size_t i = 0; i < vec_limit; i += CCL_COMP_FP16_VEC_COUNT) {
+                ccl_convert_fp32_to_fp16(in_buf + i, out + i);
+            }
+            if (vec_limit < count) {
+                float in_tail[CCL_COMP_FP16_VEC_COUNT] = {};
+                uint16_t out_tail[CCL_COMP_FP16_VEC_COUNT];
+                memcpy(in_tail, in_buf + vec_limit, (count - vec_limit) * sizeof(float));
+                ccl_convert_fp32_to_fp16(in_tail, out_tail);
+                memcpy(out + vec_limit, out_tail, (count - vec_limit) * sizeof(uint16_t));
+            }
+            break;
+        }
+        default: CCL_FATAL("unexpected value ", dtype); break;
+    }
+}
+
+#define CCL_COMP_SCALE(type, ptr) \
+    do { \
+        type* buf_##type = (type*)(ptr); \
+        const type divisor_##type = (type)divisor; \
+        for (size_t i = 0; i < count; i++) { \
+            buf_##type[i] /= divisor_##type; \
+        } \
+    } while (0)
+
+static void ccl_comp_scale(void* buf, size_t count, ccl::datatype dtype, size_t divisor) {
+    CCL_ASSERT(count <= CCL_COMP_BLOCK_COUNT, "unexpected count ", count);
+    switch (dtype) {
+        case ccl::datatype::float32: CCL_COMP_SCALE(float, buf); break;
+        case ccl::datatype::float64: CCL_COMP_SCALE(double, buf); break;
+        case ccl::datatype::bfloat16:
+        case ccl::datatype::float16: {
+            float tmp[CCL_COMP_BLOCK_COUNT];
+            ccl_comp_convert_to_fp32(buf, tmp, count, dtype);
+            CCL_COMP_SCALE(float, tmp);
+            ccl_comp_convert_from_fp32(tmp, buf, count, dtype);
+            break;
+        }
+        default: CCL_FATAL("unexpected value ", dtype); break;
+    }
+}
+
 ccl::status ccl_comp_reduce_regular(const void* in_buf,
                                     size_t in_count,
                                     void* inout_buf,
@@ -80,18 +167,64 @@ ccl::status ccl_comp_reduce_regular(const void* in_buf,
                                     const ccl_datatype& dtype,
                                     ccl::reduction reduction,
                                     ccl::reduction_fn reduction_fn,
-                                    const ccl::fn_context* context) {
+                                    const ccl::fn_context* context,
+                                    size_t avg_divisor = 1) {
     if (reduction == ccl::reduction::custom) {
         CCL_THROW_IF_NOT(reduction_fn, "custom reduction requires user callback");
         reduction_fn(in_buf, in_count, inout_buf, out_count, dtype.idx(), context);
         return ccl::status::success;
     }
 
+    if (reduction == ccl::reduction::avg) {
+        if (avg_divisor <= 1) {
+            return ccl_comp_reduce_regular(in_buf,
+                                           in_count,
+                                           inout_buf,
+                                           out_count,
+                                           dtype,
+                                           ccl::reduction::sum,
+                                           nullptr,
+                                           nullptr);
+        }
+
+        /* sum and divide block by block to avoid the separate pass over inout_buf */
+        size_t dtype_size = dtype.size();
+        for (size_t offset = 0; offset < in_count; offset += CCL_COMP_BLOCK_COUNT) {
+            size_t block_count = std::min((size_t)CCL_COMP_BLOCK_COUNT, in_count - offset);
+            void* block_buf = (char*)inout_buf + offset * dtype_size;
+            ccl_comp_reduce_regular((const char*)in_buf + offset * dtype_size,
+                                    block_count,
+                                    block_buf,
+                                    nullptr,
+                                    dtype,
+                                    ccl::reduction::sum,
+                                    nullptr,
+                                    nullptr);
+            ccl_comp_scale(block_buf, block_count, dtype.idx(), avg_divisor);
+        }
+
+        if (out_count) {
+            *out_count = in_count;
+        }
+        return ccl::status::success;
+    }
+
 #ifdef CCL_ENABLE_ITT
     __itt_event comp_reduce_itt_event = ccl::profile::itt::event_get("comp_reduce_regular");
     ccl::profile::itt::event_start(comp_reduce_itt_event);
 #endif // CCL_ENABLE_ITT
 
+    if ((ccl::global_data::env().simd_impl_type != ccl_simd_scalar) &&
+        ccl_simd_is_supported_dtype(dtype.idx())) {
+        ccl_simd_reduce(in_buf, in_count, inout_buf, out_count, dtype.idx(), reduction);
+
+#ifdef CCL_ENABLE_ITT
+        ccl::profile::itt::event_end(comp_reduce_itt_event);
+#endif // CCL_ENABLE_ITT
+
+        return ccl::status::success;
+    }
+
     size_t i;
     switch (dtype.idx()) {
         case ccl::datatype::int8: CCL_REDUCE(int8_t); break;
@@ -128,7 +261,8 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
                             const ccl_datatype& dtype,
                             ccl::reduction reduction,
                             ccl::reduction_fn reduction_fn,
-                            const ccl::fn_context* context) {
+                            const ccl::fn_context* context,
+                            size_t avg_divisor) {
     if (!in_count) {
         return ccl::status::success;
     }
@@ -137,8 +271,15 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
     ccl_stream* stream = (ccl_stream*)sched->coll_param.stream;
 
     if (!stream) {
-        return ccl_comp_reduce_regular(
-            in_buf, in_count, inout_buf, out_count, dtype, reduction, reduction_fn, context);
+        return ccl_comp_reduce_regular(in_buf,
+                                       in_count,
+                                       inout_buf,
+                                       out_count,
+                                       dtype,
+                                       reduction,
+                                       reduction_fn,
+                                       context,
+                                       avg_divisor);
     }
 
     sycl::queue* q = stream->get_native_stream(sched->queue->get_idx());
@@ -156,8 +297,15 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
               in_count)
 
     if ((in_ptr_type != sycl::usm::alloc::device) && (inout_ptr_type != sycl::usm::alloc::device)) {
-        return ccl_comp_reduce_regular(
-            in_buf, in_count, inout_buf, out_count, dtype, reduction, reduction_fn, context);
+        return ccl_comp_reduce_regular(in_buf,
+                                       in_count,
+                                       inout_buf,
+                                       out_count,
+                                       dtype,
+                                       reduction,
+                                       reduction_fn,
+                                       context,
+                                       avg_divisor);
     }
 
     void* host_in_buf = (void*)in_buf;
@@ -177,8 +325,15 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
         q->memcpy(host_inout_buf, inout_buf, bytes).wait();
     }
 
-    ccl_comp_reduce_regular(
-        host_in_buf, in_count, host_inout_buf, out_count, dtype, reduction, reduction_fn, context);
+    ccl_comp_reduce_regular(host_in_buf,
+                            in_count,
+                            host_inout_buf,
+                            out_count,
+                            dtype,
+                            reduction,
+                            reduction_fn,
+                            context,
+                            avg_divisor);
 
     if (host_in_buf != in_buf) {
         dealloc_param.ptr = host_in_buf;
@@ -194,11 +349,162 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
     return ccl::status::success;
 
 #else // CCL_ENABLE_SYCL
-    return ccl_comp_reduce_regular(
-        in_buf, in_count, inout_buf, out_count, dtype, reduction, reduction_fn, context);
+    return ccl_comp_reduce_regular(in_buf,
+                                   in_count,
+                                   inout_buf,
+                                   out_count,
+                                   dtype,
+                                   reduction,
+                                   reduction_fn,
+                                   context,
+                                   avg_divisor);
 #endif // CCL_ENABLE_SYCL
 }
 
+ccl::status ccl_comp_reduce_n(ccl_sched* sched,
+                              const void* const* in_bufs,
+                              size_t in_buf_count,
+                              size_t in_count,
+                              void* inout_buf,
+                              const ccl_datatype& dtype,
+                              ccl::reduction reduction,
+                              ccl::reduction_fn reduction_fn,
+                              const ccl::fn_context* context,
+                              size_t avg_divisor) {
+    if (!in_count || !in_buf_count) {
+        return ccl::status::success;
+    }
+
+    bool use_fused = (reduction != ccl::reduction::custom) &&
+                     (ccl::global_data::env().simd_impl_type != ccl_simd_scalar) &&
+                     ccl_simd_is_supported_dtype(dtype.idx());
+#ifdef CCL_ENABLE_SYCL
+    // device buffers are handled by ccl_comp_reduce
+    use_fused = use_fused && !sched->coll_param.stream;
+#endif // CCL_ENABLE_SYCL
+
+    if (!use_fused) {
+        for (size_t idx = 0; idx < in_buf_count; idx++) {
+            ccl_comp_reduce(sched,
+                            in_bufs[idx],
+                            in_count,
+                            inout_buf,
+                            nullptr,
+                            dtype,
+                            reduction,
+                            reduction_fn,
+                            context,
+                            (idx == in_buf_count - 1) ? avg_divisor : 1);
+        }
+        return ccl::status::success;
+    }
+
+#ifdef CCL_ENABLE_ITT
+    __itt_event comp_reduce_itt_event = ccl::profile::itt::event_get("comp_reduce_n");
+    ccl::profile::itt::event_start(comp_reduce_itt_event);
+#endif // CCL_ENABLE_ITT
+
+    if (reduction == ccl::reduction::avg && avg_divisor > 1) {
+        size_t dtype_size = dtype.size();
+        std::vector<const void*> block_bufs(in_buf_count);
+        for (size_t offset = 0; offset < in_count; offset += CCL_COMP_BLOCK_COUNT) {
+            size_t block_count = std::min((size_t)CCL_COMP_BLOCK_COUNT, in_count - offset);
+            for (size_t idx = 0; idx < in_buf_count; idx++) {
+                block_bufs[idx] = (const char*)in_bufs[idx] + offset * dtype_size;
+            }
+            void* block_buf = (char*)inout_buf + offset * dtype_size;
+            ccl_simd_reduce_n(block_bufs.data(),
+                              in_buf_count,
+                              block_count,
+                              block_buf,
+                              dtype.idx(),
+                              ccl::reduction::sum);
+            ccl_comp_scale(block_buf, block_count, dtype.idx(), avg_divisor);
+        }
+    }
+    else {
+        ccl_simd_reduce_n(in_bufs,
+                          in_buf_count,
+                          in_count,
+                          inout_buf,
+                          dtype.idx(),
+                          (reduction == ccl::reduction::avg) ? ccl::reduction::sum : reduction);
+    }
+
+#ifdef CCL_ENABLE_ITT
+    ccl::profile::itt::event_end(comp_reduce_itt_event);
+#endif // CCL_ENABLE_ITT
+
+    return ccl::status::success;
+}
+
+ccl::status ccl_comp_compress(void* in_buf,
+                              void* wire_buf,
+                              size_t count,
+                              ccl::datatype wire_dtype,
+                              bool round_in_buf) {
+    float* in = static_cast<float*>(in_buf);
+    char* wire = static_cast<char*>(wire_buf);
+    size_t wire_dtype_size = ccl::global_data::get().dtypes->get(wire_dtype).size();
+
+    for (size_t offset = 0; offset < count; offset += CCL_COMP_BLOCK_COUNT) {
+        size_t block_count = std::min((size_t)CCL_COMP_BLOCK_COUNT, count - offset);
+        void* block_wire = wire + offset * wire_dtype_size;
+        ccl_comp_convert_from_fp32(in + offset, block_wire, block_count, wire_dtype);
+        if (round_in_buf) {
+            ccl_comp_convert_to_fp32(block_wire, in + offset, block_count, wire_dtype);
+        }
+    }
+
+    return ccl::status::success;
+}
+
+ccl::status ccl_comp_decompress(const void* wire_buf,
+                                void* out_buf,
+                                size_t count,
+                                ccl::datatype wire_dtype) {
+    ccl_comp_convert_to_fp32(wire_buf, static_cast<float*>(out_buf), count, wire_dtype);
+    return ccl::status::success;
+}
+
+ccl::status ccl_comp_reduce_compressed(const void* wire_buf,
+                                       const void* in_buf,
+                                       void* out_buf,
+                                       size_t count,
+                                       ccl::datatype wire_dtype,
+                                       ccl::reduction reduction,
+                                       size_t avg_divisor) {
+    const char* wire = static_cast<const char*>(wire_buf);
+    const float* in = static_cast<const float*>(in_buf);
+    float* out = static_cast<float*>(out_buf);
+    size_t wire_dtype_size = ccl::global_data::get().dtypes->get(wire_dtype).size();
+    CCL_THROW_IF_NOT(reduction == ccl::reduction::sum || reduction == ccl::reduction::avg,
+                     "unexpected reduction for compressed data: ",
+                     ccl_reduction_to_str(reduction));
+    float divisor = (reduction == ccl::reduction::avg) ? (float)avg_divisor : 1.0f;
+
+    float tmp[CCL_COMP_BLOCK_COUNT];
+    for (size_t offset = 0; offset < count; offset += CCL_COMP_BLOCK_COUNT) {
+        size_t block_count = std::min((size_t)CCL_COMP_BLOCK_COUNT, count - offset);
+        ccl_comp_convert_to_fp32(wire + offset * wire_dtype_size, tmp, block_count, wire_dtype);
+
+        const float* block_in = in + offset;
+        float* block_out = out + offset;
+        if (divisor > 1.0f) {
+            for (size_t i = 0; i < block_count; i++) {
+                block_out[i] = (block_in[i] + tmp[i]) / divisor;
+            }
+        }
+        else {
+            for (size_t i = 0; i < block_count; i++) {
+                block_out[i] = block_in[i] + tmp[i];
+            }
+        }
+    }
+
+    return ccl::status::success;
+}
+
 ccl::status ccl_comp_batch_reduce(const void* in_buf,
                                   const std::vector<size_t>& offsets,
                                   size_t in_count,
@@ -254,6 +560,7 @@ const char* ccl_reduction_to_str(ccl::reduction type) {
         case ccl::reduction::prod: return "prod";
         case ccl::reduction::min: return "min";
         case ccl::reduction::max: return "max";
+        case ccl::reduction::avg: return "avg";
         case ccl::reduction::custom: return "custom";
         default: return "unknown";
     }
@@ -25,6 +25,8 @@ ccl::status ccl_comp_copy(const void* in_buf,
                           size_t count,
                           bool use_nontemporal = false);
 
+// reduction::avg is computed as sum, the last reduction step passes the number of
+// contributions as avg_divisor to get the result divided in the same pass
 ccl::status ccl_comp_reduce(ccl_sched* sched,
                             const void* in_buf,
                             size_t in_count,
@@ -33,7 +35,44 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
                             const ccl_datatype& dtype,
                             ccl::reduction reduction,
                             ccl::reduction_fn reduction_fn,
-                            const ccl::fn_context* context = nullptr);
+                            const ccl::fn_context* context = nullptr,
+                            size_t avg_divisor = 1);
+
+// inout_buf = reduction(inout_buf, in_bufs[0], ..., in_bufs[in_buf_count - 1])
+ccl::status ccl_comp_reduce_n(ccl_sched* sched,
+                              const void* const* in_bufs,
+                              size_t in_buf_count,
+                              size_t in_count,
+                              void* inout_buf,
+                              const ccl_datatype& dtype,
+                              ccl::reduction reduction,
+                              ccl::reduction_fn reduction_fn,
+                              const ccl::fn_context* context = nullptr,
+                              size_t avg_divisor = 1);
+
+// float32 data sent in 16-bit wire format (bfloat16 or float16), processed in cache-sized blocks
+
+// wire_buf = convert(in_buf), in_buf gets the rounded values if round_in_buf is set
+ccl::status ccl_comp_compress(void* in_buf,
+                              void* wire_buf,
+                              size_t count,
+                              ccl::datatype wire_dtype,
+                              bool round_in_buf = false);
+
+// out_buf = convert(wire_buf)
+ccl::status ccl_comp_decompress(const void* wire_buf,
+                                void* out_buf,
+                                size_t count,
+                                ccl::datatype wire_dtype);
+
+// out_buf = in_buf + convert(wire_buf) for sum or avg, out_buf may be the same as in_buf
+ccl::status ccl_comp_reduce_compressed(const void* wire_buf,
+                                       const void* in_buf,
+                                       void* out_buf,
+                                       size_t count,
+                                       ccl::datatype wire_dtype,
+                                       ccl::reduction reduction,
+                                       size_t avg_divisor = 1);
 
 ccl::status ccl_comp_batch_reduce(const void* in_buf,
                                   const std::vector<size_t>& offsets,
@@ -0,0 +1,364 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "oneapi/ccl/types.hpp"
+#include "common/global/global.hpp"
+#include "common/log/log.hpp"
+#include "comp/simd/simd.hpp"
+#include "comp/simd/simd_utils.hpp"
+#include "common/utils/enums.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef CCL_AVX_COMPILER
+#include <immintrin.h>
+#endif // CCL_AVX_COMPILER
+
+std::map<ccl_simd_impl_type, std::string> simd_impl_names = {
+    std::make_pair(ccl_simd_scalar, "scalar"),
+    std::make_pair(ccl_simd_sse42, "sse42"),
+    std::make_pair(ccl_simd_avx2, "avx2"),
+    std::make_pair(ccl_simd_avx512f, "avx512f")
+};
+
+bool ccl_simd_is_supported_dtype(ccl::datatype dtype) {
+    switch (dtype) {
+        case ccl::datatype::int8:
+        case ccl::datatype::uint8:
+        case ccl::datatype::int16:
+        case ccl::datatype::uint16:
+        case ccl::datatype::int32:
+        case ccl::datatype::uint32:
+        case ccl::datatype::int64:
+        case ccl::datatype::uint64:
+        case ccl::datatype::float32:
+        case ccl::datatype::float64: return true;
+        default: return false;
+    }
+}
+
+#ifdef CCL_AVX_COMPILER
+
+#ifdef CCL_AVX_TARGET_ATTRIBUTES
+#define SIMD_TARGET_ATTRIBUTE_SSE42   __attribute__((target("sse4.2")))
+#define SIMD_TARGET_ATTRIBUTE_AVX2    __attribute__((target("avx2")))
+#define SIMD_TARGET_ATTRIBUTE_AVX512F __attribute__((target("avx512f,avx512bw")))
+#else // CCL_AVX_TARGET_ATTRIBUTES
+#define SIMD_TARGET_ATTRIBUTE_SSE42
+#define SIMD_TARGET_ATTRIBUTE_AVX2
+#define SIMD_TARGET_ATTRIBUTE_AVX512F
+#endif // CCL_AVX_TARGET_ATTRIBUTES
+
+#define CCL_SIMD_UNROLL 4
+
+/* a - in, b - inout, the same semantics as std::min/std::max in CCL_REDUCE */
+#define CCL_SIMD_SUM(a, b)  ((a) + (b))
+#define CCL_SIMD_PROD(a, b) ((a) * (b))
+#define CCL_SIMD_MIN(a, b)  (((b) < (a)) ? (b) : (a))
+#define CCL_SIMD_MAX(a, b)  (((a) < (b)) ? (b) : (a))
+
+#define CCL_SIMD_STORE(nt_store, ptr, val) \
+    do { \
+        if (use_nt) { \
+            nt_store(ptr, val); \
+        } \
+        else { \
+            memcpy(ptr, &val, sizeof(val)); \
+        } \
+    } while (0)
+
+/*
+ * scalar head until inout is aligned to vector width, unrolled vector body
+ * with aligned stores into inout, then vector and scalar tails
+ */
+#define CCL_SIMD_REDUCE_LOOP(vec_type, op, nt_store) \
+    do { \
+        const size_t vec_len = sizeof(vec_type) / sizeof(T); \
+        size_t i = 0; \
+        size_t peel = ((sizeof(vec_type) - ((uintptr_t)inout % sizeof(vec_type))) % \
+                       sizeof(vec_type)) / \
+                      sizeof(T); \
+        if ((uintptr_t)inout % sizeof(T)) { \
+            peel = count; \
+        } \
+        peel = std::min(peel, count); \
+        for (; i < peel; i++) { \
+            inout[i] = op(in[i], inout[i]); \
+        } \
+        for (; i + CCL_SIMD_UNROLL * vec_len <= count; i += CCL_SIMD_UNROLL * vec_len) { \
+            vec_type a0, a1, a2, a3, b0, b1, b2, b3; \
+            memcpy(&a0, in + i + 0 * vec_len, sizeof(vec_type)); \
+            memcpy(&a1, in + i + 1 * vec_len, sizeof(vec_type)); \
+            memcpy(&a2, in + i + 2 * vec_len, sizeof(vec_type)); \
+            memcpy(&a3, in + i + 3 * vec_len, sizeof(vec_type)); \
+            memcpy(&b0, inout + i + 0 * vec_len, sizeof(vec_type)); \
+            memcpy(&b1, inout + i + 1 * vec_len, sizeof(vec_type)); \
+            memcpy(&b2, inout + i + 2 * vec_len, sizeof(vec_type)); \
+            memcpy(&b3, inout + i + 3 * vec_len, sizeof(vec_type)); \
+            b0 = op(a0, b0); \
+            b1 = op(a1, b1); \
+            b2 = op(a2, b2); \
+            b3 = op(a3, b3); \
+            CCL_SIMD_STORE(nt_store, inout + i + 0 * vec_len, b0); \
+            CCL_SIMD_STORE(nt_store, inout + i + 1 * vec_len, b1); \
+            CCL_SIMD_STORE(nt_store, inout + i + 2 * vec_len, b2); \
+            CCL_SIMD_STORE(nt_store, inout + i + 3 * vec_len, b3); \
+        } \
+        for (; i + vec_len <= count; i += vec_len) { \
+            vec_type a0, b0; \
+            memcpy(&a0, in + i, sizeof(vec_type)); \
+            memcpy(&b0, inout + i, sizeof(vec_type)); \
+            b0 = op(a0, b0); \
+            CCL_SIMD_STORE(nt_store, inout + i, b0); \
+        } \
+        for (; i < count; i++) { \
+            inout[i] = op(in[i], inout[i]); \
+        } \
+    } while (0)
+
+/*
+ * the same as CCL_SIMD_REDUCE_LOOP, but accumulates all inputs in registers
+ * so that inout is read and written only once
+ */
+#define CCL_SIMD_REDUCE_N_LOOP(vec_type, op, nt_store) \
+    do { \
+        const size_t vec_len = sizeof(vec_type) / sizeof(T); \
+        size_t i = 0; \
+        size_t peel = ((sizeof(vec_type) - ((uintptr_t)inout % sizeof(vec_type))) % \
+                       sizeof(vec_type)) / \
+                      sizeof(T); \
+        if ((uintptr_t)inout % sizeof(T)) { \
+            peel = count; \
+        } \
+        peel = std::min(peel, count); \
+        for (; i < peel; i++) { \
+            T acc = inout[i]; \
+            for (size_t k = 0; k < in_buf_count; k++) { \
+                acc = op(in[k][i], acc); \
+            } \
+            inout[i] = acc; \
+        } \
+        for (; i + CCL_SIMD_UNROLL * vec_len <= count; i += CCL_SIMD_UNROLL * vec_len) { \
+            vec_type a0, a1, a2, a3, b0, b1, b2, b3; \
+            memcpy(&b0, inout + i + 0 * vec_len, sizeof(vec_type)); \
+            memcpy(&b1, inout + i + 1 * vec_len, sizeof(vec_type)); \
+            memcpy(&b2, inout + i + 2 * vec_len, sizeof(vec_type)); \
+            memcpy(&b3, inout + i + 3 * vec_len, sizeof(vec_type)); \
+            for (size_t k = 0; k < in_buf_count; k++) { \
+                memcpy(&a0, in[k] + i + 0 * vec_len, sizeof(vec_type)); \
+                memcpy(&a1, in[k] + i + 1 * vec_len, sizeof(vec_type)); \
+                memcpy(&a2, in[k] + i + 2 * vec_len, sizeof(vec_type)); \
+                memcpy(&a3, in[k] + i + 3 * vec_len, sizeof(vec_type)); \
+                b0 = op(a0, b0); \
+                b1 = op(a1, b1); \
+                b2 = op(a2, b2); \
+                b3 = op(a3, b3); \
+            } \
+            CCL_SIMD_STORE(nt_store, inout + i + 0 * vec_len, b0); \
+            CCL_SIMD_STORE(nt_store, inout + i + 1 * vec_len, b1); \
+            CCL_SIMD_STORE(nt_store, inout + i + 2 * vec_len, b2); \
+            CCL_SIMD_STORE(nt_store, inout + i + 3 * vec_len, b3); \
+        } \
+        for (; i + vec_len <= count; i += vec_len) { \
+            vec_type a0, b0; \
+            memcpy(&b0, inout + i, sizeof(vec_type)); \
+            for (size_t k = 0; k < in_buf_count; k++) { \
+                memcpy(&a0, in[k] + i, sizeof(vec_type)); \
+                b0 = op(a0, b0); \
+            } \
+            CCL_SIMD_STORE(nt_store, inout + i, b0); \
+        } \
+        for (; i < count; i++) { \
+            T acc = inout[i]; \
+            for (size_t k = 0; k < in_buf_count; k++) { \
+                acc = op(in[k][i], acc); \
+            } \
+            inout[i] = acc; \
+        } \
+    } while (0)
+
+#define CCL_SIMD_DEFINE_REDUCE_FUNC(impl_type, target_attr, vec_bytes, nt_store) \
+\
+    template <class T, bool use_nt> \
+    target_attr void ccl_simd_reduce_impl_##impl_type( \
+        const T* in, T* inout, size_t count, ccl::reduction op) { \
+        typedef T vec_t __attribute__((vector_size(vec_bytes))); \
+        switch (op) { \
+            case ccl::reduction::sum: CCL_SIMD_REDUCE_LOOP(vec_t, CCL_SIMD_SUM, nt_store); break; \
+            case ccl::reduction::prod: \
+                CCL_SIMD_REDUCE_LOOP(vec_t, CCL_SIMD_PROD, nt_store); \
+                break; \
+            case ccl::reduction::min: CCL_SIMD_REDUCE_LOOP(vec_t, CCL_SIMD_MIN, nt_store); break; \
+            case ccl::reduction::max: CCL_SIMD_REDUCE_LOOP(vec_t, CCL_SIMD_MAX, nt_store); break; \
+            default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(op)); \
+        } \
+        if (use_nt) { \
+            _mm_sfence(); \
+        } \
+    } \
+\
+    template <class T, bool use_nt> \
+    target_attr void ccl_simd_reduce_n_impl_##impl_type(const T* const* in, \
+                                                        size_t in_buf_count, \
+                                                        T* inout, \
+                                                        size_t count, \
+                                                        ccl::reduction op) { \
+        typedef T vec_t __attribute__((vector_size(vec_bytes))); \
+        switch (op) { \
+            case ccl::reduction::sum: CCL_SIMD_REDUCE_N_LOOP(vec_t, CCL_SIMD_SUM, nt_store); break; \
+            case ccl::reduction::prod: \
+                CCL_SIMD_REDUCE_N_LOOP(vec_t, CCL_SIMD_PROD, nt_store); \
+                break; \
+            case ccl::reduction::min: CCL_SIMD_REDUCE_N_LOOP(vec_t, CCL_SIMD_MIN, nt_store); break; \
+            case ccl::reduction::max: CCL_SIMD_REDUCE_N_LOOP(vec_t, CCL_SIMD_MAX, nt_store); break; \
+            default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(op)); \
+        } \
+        if (use_nt) { \
+            _mm_sfence(); \
+        } \
+    }
+
+#define CCL_SIMD_NT_STORE_SSE42(ptr, val)   _mm_stream_si128((__m128i*)(ptr), (__m128i)(val))
+#define CCL_SIMD_NT_STORE_AVX2(ptr, val)    _mm256_stream_si256((__m256i*)(ptr), (__m256i)(val))
+#define CCL_SIMD_NT_STORE_AVX512F(ptr, val) _mm512_stream_si512((__m512i*)(ptr), (__m512i)(val))
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(sse42, SIMD_TARGET_ATTRIBUTE_SSE42, 16, CCL_SIMD_NT_STORE_SSE42);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, SIMD_TARGET_ATTRIBUTE_AVX2, 32, CCL_SIMD_NT_STORE_AVX2);
+#ifdef CCL_BF16_COMPILER
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512f, SIMD_TARGET_ATTRIBUTE_AVX512F, 64, CCL_SIMD_NT_STORE_AVX512F);
+#endif // CCL_BF16_COMPILER
+
+#define CCL_SIMD_REDUCE_CALL(func, impl_type, ...) \
+    do { \
+        if (use_nt) { \
+            func##_##impl_type<T, true>(__VA_ARGS__); \
+        } \
+        else { \
+            func##_##impl_type<T, false>(__VA_ARGS__); \
+        } \
+    } while (0)
+
+#ifdef CCL_BF16_COMPILER
+#define CCL_SIMD_DISPATCH_AVX512F(func, ...) \
+    else if (impl_type == ccl_simd_avx512f) { \
+        CCL_SIMD_REDUCE_CALL(func, avx512f, __VA_ARGS__); \
+    }
+#else // CCL_BF16_COMPILER
+#define CCL_SIMD_DISPATCH_AVX512F(func, ...)
+#endif // CCL_BF16_COMPILER
+
+#define CCL_SIMD_DISPATCH(func, ...) \
+    do { \
+        auto impl_type = ccl::global_data::env().simd_impl_type; \
+        if (impl_type == ccl_simd_sse42) { \
+            CCL_SIMD_REDUCE_CALL(func, sse42, __VA_ARGS__); \
+        } \
+        else if (impl_type == ccl_simd_avx2) { \
+            CCL_SIMD_REDUCE_CALL(func, avx2, __VA_ARGS__); \
+        } \
+        CCL_SIMD_DISPATCH_AVX512F(func, __VA_ARGS__) \
+        else { \
+            CCL_THROW("unexpected simd_impl_type: ", impl_type); \
+        } \
+    } while (0)
+
+template <class T>
+void ccl_simd_reduce_impl(const void* in_buf, void* inout_buf, size_t count, ccl::reduction op) {
+    const T* in = (const T*)in_buf;
+    T* inout = (T*)inout_buf;
+    bool use_nt = (count * sizeof(T) >= CCL_SIMD_NT_STORE_THRESHOLD);
+
+    CCL_SIMD_DISPATCH(ccl_simd_reduce_impl, in, inout, count, op);
+}
+
+template <class T>
+void ccl_simd_reduce_n_impl(const void* const* in_bufs,
+                            size_t in_buf_count,
+                            void* inout_buf,
+                            size_t count,
+                            ccl::reduction op) {
+    const T* const* in = (const T* const*)in_bufs;
+    T* inout = (T*)inout_buf;
+    bool use_nt = (count * sizeof(T) >= CCL_SIMD_NT_STORE_THRESHOLD);
+
+    CCL_SIMD_DISPATCH(ccl_simd_reduce_n_impl, in, in_buf_count, inout, count, op);
+}
+
+#define CCL_SIMD_DTYPE_DISPATCH(func, dtype, ...) \
+    do { \
+        switch (dtype) { \
+            case ccl::datatype::int8: func<int8_t>(__VA_ARGS__); break; \
+            case ccl::datatype::uint8: func<uint8_t>(__VA_ARGS__); break; \
+            case ccl::datatype::int16: func<int16_t>(__VA_ARGS__); break; \
+            case ccl::datatype::uint16: func<uint16_t>(__VA_ARGS__); break; \
+            case ccl::datatype::int32: func<int32_t>(__VA_ARGS__); break; \
+            case ccl::datatype::uint32: func<uint32_t>(__VA_ARGS__); break; \
+            case ccl::datatype::int64: func<int64_t>(__VA_ARGS__); break; \
+            case ccl::datatype::uint64: func<uint64_t>(__VA_ARGS__); break; \
+            case ccl::datatype::float32: func<float>(__VA_ARGS__); break; \
+            case ccl::datatype::float64: func<double>(__VA_ARGS__); break; \
+            default: CCL_FATAL("unexpected value ", dtype); break; \
+        } \
+    } while (0)
+
+void ccl_simd_reduce(const void* in_buf,
+                     size_t in_cnt,
+                     void* inout_buf,
+                     size_t* out_cnt,
+                     ccl::datatype dtype,
+                     ccl::reduction op) {
+    LOG_DEBUG("SIMD reduction for ", in_cnt, " elements");
+
+    if (out_cnt != nullptr) {
+        *out_cnt = in_cnt;
+    }
+
+    CCL_SIMD_DTYPE_DISPATCH(ccl_simd_reduce_impl, dtype, in_buf, inout_buf, in_cnt, op);
+}
+
+void ccl_simd_reduce_n(const void* const* in_bufs,
+                       size_t in_buf_count,
+                       size_t in_cnt,
+                       void* inout_buf,
+                       ccl::datatype dtype,
+                       ccl::reduction op) {
+    LOG_DEBUG("SIMD reduction of ", in_buf_count, " inputs for ", in_cnt, " elements");
+
+    CCL_SIMD_DTYPE_DISPATCH(
+        ccl_simd_reduce_n_impl, dtype, in_bufs, in_buf_count, inout_buf, in_cnt, op);
+}
+
+#else // CCL_AVX_COMPILER
+
+void ccl_simd_reduce(const void* in_buf,
+                     size_t in_cnt,
+                     void* inout_buf,
+                     size_t* out_cnt,
+                     ccl::datatype dtype,
+                     ccl::reduction op) {
+    CCL_FATAL("SIMD reduction was requested but CCL was compiled w/o AVX support");
+}
+
+void ccl_simd_reduce_n(const void* const* in_bufs,
+                       size_t in_buf_count,
+                       size_t in_cnt,
+                       void* inout_buf,
+                       ccl::datatype dtype,
+                       ccl::reduction op) {
+    CCL_FATAL("SIMD reduction was requested but CCL was compiled w/o AVX support");
+}
+
+#endif // CCL_AVX_COMPILER
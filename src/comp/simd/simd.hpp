@@ -0,0 +1,38 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "oneapi/ccl/types.hpp"
+
+/* outputs larger than this are written with non-temporal stores */
+#define CCL_SIMD_NT_STORE_THRESHOLD (16 * 1024 * 1024)
+
+bool ccl_simd_is_supported_dtype(ccl::datatype dtype);
+
+void ccl_simd_reduce(const void* in_buf,
+                     size_t in_cnt,
+                     void* inout_buf,
+                     size_t* out_cnt,
+                     ccl::datatype dtype,
+                     ccl::reduction reduction_op);
+
+/* inout_buf = op(inout_buf, in_bufs[0], ..., in_bufs[in_buf_count - 1]) in a single pass */
+void ccl_simd_reduce_n(const void* const* in_bufs,
+                       size_t in_buf_count,
+                       size_t in_cnt,
+                       void* inout_buf,
+                       ccl::datatype dtype,
+                       ccl::reduction reduction_op);
@@ -0,0 +1,70 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <map>
+#include <set>
+#include <stdint.h>
+#include <string>
+
+typedef enum {
+    ccl_simd_scalar = 0,
+    ccl_simd_sse42,
+    ccl_simd_avx2,
+    ccl_simd_avx512f
+} ccl_simd_impl_type;
+
+extern std::map<ccl_simd_impl_type, std::string> simd_impl_names;
+
+__attribute__((__always_inline__)) inline std::set<ccl_simd_impl_type> ccl_simd_get_impl_types() {
+    std::set<ccl_simd_impl_type> result;
+
+    result.insert(ccl_simd_scalar);
+
+#ifdef CCL_AVX_COMPILER
+    int is_sse42_enabled = 0;
+    int is_avx2_enabled = 0;
+    int is_avx512f_enabled = 0;
+
+    uint32_t reg[4];
+
+    /* CPUID.(EAX=01H):ECX.SSE4_2 [bit 20] */
+    __asm__ __volatile__("cpuid" : "=a"(reg[0]), "=b"(reg[1]), "=c"(reg[2]), "=d"(reg[3]) : "a"(1));
+    is_sse42_enabled = (reg[2] & (1u << 20)) >> 20;
+
+    /* CPUID.(EAX=07H, ECX=0):EBX.AVX2     [bit 05] */
+    /* CPUID.(EAX=07H, ECX=0):EBX.AVX512F  [bit 16] */
+    /* CPUID.(EAX=07H, ECX=0):EBX.AVX512BW [bit 30] */
+    __asm__ __volatile__("cpuid"
+                         : "=a"(reg[0]), "=b"(reg[1]), "=c"(reg[2]), "=d"(reg[3])
+                         : "a"(7), "c"(0));
+    is_avx2_enabled = (reg[1] & (1u << 5)) >> 5;
+#ifdef CCL_BF16_COMPILER
+    is_avx512f_enabled = ((reg[1] & (1u << 16)) >> 16) & ((reg[1] & (1u << 30)) >> 30);
+#endif // CCL_BF16_COMPILER
+
+    if (is_sse42_enabled)
+        result.insert(ccl_simd_sse42);
+
+    if (is_avx2_enabled)
+        result.insert(ccl_simd_avx2);
+
+    if (is_avx512f_enabled)
+        result.insert(ccl_simd_avx512f);
+#endif // CCL_AVX_COMPILER
+
+    return result;
+}
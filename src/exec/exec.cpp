@@ -13,6 +13,7 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include <algorithm>
 #include <numeric>
 
 #include "exec/exec.hpp"
@@ -59,6 +60,9 @@ atl_attr_t ccl_executor::generate_atl_attr(const ccl::env_data& env) {
     attr.in.mnic_name = env.mnic_name_raw;
     attr.in.mnic_count = env.mnic_count;
     attr.in.mnic_offset = env.mnic_offset;
+    attr.in.mnic_stripe_size = env.mnic_stripe_size;
+    attr.in.mnic_stripe_weights = env.mnic_stripe_weights_raw;
+    attr.in.enable_cq_wait = env.worker_hybrid_wait;
 
     memset(&attr.out, 0, sizeof(attr.out));
 
@@ -124,6 +128,7 @@ void ccl_executor::start_workers(atl_proc_coord_t& coord) {
         else {
             workers.emplace_back(new ccl_worker(idx, create_sched_queue(idx, ep_per_worker)));
         }
+        workers.back()->set_executor(this);
 
         if (env.worker_offload) {
             size_t cpu_affinity =
@@ -168,7 +173,14 @@ ccl_executor::~ccl_executor() {
             else
                 LOG_DEBUG("stopped worker # ", idx);
         }
+    }
+
+    print_worker_stat();
+
+    /* running workers may access each other for stealing, so reset only after all are stopped */
+    workers_started = false;
 
+    for (size_t idx = 0; idx < workers.size(); idx++) {
         while (!workers[idx]->can_reset()) {
             ccl_yield(ccl::global_data::env().yield_type);
         }
@@ -312,3 +324,62 @@ void ccl_executor::update_wait_condition(size_t idx,
     CCL_THROW_IF_NOT(idx < workers.size(), "unexpected worker idx ", idx);
     workers[idx]->update_wait_condition(type, delta);
 }
+
+size_t ccl_executor::steal(size_t thief_idx, std::vector<ccl_sched*>& scheds) {
+    if (!workers_started)
+        return 0;
+
+    size_t worker_count = workers.size();
+    size_t victim_idx = thief_idx;
+    size_t max_pending_count = 0;
+
+    for (size_t offset = 1; offset < worker_count; offset++) {
+        size_t idx = (thief_idx + offset) % worker_count;
+        size_t pending_count = workers[idx]->get_pending_count();
+        if (pending_count > max_pending_count) {
+            max_pending_count = pending_count;
+            victim_idx = idx;
+        }
+    }
+
+    if (victim_idx == thief_idx)
+        return 0;
+
+    return workers[victim_idx]->steal(scheds);
+}
+
+void ccl_executor::print_worker_stat() const {
+    size_t total_processed = 0;
+    size_t max_processed = 0;
+
+    for (const auto& worker : workers) {
+        const auto& stat = worker->get_stat();
+        long double cpu_usage =
+            (stat.wall_time_usec > 0) ? (100 * stat.cpu_time_usec / stat.wall_time_usec) : 0;
+        LOG_INFO("worker ",
+                 worker->get_idx(),
+                 ": processed ",
+                 stat.processed,
+                 ", stolen ",
+                 stat.stolen,
+                 ", donated ",
+                 stat.donated.load(),
+                 ", latency p50/p99 <= ",
+                 stat.get_latency_percentile(0.5),
+                 "/",
+                 stat.get_latency_percentile(0.99),
+                 " usec, blocked ",
+                 stat.block_count,
+                 " times, cpu usage ",
+                 cpu_usage,
+                 "%");
+        total_processed += stat.processed;
+        max_processed = std::max(max_processed, stat.processed);
+    }
+
+    if ((workers.size() > 1) && total_processed) {
+        /* 1.0 means perfectly balanced workers */
+        double imbalance = static_cast<double>(max_processed * workers.size()) / total_processed;
+        LOG_INFO("worker load imbalance (max/avg processed scheds): ", imbalance);
+    }
+}
@@ -90,6 +90,10 @@ public:
                                ccl_base_thread::wait_data::update_type type,
                                size_t delta);
 
+    /* moves pending scheds of the most loaded worker to thief_idx worker */
+    size_t steal(size_t thief_idx, std::vector<ccl_sched*>& scheds);
+    void print_worker_stat() const;
+
     // TODO: Rework to support listener
     //    ccl::status create_listener(ccl_resize_fn_t resize_func);
     void update_workers();
@@ -110,7 +114,7 @@ private:
     // TODO: Rework to support listener
     //  std::unique_ptr<ccl_listener> listener;
 
-    bool workers_started = false;
+    std::atomic<bool> workers_started{ false };
 };
 
 inline void ccl_release_sched(ccl_sched* sched) {
@@ -20,11 +20,22 @@
 
 #include "sched/sched_timer.hpp"
 
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
 #define CCL_WORKER_CHECK_STOP_ITERS     (16384)
 #define CCL_WORKER_CHECK_UPDATE_ITERS   (16384)
 #define CCL_WORKER_CHECK_AFFINITY_ITERS (16384)
 #define CCL_WORKER_PROCESS_ALL_ITERS    (4096)
 
+/* hybrid wait tuning */
+#define CCL_WORKER_BLOCK_TIMEOUT_MS      (1)
+#define CCL_WORKER_SHORT_BLOCK_USEC      (50)
+#define CCL_WORKER_MIN_SPIN_COUNT        (16)
+#define CCL_WORKER_MAX_SPIN_COUNT_FACTOR (16)
+
 static void* ccl_worker_func(void* args);
 
 ccl_worker::ccl_worker(size_t idx, std::unique_ptr<ccl_sched_queue> queue)
@@ -32,8 +43,50 @@ ccl_worker::ccl_worker(size_t idx, std::unique_ptr<ccl_sched_queue> queue)
           should_lock(false),
           is_locked(false),
           process_atl(true),
+          use_steal(ccl::global_data::env().worker_steal &&
+                    ccl::global_data::env().worker_offload &&
+                    (ccl::global_data::env().worker_count > 1)),
+          use_hybrid_wait(ccl::global_data::env().worker_hybrid_wait),
+          spin_window(ccl::global_data::env().spin_count),
+          steal_sched_queue(std::unique_ptr<ccl_steal_sched_queue>(new ccl_steal_sched_queue())),
           strict_sched_queue(std::unique_ptr<ccl_strict_sched_queue>(new ccl_strict_sched_queue())),
-          sched_queue(std::move(queue)) {}
+          sched_queue(std::move(queue)) {
+    if (use_hybrid_wait) {
+        event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (event_fd < 0) {
+            LOG_WARN("worker ", idx, " can't create eventfd, disable hybrid wait");
+            use_hybrid_wait = false;
+        }
+    }
+}
+
+ccl_worker::~ccl_worker() {
+    steal_sched_queue.reset();
+    strict_sched_queue.reset();
+    sched_queue.reset();
+
+    if (event_fd >= 0)
+        close(event_fd);
+}
+
+size_t ccl_worker::stat_data::get_latency_percentile(double percentile) const {
+    size_t total = 0;
+    for (auto count : latency_hist)
+        total += count;
+
+    if (!total)
+        return 0;
+
+    size_t threshold = static_cast<size_t>(percentile * total);
+    size_t sum = 0;
+    for (size_t idx = 0; idx < latency_hist.size(); idx++) {
+        sum += latency_hist[idx];
+        if (sum > threshold || sum == total)
+            return (1UL << (idx + 1));
+    }
+
+    return (1UL << latency_hist.size());
+}
 
 void ccl_worker::add(ccl_sched* sched) {
     LOG_DEBUG("add sched ",
@@ -49,19 +102,53 @@ void ccl_worker::add(ccl_sched* sched) {
 
     update_wait_condition(ccl_base_thread::wait_data::update_type::increment, 1);
 
+    sched->worker_add_time = std::chrono::steady_clock::now();
+
     if (sched->strict_order) {
         /* to keep valid non-completed req until safe releasing */
         sched->get_request()->increase_counter(1);
         strict_sched_queue->add(sched);
     }
+    else if (use_steal && !sched->is_atl_ep_bound()) {
+        /* keep it stealable until this worker has a chance to start it */
+        steal_sched_queue->add(sched);
+    }
     else {
         sched_queue->add(sched);
     }
+
+    if (use_hybrid_wait) {
+        /* pairs with is_blocked check in hybrid_wait, either side sees the other's update */
+        add_count++;
+        if (is_blocked.load()) {
+            uint64_t value = 1;
+            ssize_t ret = write(event_fd, &value, sizeof(value));
+            CCL_UNUSED(ret);
+        }
+    }
+}
+
+size_t ccl_worker::steal(std::vector<ccl_sched*>& scheds) {
+    size_t count = steal_sched_queue->steal(scheds);
+    if (count) {
+        update_wait_condition(ccl_base_thread::wait_data::update_type::decrement, count);
+        stat.donated += count;
+    }
+    return count;
 }
 
 ccl::status ccl_worker::do_work(size_t& processed_count) {
     do_work_counter++;
 
+    if (use_hybrid_wait)
+        seen_add_count = add_count.load();
+
+    if (use_steal) {
+        auto ret = process_steal_sched_queue();
+        if (ret != ccl::status::success)
+            return ret;
+    }
+
     auto ret = process_strict_sched_queue();
     if (ret != ccl::status::success)
         return ret;
@@ -71,6 +158,8 @@ ccl::status ccl_worker::do_work(size_t& processed_count) {
     if (ret != ccl::status::success)
         return ret;
 
+    stat.processed += processed_count;
+
     if ((do_work_counter % (4 * CCL_WORKER_PROCESS_ALL_ITERS) == 0) &&
         ccl::global_data::env().queue_dump) {
         sched_queue->dump(std::cout);
@@ -79,6 +168,34 @@ ccl::status ccl_worker::do_work(size_t& processed_count) {
     return ccl::status::success;
 }
 
+ccl::status ccl_worker::process_steal_sched_queue() {
+    /* admit one pending sched per iteration, the rest stays available for idle workers */
+    ccl_sched* sched = steal_sched_queue->pop();
+    if (sched) {
+        sched_queue->add(sched);
+        return ccl::status::success;
+    }
+
+    if (sched_queue->peek())
+        return ccl::status::success;
+
+    std::vector<ccl_sched*> scheds;
+    /* global executor pointer is already cleared while executor stops workers */
+    size_t count = executor->steal(get_idx(), scheds);
+    if (!count)
+        return ccl::status::success;
+
+    LOG_DEBUG("worker ", get_idx(), " stole ", count, " scheds");
+
+    update_wait_condition(ccl_base_thread::wait_data::update_type::increment, count);
+    for (auto stolen_sched : scheds) {
+        sched_queue->add(stolen_sched);
+    }
+    stat.stolen += count;
+
+    return ccl::status::success;
+}
+
 ccl::status ccl_worker::process_strict_sched_queue() {
     auto& queue = strict_sched_queue->peek();
     if (queue.empty())
@@ -221,6 +338,7 @@ ccl::status ccl_worker::process_sched_bin(ccl_sched_bin* bin, size_t& completed_
             CCL_ASSERT(!sched->bin);
             bin_size--;
             LOG_DEBUG("completing request ", sched->get_request(), " for ", sched);
+            update_latency_stat(sched);
             sched->complete();
             ++completed_sched_count;
         }
@@ -234,7 +352,75 @@ ccl::status ccl_worker::process_sched_bin(ccl_sched_bin* bin, size_t& completed_
     return ccl::status::success;
 }
 
+void ccl_worker::update_latency_stat(ccl_sched* sched) {
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - sched->worker_add_time)
+                    .count();
+
+    size_t bucket = 0;
+    while ((usec >>= 1) && (bucket < stat.latency_hist.size() - 1))
+        bucket++;
+    stat.latency_hist[bucket]++;
+}
+
+void ccl_worker::hybrid_wait() {
+    is_blocked.store(true);
+
+    /* don't block if something was added since the last do_work */
+    if (add_count.load() != seen_add_count) {
+        is_blocked.store(false);
+        return;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    atl_status_t atl_status = ATL_STATUS_UNSUPPORTED;
+
+    ccl_sched_bin* bin = sched_queue->peek();
+    if (bin && bin->size()) {
+        auto atl_comm = bin->get(0)->coll_param.comm->get_atl_comm();
+        atl_status = atl_comm->wait_event(bin->get_atl_ep(), event_fd, CCL_WORKER_BLOCK_TIMEOUT_MS);
+        if (atl_status == ATL_STATUS_UNSUPPORTED) {
+            LOG_DEBUG("worker ", get_idx(), ": ATL has no wait object, disable hybrid wait");
+            is_atl_wait_supported = false;
+        }
+    }
+    else {
+        /* nothing is posted to ATL, only new scheds can make progress */
+        struct pollfd fd = { event_fd, POLLIN, 0 };
+        poll(&fd, 1, CCL_WORKER_BLOCK_TIMEOUT_MS);
+        atl_status = ATL_STATUS_SUCCESS;
+    }
+
+    is_blocked.store(false);
+
+    uint64_t value;
+    ssize_t ret = read(event_fd, &value, sizeof(value));
+    CCL_UNUSED(ret);
+
+    if (atl_status != ATL_STATUS_SUCCESS)
+        return;
+
+    stat.block_count++;
+
+    /*
+       short block means the event was close and spinning would be cheaper,
+       block for the full timeout means nothing was going on and spinning was waste
+    */
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start_time)
+                    .count();
+    size_t max_spin_window =
+        ccl::global_data::env().spin_count * CCL_WORKER_MAX_SPIN_COUNT_FACTOR;
+    if (usec < CCL_WORKER_SHORT_BLOCK_USEC) {
+        spin_window = std::min(spin_window * 2, max_spin_window);
+    }
+    else if (usec >= CCL_WORKER_BLOCK_TIMEOUT_MS * 1000) {
+        spin_window = std::max(spin_window / 2, (size_t)CCL_WORKER_MIN_SPIN_COUNT);
+    }
+}
+
 void ccl_worker::clear_queue() {
+    steal_sched_queue->clear();
     strict_sched_queue->clear();
     sched_queue->clear();
 }
@@ -272,6 +458,9 @@ bool ccl_worker::check_wait_condition(size_t iter) {
             return !cond;
         });
     }
+    else if (use_hybrid_wait && is_atl_wait_supported) {
+        hybrid_wait();
+    }
     else {
         ccl_yield(ccl::global_data::env().yield_type);
     }
@@ -331,8 +520,9 @@ static void* ccl_worker_func(void* args) {
 
     size_t iter = 0;
     size_t processed_count = 0;
-    size_t max_spin_count = ccl::global_data::env().spin_count;
-    size_t spin_count = max_spin_count;
+    size_t spin_count = worker->get_spin_count();
+
+    auto start_time = std::chrono::steady_clock::now();
 
     ccl::global_data::get().is_worker_thread = true;
 
@@ -369,10 +559,18 @@ static void* ccl_worker_func(void* args) {
             }
         }
         else {
-            spin_count = max_spin_count;
+            spin_count = worker->get_spin_count();
         }
     } while (true);
 
+    struct timespec cpu_time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time);
+    long double cpu_time_usec = cpu_time.tv_sec * 1000000.0L + cpu_time.tv_nsec / 1000.0L;
+    long double wall_time_usec = std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now() - start_time)
+                                     .count();
+    worker->set_thread_time_stat(cpu_time_usec, wall_time_usec);
+
     worker->started = false;
 
     return nullptr;
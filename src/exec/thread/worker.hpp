@@ -16,14 +16,19 @@
 #pragma once
 
 #include "exec/thread/base_thread.hpp"
+#include "sched/queue/steal_queue.hpp"
 #include "sched/queue/strict_queue.hpp"
 #include "sched/queue/queue.hpp"
 #include "internal_types.hpp"
 
+#include <array>
 #include <memory>
 #include <list>
 #include <pthread.h>
 
+/* log2 buckets of sched latency in usec */
+#define CCL_WORKER_LATENCY_HIST_SIZE (32)
+
 class ccl_executor;
 
 class ccl_worker : public ccl_base_thread {
@@ -33,10 +38,7 @@ public:
     ccl_worker& operator=(const ccl_worker& other) = delete;
     ccl_worker(size_t idx, std::unique_ptr<ccl_sched_queue> queue);
 
-    virtual ~ccl_worker() {
-        strict_sched_queue.reset();
-        sched_queue.reset();
-    }
+    virtual ~ccl_worker();
 
     virtual void* get_this() override {
         return static_cast<void*>(this);
@@ -49,6 +51,47 @@ public:
 
     void add(ccl_sched* sched);
 
+    /* owner of the worker, must outlive the worker thread */
+    void set_executor(ccl_executor* exec) {
+        executor = exec;
+    }
+
+    /* called by other workers to take pending scheds of this worker */
+    size_t steal(std::vector<ccl_sched*>& scheds);
+
+    size_t get_pending_count() const {
+        return steal_sched_queue->size();
+    }
+
+    struct stat_data {
+        size_t processed = 0; /* completed scheds */
+        size_t stolen = 0; /* scheds taken from other workers */
+        std::atomic<size_t> donated{ 0 }; /* scheds taken by other workers */
+
+        std::array<size_t, CCL_WORKER_LATENCY_HIST_SIZE> latency_hist{};
+        size_t block_count = 0; /* number of hybrid waits on ATL/eventfd */
+
+        /* filled by worker thread on exit */
+        long double cpu_time_usec = 0;
+        long double wall_time_usec = 0;
+
+        /* upper bound in usec of the given percentile of add-to-completion sched latency */
+        size_t get_latency_percentile(double percentile) const;
+    };
+
+    const stat_data& get_stat() const {
+        return stat;
+    }
+
+    void set_thread_time_stat(long double cpu_time_usec, long double wall_time_usec) {
+        stat.cpu_time_usec = cpu_time_usec;
+        stat.wall_time_usec = wall_time_usec;
+    }
+
+    size_t get_spin_count() const {
+        return spin_window;
+    }
+
     virtual ccl::status do_work(size_t& processed_count);
 
     void clear_queue();
@@ -69,12 +112,30 @@ public:
     bool check_stop_condition(size_t iter);
 
 private:
+    void hybrid_wait();
+    void update_latency_stat(ccl_sched* sched);
+
+    ccl::status process_steal_sched_queue();
     ccl::status process_strict_sched_queue();
     ccl::status process_sched_queue(size_t& processed_count, bool process_all);
     ccl::status process_sched_bin(ccl_sched_bin* bin, size_t& processed_count);
 
     size_t do_work_counter = 0;
 
+    bool use_steal;
+    ccl_executor* executor{ nullptr };
+    stat_data stat;
+
+    /* spin then block on ATL CQ or eventfd, spin window adapts to observed wait times */
+    bool use_hybrid_wait;
+    bool is_atl_wait_supported = true;
+    int event_fd = -1;
+    size_t spin_window;
+    std::atomic<bool> is_blocked{ false };
+    std::atomic<size_t> add_count{ 0 };
+    size_t seen_add_count = 0;
+
+    std::unique_ptr<ccl_steal_sched_queue> steal_sched_queue;
     std::unique_ptr<ccl_strict_sched_queue> strict_sched_queue;
     std::unique_ptr<ccl_sched_queue> sched_queue;
 };
@@ -13,6 +13,7 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include "atl/atl_base_comm.hpp"
 #include "exec/exec.hpp"
 #include "fusion/fusion.hpp"
 #include "sched/buffer/buffer_cache.hpp"
@@ -20,6 +21,9 @@
 #include "sched/entry/factory/entry_factory.hpp"
 
 #define CCL_FUSION_CHECK_SCHEDS_ITERS (1024)
+#define CCL_FUSION_MIN_BUFFER_SIZE    (4096)
+#define CCL_FUSION_BURST_GAP_FACTOR   (4)
+#define CCL_FUSION_BUCKET_IDLE_MS     (1000)
 
 ccl::status complete_user_request(const void* ctx) {
     ccl_sched* sched = (ccl_sched*)ctx;
@@ -60,7 +64,9 @@ ccl_fusion_manager::ccl_fusion_manager()
              ", count_threshold ",
              count_threshold,
              ", buffer_size ",
-             buffer_size);
+             buffer_size,
+             ", adaptive ",
+             ccl::global_data::env().fusion_adaptive);
 }
 
 ccl_fusion_manager::~ccl_fusion_manager() {
@@ -71,17 +77,24 @@ ccl_fusion_manager::~ccl_fusion_manager() {
              ", empty_exec_calls ",
              stat_empty_exec_calls,
              ", overlapped_exec_calls ",
-             stat_overlapped_exec_calls);
+             stat_overlapped_exec_calls,
+             ", threshold_flushes ",
+             stat_threshold_flushes,
+             ", urgent_flushes ",
+             stat_urgent_flushes,
+             ", adaptive_flushes ",
+             stat_adaptive_flushes);
 
     reset();
 
-    CCL_ASSERT(postponed_queue.empty() && exec_queue.empty() && tracked_scheds.empty(),
-               "queues are not empty, ",
-               postponed_queue.size(),
-               " ",
-               exec_queue.size(),
-               " ",
-               tracked_scheds.size());
+    for (const auto& bucket : buckets) {
+        CCL_ASSERT(bucket.second.postponed_queue.empty() && bucket.second.exec_queue.empty(),
+                   "queues are not empty, ",
+                   bucket.second.postponed_queue.size(),
+                   " ",
+                   bucket.second.exec_queue.size());
+    }
+    CCL_ASSERT(tracked_scheds.empty(), "tracked scheds are not empty, ", tracked_scheds.size());
 }
 
 bool ccl_fusion_manager::can_reset() {
@@ -134,15 +147,52 @@ bool ccl_fusion_manager::add(ccl_sched* sched) {
     CCL_THROW_IF_NOT(sched->is_completed(), "incorrect completion counter");
     sched->get_request()->set_counter(1);
 
+    bucket_key key = get_bucket_key(sched);
+    auto this_time = std::chrono::steady_clock::now();
+
     {
         std::lock_guard<ccl_fusion_manager::lock_t> lock{ guard };
-        postponed_queue.push_back(sched);
+        bucket_t& bucket = buckets[key];
+        if (!bucket.postponed_queue.empty() || !bucket.exec_queue.empty()) {
+            /* track arrival rate only within a burst, gaps between bursts are not representative */
+            auto interarrival = this_time - bucket.last_arrival_time;
+            bucket.avg_interarrival = (bucket.avg_interarrival * 7 + interarrival) / 8;
+        }
+        bucket.last_arrival_time = this_time;
+        bucket.postponed_queue.push_back(sched);
     }
 
     return true;
 }
 
-ccl_sched* ccl_fusion_manager::build_sched() {
+ccl_fusion_manager::bucket_key ccl_fusion_manager::get_bucket_key(const ccl_sched* sched) {
+    return { sched->coll_param.ctype,
+             sched->coll_param.comm,
+             sched->coll_param.dtype.idx(),
+             sched->coll_param.reduction,
+             sched->coll_param.stream };
+}
+
+void* ccl_fusion_manager::acquire_buffer(size_t bytes, size_t& buf_size) {
+    /* round up to size class to make buffers reusable between fused scheds of different size */
+    buf_size = CCL_FUSION_MIN_BUFFER_SIZE;
+    while (buf_size < bytes) {
+        buf_size <<= 1;
+    }
+    buf_size = std::max(std::min(buf_size, buffer_size), bytes);
+
+    void* buf = nullptr;
+    ccl::global_data::get().buffer_cache->get(0, buf_size, &buf);
+
+    {
+        std::lock_guard<ccl_fusion_manager::lock_t> lock{ buffer_guard };
+        buffer_sizes[buf] = buf_size;
+    }
+
+    return buf;
+}
+
+ccl_sched* ccl_fusion_manager::build_sched(const sched_queue_t& exec_queue) {
     size_t sum_count = 0, sum_bytes = 0, dtype_size;
     size_t max_priority = 0;
     bool use_cache = true;
@@ -151,6 +201,7 @@ ccl_sched* ccl_fusion_manager::build_sched() {
     ccl_coll_type ctype;
     const ccl_stream* stream __attribute__((unused)) = nullptr;
     void* fusion_buf = nullptr;
+    size_t fusion_buf_size = 0;
     bool fill_sched = true;
 
     CCL_THROW_IF_NOT(exec_queue.size(), "empty queue");
@@ -174,19 +225,40 @@ ccl_sched* ccl_fusion_manager::build_sched() {
     }
     sum_bytes = sum_count * dtype_size;
 
+    /* user buffers are sent directly with gather sends, no staging buffer is needed */
+    bool use_zero_copy = ccl::global_data::env().fusion_zero_copy && comm->size() > 1 &&
+                         exec_queue.size() <= atl_base_comm::attr.out.max_iov_count;
+#ifdef CCL_ENABLE_SYCL
+    use_zero_copy = use_zero_copy && !(stream && stream->is_sycl_device_stream());
+#endif // CCL_ENABLE_SYCL
+
     LOG_DEBUG("build fused_sched for sum_count ",
               sum_count,
               ", sum_bytes ",
               sum_bytes,
               ", sched_count ",
-              exec_queue.size());
+              exec_queue.size(),
+              ", zero_copy ",
+              use_zero_copy);
 
     ccl_sched* sched = nullptr;
-    auto create_fn = [this, ctype, &fusion_buf, sum_count, dtype, reduction, comm, stream]() {
+    auto create_fn = [this,
+                      ctype,
+                      &fusion_buf,
+                      &fusion_buf_size,
+                      sum_count,
+                      sum_bytes,
+                      dtype,
+                      reduction,
+                      comm,
+                      stream,
+                      use_zero_copy]() {
         ccl_sched* sched = nullptr;
         switch (ctype) {
             case ccl_coll_allreduce: {
-                ccl::global_data::get().buffer_cache->get(0, buffer_size, &fusion_buf);
+                if (!use_zero_copy) {
+                    fusion_buf = acquire_buffer(sum_bytes, fusion_buf_size);
+                }
                 ccl_coll_attr coll_attr;
                 ccl_coll_param coll_param = ccl_coll_param::create_allreduce_param(fusion_buf,
                                                                                    fusion_buf,
@@ -253,7 +325,11 @@ ccl_sched* ccl_fusion_manager::build_sched() {
     stat_fused_ops += exec_queue.size();
 
     if (!fill_sched) {
-        clear_exec_queue();
+        return sched;
+    }
+
+    if (use_zero_copy) {
+        build_zero_copy_sched(sched, exec_queue);
         return sched;
     }
 
@@ -295,7 +371,7 @@ ccl_sched* ccl_fusion_manager::build_sched() {
                             0, ccl_coll_param::buf_type::device),
                         exec_queue[global_copy_idx]->coll_param.get_send_count() * dtype_size,
                         ccl_buffer_type::INDIRECT),
-                    ccl_buffer(fusion_buf, buffer_size, offset),
+                    ccl_buffer(fusion_buf, fusion_buf_size, offset),
                     exec_queue[global_copy_idx]->coll_param.get_send_count(),
                     dtype,
                     copy_attr(copy_direction::d2h));
@@ -307,7 +383,7 @@ ccl_sched* ccl_fusion_manager::build_sched() {
                         exec_queue[global_copy_idx]->coll_param.get_send_buf_ptr(),
                         exec_queue[global_copy_idx]->coll_param.get_send_count() * dtype_size,
                         ccl_buffer_type::INDIRECT),
-                    ccl_buffer(fusion_buf, buffer_size, offset),
+                    ccl_buffer(fusion_buf, fusion_buf_size, offset),
                     exec_queue[global_copy_idx]->coll_param.get_send_count(),
                     dtype);
 
@@ -330,7 +406,7 @@ ccl_sched* ccl_fusion_manager::build_sched() {
             if (stream && stream->is_sycl_device_stream())
                 entry_factory::create<copy_entry>(
                     part_scheds[idx].get(),
-                    ccl_buffer(fusion_buf, buffer_size, offset),
+                    ccl_buffer(fusion_buf, fusion_buf_size, offset),
                     ccl_buffer(
                         exec_queue[global_copy_idx]->coll_param.get_recv_buf_ptr(
                             0, ccl_coll_param::buf_type::device),
@@ -343,7 +419,7 @@ ccl_sched* ccl_fusion_manager::build_sched() {
 #endif // CCL_ENABLE_SYCL
                 entry_factory::create<copy_entry>(
                     part_scheds[idx].get(),
-                    ccl_buffer(fusion_buf, buffer_size, offset),
+                    ccl_buffer(fusion_buf, fusion_buf_size, offset),
                     ccl_buffer(
                         exec_queue[global_copy_idx]->coll_param.get_recv_buf_ptr(),
                         exec_queue[global_copy_idx]->coll_param.get_recv_count() * dtype_size,
@@ -370,93 +446,171 @@ ccl_sched* ccl_fusion_manager::build_sched() {
         entry_factory::create<function_entry>(part_scheds[0].get(), release_fusion_buf, fusion_buf);
     }
 
-    clear_exec_queue();
-
     return sched;
 }
 
-void ccl_fusion_manager::execute() {
-    auto this_time = std::chrono::steady_clock::now();
-    auto diff = (last_exec_time + cycle - this_time);
-    if (diff > std::chrono::steady_clock::duration::zero()) {
-        /* it is too early, do nothing */
-        stat_empty_exec_calls++;
-        return;
+void ccl_fusion_manager::build_zero_copy_sched(ccl_sched* sched, const sched_queue_t& exec_queue) {
+    ccl_comm* comm = sched->coll_param.comm;
+    const ccl_datatype& dtype = sched->coll_param.dtype;
+    ccl::reduction reduction = sched->coll_param.reduction;
+    size_t dtype_size = dtype.size();
+    size_t sum_count = sched->coll_param.get_send_count();
+    int comm_size = comm->size();
+    int rank = comm->rank();
+
+    /* no algorithm is selected for the fused op, the only partial sched is filled below */
+    sched->commit(nullptr);
+    sched->add_subsched(sched->coll_param);
+    auto& part_sched = sched->get_subscheds().front();
+    part_sched->coll_attr = sched->coll_attr;
+
+    std::vector<ccl_buffer> send_bufs;
+    std::vector<size_t> counts;
+    for (const auto& s : exec_queue) {
+        counts.push_back(s->coll_param.get_send_count());
+        send_bufs.emplace_back(s->coll_param.get_send_buf_ptr(),
+                               counts.back() * dtype_size,
+                               ccl_buffer_type::INDIRECT);
     }
-    last_exec_time = std::chrono::steady_clock::now();
 
-    bool flush_exec_queue = false;
-    if (ccl::global_data::env().fusion_check_urgent && !exec_queue.empty()) {
+    /* direct exchange: each rank gets contributions of all peers for all fused ops */
+    ccl::alloc_param alloc_param((comm_size - 1) * sum_count * dtype_size,
+                                 ccl::buffer_type::regular,
+                                 ccl::buffer_place::host);
+    ccl_buffer tmp_buf = part_sched->alloc_buffer(alloc_param);
+
+    for (int peer_idx = 1; peer_idx < comm_size; peer_idx++) {
+        int peer = (rank + peer_idx) % comm_size;
+        entry_factory::create<sendv_entry>(part_sched.get(), send_bufs, counts, dtype, peer, comm);
+        entry_factory::create<recv_entry>(part_sched.get(),
+                                          tmp_buf + (peer_idx - 1) * sum_count * dtype_size,
+                                          sum_count,
+                                          dtype,
+                                          (rank + comm_size - peer_idx) % comm_size,
+                                          comm);
+    }
+    part_sched->add_barrier();
+
+    /* reduce segment-wise right into user buffers */
+    size_t offset = 0;
+    for (size_t idx = 0; idx < exec_queue.size(); idx++) {
+        ccl_sched* user_sched = exec_queue[idx];
+        size_t count = counts[idx];
+        ccl_buffer recv_buf(user_sched->coll_param.get_recv_buf_ptr(),
+                            count * dtype_size,
+                            ccl_buffer_type::INDIRECT);
+
+        std::vector<ccl_buffer> in_bufs;
+        for (int peer_idx = 1; peer_idx < comm_size; peer_idx++) {
+            in_bufs.push_back(tmp_buf + ((peer_idx - 1) * sum_count * dtype_size + offset));
+        }
+
+        /* no-op for in-place ops */
+        entry_factory::create<copy_entry>(part_sched.get(), send_bufs[idx], recv_buf, count, dtype);
+        part_sched->add_barrier();
+        entry_factory::create<reduce_local_multi_entry>(
+            part_sched.get(), in_bufs, count, recv_buf, dtype, reduction);
+        part_sched->add_barrier();
+        entry_factory::create<function_entry>(part_sched.get(), complete_user_request, user_sched);
+        CCL_THROW_IF_NOT(!user_sched->is_completed(), "incorrect completion counter");
+
+        offset += count * dtype_size;
+    }
+}
+
+bool ccl_fusion_manager::check_flush(bucket_t& bucket,
+                                     std::chrono::steady_clock::time_point this_time) {
+    if (ccl::global_data::env().fusion_check_urgent) {
         /* recheck scheds from exec_queue, maybe some of them were marked as urgent since previous call */
-        for (auto it = exec_queue.begin(); it != exec_queue.end(); ++it) {
+        for (auto it = bucket.exec_queue.begin(); it != bucket.exec_queue.end(); ++it) {
             if ((*it)->get_request()->urgent) {
                 LOG_DEBUG("found urgent sched in exec_queue, flush exec_queue");
-                flush_exec_queue = true;
-                break;
+                stat_urgent_flushes++;
+                return true;
             }
         }
     }
 
+    if (ccl::global_data::env().fusion_adaptive) {
+        /* no new ops for several average interarrival intervals, most likely the burst is over */
+        auto gap = std::max(cycle, bucket.avg_interarrival * CCL_FUSION_BURST_GAP_FACTOR);
+        if (this_time - bucket.last_arrival_time > gap) {
+            LOG_DEBUG("burst is over, flush exec_queue, size ", bucket.exec_queue.size());
+            stat_adaptive_flushes++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ccl_fusion_manager::execute() {
+    auto this_time = std::chrono::steady_clock::now();
+    auto diff = (last_exec_time + cycle - this_time);
+    if (diff > std::chrono::steady_clock::duration::zero()) {
+        /* it is too early, do nothing */
+        stat_empty_exec_calls++;
+        return;
+    }
+    last_exec_time = this_time;
+
+    std::vector<sched_queue_t> ready_queues;
+
+    auto flush_exec_queue = [&ready_queues](bucket_t& bucket) {
+        LOG_DEBUG("exec_queue size ",
+                  bucket.exec_queue.size(),
+                  ", bytes ",
+                  bucket.exec_queue_sum_bytes);
+        ready_queues.emplace_back();
+        std::swap(ready_queues.back(), bucket.exec_queue);
+        bucket.exec_queue_sum_bytes = 0;
+    };
+
     /* separate block to reduce lock scope */
     {
         std::lock_guard<ccl_fusion_manager::lock_t> lock{ guard };
-        if (!postponed_queue.empty()) {
-            LOG_DEBUG("postponed_queue size ", postponed_queue.size());
+        for (auto bucket_it = buckets.begin(); bucket_it != buckets.end();) {
+            bucket_t& bucket = bucket_it->second;
+
+            while (!bucket.postponed_queue.empty()) {
+                auto s = bucket.postponed_queue.front();
+                size_t size = s->coll_param.get_send_count() * s->coll_param.dtype.size();
+                if (!bucket.exec_queue.empty() &&
+                    bucket.exec_queue_sum_bytes + size > buffer_size) {
+                    LOG_DEBUG("too much bytes in buffer, flush exec_queue");
+                    stat_threshold_flushes++;
+                    flush_exec_queue(bucket);
+                    continue;
+                }
+
+                bucket.exec_queue_sum_bytes += size;
+                bucket.exec_queue.push_back(s);
+                bucket.postponed_queue.pop_front();
 
-            ccl_sched* first_sched;
-            if (!exec_queue.empty()) {
-                first_sched = exec_queue.front();
+                if (bucket.exec_queue.size() == count_threshold) {
+                    LOG_DEBUG("too many scheds, flush exec_queue");
+                    stat_threshold_flushes++;
+                    flush_exec_queue(bucket);
+                }
             }
-            else {
-                first_sched = postponed_queue.front();
-                exec_queue.push_back(first_sched);
-                postponed_queue.pop_front();
-                exec_queue_sum_bytes =
-                    first_sched->coll_param.get_send_count() * first_sched->coll_param.dtype.size();
+
+            if (!bucket.exec_queue.empty() && check_flush(bucket, this_time)) {
+                flush_exec_queue(bucket);
             }
 
-            for (auto it = postponed_queue.begin(); it != postponed_queue.end();) {
-                auto s = *it;
-                if (s->coll_param.dtype == first_sched->coll_param.dtype &&
-                    s->coll_param.comm == first_sched->coll_param.comm &&
-                    s->coll_param.ctype == first_sched->coll_param.ctype &&
-                    s->coll_param.reduction == first_sched->coll_param.reduction &&
-                    s->coll_param.stream == first_sched->coll_param.stream) {
-                    size_t size = s->coll_param.get_send_count() * s->coll_param.dtype.size();
-                    if (exec_queue_sum_bytes + size > buffer_size) {
-                        LOG_DEBUG("too much bytes in buffer, flush exec_queue");
-                        flush_exec_queue = true;
-                        break;
-                    }
-                    exec_queue_sum_bytes += size;
-
-                    if (ccl::global_data::env().fusion_check_urgent && !flush_exec_queue &&
-                        s->get_request()->urgent) {
-                        LOG_DEBUG(
-                            "found urgent sched in postponed_queue, flush exec_queue, postponed_queue size ",
-                            postponed_queue.size());
-                        flush_exec_queue = true;
-                    }
-
-                    exec_queue.push_back(s);
-                    it = postponed_queue.erase(it);
-
-                    if (exec_queue.size() == count_threshold) {
-                        LOG_DEBUG("too many scheds, flush exec_queue");
-                        flush_exec_queue = true;
-                        break;
-                    }
-                }
-                else {
-                    ++it;
-                }
+            if (bucket.exec_queue.empty() &&
+                (this_time - bucket.last_arrival_time >
+                 std::chrono::milliseconds(CCL_FUSION_BUCKET_IDLE_MS))) {
+                bucket_it = buckets.erase(bucket_it);
+            }
+            else {
+                ++bucket_it;
             }
         }
     }
 
-    if (flush_exec_queue) {
-        LOG_DEBUG("exec_queue size ", exec_queue.size(), ", bytes ", exec_queue_sum_bytes);
-        ccl_sched* sched = build_sched();
+    for (const auto& exec_queue : ready_queues) {
+        ccl_sched* sched = build_sched(exec_queue);
         sched->start(ccl::global_data::get().executor.get());
     }
 
@@ -466,12 +620,15 @@ void ccl_fusion_manager::execute() {
 }
 
 void ccl_fusion_manager::release_buffer(void* buf) {
-    ccl::global_data::get().buffer_cache->push(0, buffer_size, buf);
-}
-
-void ccl_fusion_manager::clear_exec_queue() {
-    exec_queue.clear();
-    exec_queue_sum_bytes = 0;
+    size_t buf_size = 0;
+    {
+        std::lock_guard<ccl_fusion_manager::lock_t> lock{ buffer_guard };
+        auto it = buffer_sizes.find(buf);
+        CCL_THROW_IF_NOT(it != buffer_sizes.end(), "unexpected fusion buffer ", buf);
+        buf_size = it->second;
+        buffer_sizes.erase(it);
+    }
+    ccl::global_data::get().buffer_cache->push(0, buf_size, buf);
 }
 
 void ccl_fusion_manager::check_tracked_scheds(bool force_release) {
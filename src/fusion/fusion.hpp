@@ -21,6 +21,9 @@
 #include <chrono>
 #include <mutex>
 #include <deque>
+#include <map>
+#include <tuple>
+#include <unordered_map>
 
 class ccl_fusion_manager {
 public:
@@ -38,10 +41,41 @@ public:
     void release_buffer(void* buf);
 
 private:
-    ccl_sched* build_sched();
-    void clear_exec_queue();
+    using sched_queue_t = std::deque<ccl_sched*>;
+
+    /* only scheds with the same bucket key can be fused together */
+    struct bucket_key {
+        ccl_coll_type ctype;
+        const ccl_comm* comm;
+        ccl::datatype dtype;
+        ccl::reduction reduction;
+        const ccl_stream* stream;
+
+        bool operator<(const bucket_key& other) const {
+            return std::tie(ctype, comm, dtype, reduction, stream) <
+                   std::tie(other.ctype, other.comm, other.dtype, other.reduction, other.stream);
+        }
+    };
+
+    struct bucket_t {
+        sched_queue_t postponed_queue{};
+        sched_queue_t exec_queue{};
+        size_t exec_queue_sum_bytes = 0;
+
+        /* arrival rate within a burst of ops, used by adaptive flush */
+        std::chrono::steady_clock::time_point last_arrival_time{};
+        std::chrono::steady_clock::duration avg_interarrival{};
+    };
+
+    static bucket_key get_bucket_key(const ccl_sched* sched);
+
+    bool check_flush(bucket_t& bucket, std::chrono::steady_clock::time_point now);
+    ccl_sched* build_sched(const sched_queue_t& exec_queue);
+    void build_zero_copy_sched(ccl_sched* sched, const sched_queue_t& exec_queue);
     void check_tracked_scheds(bool force_release = false);
 
+    void* acquire_buffer(size_t bytes, size_t& buf_size);
+
     const size_t bytes_threshold;
     const size_t count_threshold;
     const size_t buffer_size;
@@ -49,14 +83,15 @@ private:
     using lock_t = ccl_spinlock;
     lock_t guard{};
 
-    using sched_queue_t = std::deque<ccl_sched*>;
-    sched_queue_t postponed_queue{};
-    sched_queue_t exec_queue{};
-
-    size_t exec_queue_sum_bytes = 0;
+    /* postponed queues are filled by user threads, exec queues are used by service worker only */
+    std::map<bucket_key, bucket_t> buckets{};
 
     std::list<ccl_sched*> tracked_scheds{};
 
+    /* fused buffers are taken from buffer cache using power-of-two size classes */
+    lock_t buffer_guard{};
+    std::unordered_map<void*, size_t> buffer_sizes{};
+
     std::chrono::steady_clock::duration cycle;
     std::chrono::steady_clock::time_point last_exec_time;
 
@@ -64,4 +99,7 @@ private:
     size_t stat_fused_bytes = 0;
     size_t stat_empty_exec_calls = 0;
     size_t stat_overlapped_exec_calls = 0;
+    size_t stat_threshold_flushes = 0;
+    size_t stat_urgent_flushes = 0;
+    size_t stat_adaptive_flushes = 0;
 };
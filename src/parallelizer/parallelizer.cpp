@@ -218,9 +218,13 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
     selector_param.is_sycl_buf = coll_attr.is_sycl_buf;
 #endif // CCL_ENABLE_SYCL
     selector_param.peer_rank = coll_param.peer_rank;
+    selector_param.hint_algo = coll_param.hint_algo;
 
     switch (coll_type) {
-        case ccl_coll_barrier: part_count = max_data_partition_count; break;
+        case ccl_coll_barrier:
+            /* shm barrier synchronizes all local ranks at once */
+            part_count = ccl_is_shm_algo(selector_param) ? 1 : max_data_partition_count;
+            break;
         case ccl_coll_bcast:
         case ccl_coll_broadcast:
             if (ccl::global_data::env().bcast_part_count != CCL_ENV_SIZET_NOT_SPECIFIED) {
@@ -240,14 +244,18 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 if (part_count < max_data_partition_count)
                     part_count = max_data_partition_count;
             }
-            if (ccl_is_device_side_algo(selector_param)) {
+            /* shm algorithms pipeline the message internally */
+            if (ccl_is_device_side_algo(selector_param) || ccl_is_shm_algo(selector_param)) {
                 part_count = 1;
             }
             break;
         case ccl_coll_alltoall:
             selector_param.is_scaleout = coll_param.is_scaleout;
             algo.alltoall = data.algorithm_selector->get<ccl_coll_alltoall>(selector_param);
-            if (algo.alltoall == ccl_coll_alltoall_direct) {
+            // pairwise and bruck keep a single exchange in flight
+            if (algo.alltoall == ccl_coll_alltoall_direct ||
+                algo.alltoall == ccl_coll_alltoall_pairwise ||
+                algo.alltoall == ccl_coll_alltoall_bruck) {
                 part_count = 1;
             }
             else {
@@ -257,7 +265,9 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
         case ccl_coll_alltoallv:
             selector_param.is_scaleout = coll_param.is_scaleout;
             algo.alltoallv = data.algorithm_selector->get<ccl_coll_alltoallv>(selector_param);
-            if (algo.alltoallv == ccl_coll_alltoallv_direct) {
+            if (algo.alltoallv == ccl_coll_alltoallv_direct ||
+                algo.alltoallv == ccl_coll_alltoallv_pairwise ||
+                algo.alltoallv == ccl_coll_alltoallv_hier) {
                 part_count = 1;
             }
             else {
@@ -279,6 +289,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 algo.allgatherv == ccl_coll_allgatherv_direct ||
                 algo.allgather == ccl_coll_allgather_naive ||
                 algo.allgatherv == ccl_coll_allgatherv_naive ||
+                algo.allgatherv == ccl_coll_allgatherv_shm ||
                 ccl_is_device_side_algo(selector_param)) {
                 part_count = 1;
             }
@@ -413,6 +424,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                   algo.allgatherv == ccl_coll_allgatherv_naive ||
                   algo.allgather == ccl_coll_allgather_ring ||
                   algo.allgatherv == ccl_coll_allgatherv_ring ||
+                  algo.allgatherv == ccl_coll_allgatherv_shm ||
                   ccl_is_device_side_algo(selector_param))) {
                 for (idx = 1; idx < comm_size; idx++) {
                     counts[idx] = coll_param.get_recv_count(idx);
@@ -486,6 +498,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 param.root = coll_param.root;
                 param.comm = comm;
                 param.stream = coll_param.stream;
+                param.hint_algo = coll_param.hint_algo;
                 ccl::add_coll_entry(part_scheds[idx].get(), param);
             }
             break;
@@ -506,6 +519,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 param.root = coll_param.root;
                 param.comm = comm;
                 param.stream = coll_param.stream;
+                param.hint_algo = coll_param.hint_algo;
                 ccl::add_coll_entry(part_scheds[idx].get(), param);
             }
             break;
@@ -532,6 +546,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 param.comm = comm;
                 param.stream = coll_param.stream;
                 param.is_scaleout = coll_param.is_scaleout;
+                param.hint_algo = coll_param.hint_algo;
                 ccl::add_coll_entry(part_scheds[idx].get(), param);
             }
             break;
@@ -556,6 +571,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 param.comm = comm;
                 param.stream = coll_param.stream;
                 param.is_scaleout = coll_param.is_scaleout;
+                param.hint_algo = coll_param.hint_algo;
                 ccl::add_coll_entry(part_scheds[idx].get(), param);
             }
             break;
@@ -584,6 +600,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 param.is_scaleout = coll_param.is_scaleout;
                 param.recv_scale_out_bufs.assign(coll_param.recv_scale_out_bufs.begin(),
                                                  coll_param.recv_scale_out_bufs.end());
+                param.hint_algo = coll_param.hint_algo;
                 ccl::add_coll_entry(part_scheds[idx].get(), param);
             }
             break;
@@ -597,7 +614,8 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
             if (algo.allgather == ccl_coll_allgather_direct ||
                 algo.allgatherv == ccl_coll_allgatherv_direct ||
                 algo.allgather == ccl_coll_allgather_naive ||
-                algo.allgatherv == ccl_coll_allgatherv_naive) {
+                algo.allgatherv == ccl_coll_allgatherv_naive ||
+                algo.allgatherv == ccl_coll_allgatherv_shm) {
                 ccl_coll_param param{ false };
                 param.ctype = coll_type;
                 param.send_buf = ccl_buffer(coll_param.get_send_buf_ptr(),
@@ -609,6 +627,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 param.comm = comm;
                 param.stream = coll_param.stream;
                 param.is_scaleout = coll_param.is_scaleout;
+                param.hint_algo = coll_param.hint_algo;
 
                 if (coll_type == ccl_coll_allgather) {
                     param.count = coll_param.get_send_count();
@@ -681,6 +700,16 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                      algo.alltoallv == ccl_coll_alltoallv_scatter) {
                 ccl_coll_build_scatter_alltoallv(sched, part_scheds_vector, coll_param);
             }
+            else if (algo.alltoall == ccl_coll_alltoall_pairwise ||
+                     algo.alltoallv == ccl_coll_alltoallv_pairwise) {
+                ccl_coll_build_pairwise_alltoallv(sched, part_scheds_vector, coll_param);
+            }
+            else if (coll_type == ccl_coll_alltoall && algo.alltoall == ccl_coll_alltoall_bruck) {
+                ccl_coll_build_bruck_alltoall(sched, part_scheds_vector, coll_param);
+            }
+            else if (coll_type == ccl_coll_alltoallv && algo.alltoallv == ccl_coll_alltoallv_hier) {
+                ccl_coll_build_hier_alltoallv(sched, part_scheds_vector, coll_param);
+            }
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
             else if (algo.alltoall == ccl_coll_alltoall_topo ||
                      algo.alltoallv == ccl_coll_alltoallv_topo) {
@@ -107,6 +107,28 @@ void buffer_manager::clear() {
 #endif // CCL_ENABLE_ZE
 }
 
+size_t buffer_manager::get_allocated_bytes() const {
+    size_t bytes = 0;
+
+    for (const auto& buf : regular_buffers) {
+        bytes += buf.bytes;
+    }
+
+#ifdef CCL_ENABLE_SYCL
+    for (const auto& buf : sycl_buffers) {
+        bytes += buf.bytes;
+    }
+#endif // CCL_ENABLE_SYCL
+
+#ifdef CCL_ENABLE_ZE
+    for (const auto& buf : ze_buffers) {
+        bytes += buf.bytes;
+    }
+#endif // CCL_ENABLE_ZE
+
+    return bytes;
+}
+
 void* buffer_manager::alloc(const alloc_param& param) {
     LOG_DEBUG("{ idx: ", instance_idx, ", param: ", param.to_string(), " }");
 
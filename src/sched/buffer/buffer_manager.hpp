@@ -141,6 +141,8 @@ public:
     void* alloc(const alloc_param& param);
     void dealloc(const dealloc_param& param);
 
+    size_t get_allocated_bytes() const;
+
 private:
     size_t instance_idx{};
 
@@ -16,16 +16,25 @@
 #include "common/global/global.hpp"
 #include "sched/cache/cache.hpp"
 
-ccl_sched* ccl_sched_cache::find_unsafe(const ccl_sched_key& key) const {
-    ccl_sched* sched = nullptr;
+ccl_sched_cache::shard_t& ccl_sched_cache::get_shard(const ccl_sched_key& key) {
+    // the hash value is cached inside the key, so it is not recalculated on table lookup
+    size_t hash_value = ccl_sched_key_hasher{}(key);
+    // the key hash is avalanched, but the table uses low bits for buckets, so take high bits
+    return shards[(hash_value >> 32) % CCL_SCHED_CACHE_SHARD_COUNT];
+}
+
+ccl_sched_cache_entry* ccl_sched_cache::find_unsafe(const shard_t& shard,
+                                                   const ccl_sched_key& key) const {
+    ccl_sched_cache_entry* entry = nullptr;
     {
-        auto it = table.find(key);
-        if (it != table.end()) {
-            sched = it->second;
+        auto it = shard.table.find(key);
+        if (it != shard.table.end()) {
+            entry = const_cast<ccl_sched_cache_entry*>(&(it->second));
         }
     }
 
 #ifdef ENABLE_DEBUG
+    ccl_sched* sched = (entry) ? entry->sched.load(std::memory_order_acquire) : nullptr;
     if (sched && ccl::global_data::env().cache_key_type != ccl_cache_key_full) {
         LOG_DEBUG("do sanity check for found sched ", sched);
         CCL_THROW_IF_NOT(key.check(sched->coll_param, sched->coll_attr));
@@ -33,48 +42,232 @@ ccl_sched* ccl_sched_cache::find_unsafe(const ccl_sched_key& key) const {
     }
 #endif
 
+    return entry;
+}
+
+ccl_sched_cache_entry* ccl_sched_cache::insert_unsafe(shard_t& shard,
+                                                     ccl_sched_key&& key,
+                                                     ccl_sched* sched) {
+    auto emplace_result = shard.table.emplace(
+        std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple());
+    CCL_THROW_IF_NOT(emplace_result.second, "sched key is already in cache");
+
+    // table nodes are not relocated on rehash, so the entry address is stable
+    ccl_sched_cache_entry* entry = &(emplace_result.first->second);
+    entry->key = &(emplace_result.first->first);
+    entry->shard_idx = shard.idx;
+    entry->ref_count = 1;
+    entry->sched.store(sched, std::memory_order_release);
+    total_entries++;
+    return entry;
+}
+
+void ccl_sched_cache::acquire_unsafe(shard_t& shard, ccl_sched_cache_entry* entry) {
+    if (entry->is_idle) {
+        shard.lru.erase(entry->lru_it);
+        entry->is_idle = false;
+    }
+    entry->ref_count++;
+}
+
+ccl_sched* ccl_sched_cache::wait_created(shard_t& shard, const ccl_sched_cache_entry* entry) {
+    ccl_sched* sched = entry->sched.load(std::memory_order_acquire);
+    if (sched) {
+        return sched;
+    }
+
+    // the same key was requested concurrently and the sched is still being created
+    LOG_DEBUG("wait for sched creation in another thread");
+    shard.stat_create_waits++;
+    while (!(sched = entry->sched.load(std::memory_order_acquire))) {
+        ccl_yield(ccl::global_data::env().yield_type);
+    }
     return sched;
 }
 
+void ccl_sched_cache::remove_reserved(shard_t& shard, ccl_sched_cache_entry* entry) {
+    std::lock_guard<shard_t> lock{ shard };
+    CCL_ASSERT(!entry->is_idle);
+    shard.table.erase(*(entry->key));
+    total_entries--;
+    reference_counter--;
+}
+
 void ccl_sched_cache::recache(const ccl_sched_key& old_key, ccl_sched_key&& new_key) {
+    ccl_sched* sched = nullptr;
+    size_t ref_count = 0;
     {
-        std::lock_guard<sched_cache_lock_t> lock{ guard };
-        auto it = table.find(old_key);
-        if (it == table.end()) {
+        shard_t& old_shard = get_shard(old_key);
+        std::lock_guard<shard_t> lock{ old_shard };
+        auto it = old_shard.table.find(old_key);
+        if (it == old_shard.table.end()) {
             std::string error_message = "old_key wasn't found";
             CCL_ASSERT(false, error_message, old_key.match_id);
             throw ccl::exception(error_message + old_key.match_id);
         }
-        ccl_sched* sched = it->second;
-        table.erase(it);
-        auto emplace_result = table.emplace(std::move(new_key), sched);
-        CCL_THROW_IF_NOT(emplace_result.second);
+        ccl_sched_cache_entry& entry = it->second;
+        sched = entry.sched.load(std::memory_order_acquire);
+        CCL_THROW_IF_NOT(sched, "sched for old_key is not created yet");
+        // recache is done for the sched which is in use, so it can't be in LRU list
+        CCL_THROW_IF_NOT(!entry.is_idle, "sched for old_key is not referenced");
+        ref_count = entry.ref_count;
+        total_bytes -= entry.bytes;
+        old_shard.table.erase(it);
+        total_entries--;
+    }
+    {
+        shard_t& new_shard = get_shard(new_key);
+        std::lock_guard<shard_t> lock{ new_shard };
+        ccl_sched_cache_entry* entry = insert_unsafe(new_shard, std::move(new_key), sched);
+        entry->ref_count = ref_count;
+        sched->cache_entry = entry;
     }
 }
 
 void ccl_sched_cache::release(ccl_sched* sched) {
+    ccl_sched_cache_entry* entry = sched->cache_entry;
+    CCL_THROW_IF_NOT(entry, "sched ", sched, " doesn't belong to cache");
+    shard_t& shard = shards[entry->shard_idx];
+    {
+        std::lock_guard<shard_t> lock{ shard };
+        CCL_THROW_IF_NOT(entry->ref_count > 0, "unexpected ref_count for sched ", sched);
+        entry->ref_count--;
+        if (entry->ref_count == 0) {
+            // the sched is fully built after the first execution, so refresh its size here
+            size_t bytes = sched->get_memory_bytes();
+            total_bytes += bytes;
+            total_bytes -= entry->bytes;
+            entry->bytes = bytes;
+
+            shard.lru.push_front(entry);
+            entry->lru_it = shard.lru.begin();
+            entry->is_idle = true;
+        }
+    }
     reference_counter--;
     LOG_DEBUG("releasing sched to cache: ", sched);
     LOG_TRACE("reference_counter=", reference_counter);
+
+    if (is_over_limit()) {
+        evict(shard);
+    }
+}
+
+bool ccl_sched_cache::is_over_limit() const {
+    size_t max_bytes = ccl::global_data::env().cache_max_bytes;
+    size_t max_entries = ccl::global_data::env().cache_max_entries;
+    return (max_bytes && total_bytes > max_bytes) || (max_entries && total_entries > max_entries);
+}
+
+void ccl_sched_cache::evict_unsafe(shard_t& shard, std::vector<ccl_sched*>& evicted) {
+    while (is_over_limit() && !shard.lru.empty()) {
+        ccl_sched_cache_entry* entry = shard.lru.back();
+        shard.lru.pop_back();
+        CCL_ASSERT(entry->is_idle && entry->ref_count == 0);
+
+        ccl_sched* sched = entry->sched.load(std::memory_order_acquire);
+        LOG_DEBUG("evict sched ", sched, " from cache, bytes ", entry->bytes);
+        total_bytes -= entry->bytes;
+        total_entries--;
+        shard.stat_evictions++;
+        shard.stat_evicted_bytes += entry->bytes;
+        shard.table.erase(*(entry->key));
+        evicted.push_back(sched);
+    }
+}
+
+void ccl_sched_cache::evict(shard_t& shard) {
+    std::vector<ccl_sched*> evicted;
+    {
+        std::lock_guard<shard_t> lock{ shard };
+        evict_unsafe(shard, evicted);
+    }
+
+    // the released shard may have no idle entries, continue with the others
+    // but don't wait for the shards which are busy
+    for (size_t offset = 1; offset < shards.size() && is_over_limit(); offset++) {
+        shard_t& other = shards[(shard.idx + offset) % shards.size()];
+        if (other.guard.try_lock()) {
+            evict_unsafe(other, evicted);
+            other.unlock();
+        }
+    }
+
+    // scheds are deleted outside of the lock, nobody can find them after removal from table
+    for (auto sched : evicted) {
+        delete sched;
+    }
 }
 
 bool ccl_sched_cache::try_flush() {
     if (!ccl::global_data::env().enable_cache_flush)
         return true;
 
-    std::lock_guard<sched_cache_lock_t> lock{ guard };
+    for (auto& shard : shards) {
+        shard.lock();
+    }
 
-    if (reference_counter == 0) {
-        for (auto it = table.begin(); it != table.end(); ++it) {
-            ccl_sched* sched = it->second;
-            CCL_ASSERT(sched);
-            LOG_DEBUG("remove sched ", sched, " from cache");
-            delete sched;
+    bool is_flushed = (reference_counter == 0);
+    if (is_flushed) {
+        for (auto& shard : shards) {
+            for (auto it = shard.table.begin(); it != shard.table.end(); ++it) {
+                ccl_sched* sched = it->second.sched.load(std::memory_order_acquire);
+                CCL_ASSERT(sched);
+                LOG_DEBUG("remove sched ", sched, " from cache");
+                delete sched;
+            }
+            shard.table.clear();
+            shard.lru.clear();
         }
-        table.clear();
-        return true;
+        total_bytes = 0;
+        total_entries = 0;
+    }
+
+    for (auto& shard : shards) {
+        shard.unlock();
     }
-    else {
-        return false;
+
+    return is_flushed;
+}
+
+void ccl_sched_cache::print_stat() const {
+    size_t hits = 0, misses = 0, contentions = 0, create_waits = 0, size = 0;
+    size_t evictions = 0, evicted_bytes = 0;
+    std::stringstream ss;
+    for (size_t idx = 0; idx < shards.size(); idx++) {
+        const shard_t& shard = shards[idx];
+        hits += shard.stat_hits;
+        misses += shard.stat_misses;
+        contentions += shard.stat_contentions;
+        create_waits += shard.stat_create_waits;
+        evictions += shard.stat_evictions;
+        evicted_bytes += shard.stat_evicted_bytes;
+        size += shard.table.size();
+        if (ccl::global_data::env().sched_profile && (shard.stat_hits || shard.stat_misses)) {
+            ss << "\n[" << idx << "] size: " << shard.table.size()
+               << ", hits: " << shard.stat_hits << ", misses: " << shard.stat_misses
+               << ", contentions: " << shard.stat_contentions
+               << ", create_waits: " << shard.stat_create_waits
+               << ", evictions: " << shard.stat_evictions
+               << ", evicted_bytes: " << shard.stat_evicted_bytes;
+        }
     }
+
+    LOG_INFO("sched cache: size ",
+             size,
+             ", hits ",
+             hits,
+             ", misses ",
+             misses,
+             ", contentions ",
+             contentions,
+             ", create_waits ",
+             create_waits,
+             ", bytes ",
+             total_bytes,
+             ", evictions ",
+             evictions,
+             ", evicted_bytes ",
+             evicted_bytes,
+             ss.str());
 }
@@ -16,21 +16,47 @@
 #pragma once
 
 #include "common/utils/spinlock.hpp"
+#include "common/utils/utils.hpp"
+#include "common/utils/yield.hpp"
 #include "sched/cache/key.hpp"
 #include "sched/sched.hpp"
 #include "sched/sched_timer.hpp"
 
+#include <array>
 #include <atomic>
 #include <functional>
+#include <list>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #define CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT (4096)
+#define CCL_SCHED_CACHE_SHARD_COUNT          (64)
+
+struct ccl_sched_cache_entry {
+    // nullptr value means that the sched is being created by another thread
+    std::atomic<ccl_sched*> sched{ nullptr };
+
+    // fields below are guarded by the shard lock
+    const ccl_sched_key* key = nullptr;
+    size_t shard_idx = 0;
+    size_t ref_count = 0;
+    size_t bytes = 0;
+    bool is_idle = false;
+    std::list<ccl_sched_cache_entry*>::iterator lru_it{};
+};
 
 class ccl_sched_cache {
 public:
-    ccl_sched_cache() : reference_counter(0){};
+    ccl_sched_cache() : reference_counter(0), total_bytes(0), total_entries(0) {
+        for (size_t idx = 0; idx < shards.size(); idx++) {
+            shards[idx].idx = idx;
+        }
+    };
     ~ccl_sched_cache() {
+        print_stat();
         size_t iter = 0;
         static const size_t check_period = 1000;
         while (!try_flush()) {
@@ -49,15 +75,58 @@ public:
     void recache(const ccl_sched_key& old_key, ccl_sched_key&& new_key);
     void release(ccl_sched* sched);
     bool try_flush();
+    void print_stat() const;
 
 private:
-    ccl_sched* find_unsafe(const ccl_sched_key& key) const;
     using sched_cache_lock_t = ccl_spinlock;
-    mutable sched_cache_lock_t guard{}; //could be changed in constant method
     //TODO use smart ptr for ccl_master_sched in table
-    using sched_table_t = std::unordered_map<ccl_sched_key, ccl_sched*, ccl_sched_key_hasher>;
-    sched_table_t table{ CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT };
+    using sched_table_t =
+        std::unordered_map<ccl_sched_key, ccl_sched_cache_entry, ccl_sched_key_hasher>;
+
+    struct alignas(CACHELINE_SIZE) shard_t {
+        mutable sched_cache_lock_t guard{}; //could be changed in constant method
+        sched_table_t table{ CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT / CCL_SCHED_CACHE_SHARD_COUNT };
+
+        // entries which are not referenced by any request, most recently used at front
+        std::list<ccl_sched_cache_entry*> lru;
+        size_t idx = 0;
+
+        std::atomic<size_t> stat_hits{ 0 };
+        std::atomic<size_t> stat_misses{ 0 };
+        std::atomic<size_t> stat_contentions{ 0 };
+        std::atomic<size_t> stat_create_waits{ 0 };
+        std::atomic<size_t> stat_evictions{ 0 };
+        std::atomic<size_t> stat_evicted_bytes{ 0 };
+
+        void lock() {
+            if (!guard.try_lock()) {
+                stat_contentions++;
+                guard.lock();
+            }
+        }
+
+        void unlock() {
+            guard.unlock();
+        }
+    };
+
+    shard_t& get_shard(const ccl_sched_key& key);
+    ccl_sched_cache_entry* find_unsafe(const shard_t& shard, const ccl_sched_key& key) const;
+    ccl_sched_cache_entry* insert_unsafe(shard_t& shard, ccl_sched_key&& key, ccl_sched* sched);
+    void acquire_unsafe(shard_t& shard, ccl_sched_cache_entry* entry);
+    ccl_sched* wait_created(shard_t& shard, const ccl_sched_cache_entry* entry);
+    void remove_reserved(shard_t& shard, ccl_sched_cache_entry* entry);
+
+    bool is_over_limit() const;
+    void evict_unsafe(shard_t& shard, std::vector<ccl_sched*>& evicted);
+    void evict(shard_t& shard);
+
+    std::array<shard_t, CCL_SCHED_CACHE_SHARD_COUNT> shards;
     std::atomic<size_t> reference_counter;
+
+    // memory accounting, updated when a sched becomes idle or is removed
+    std::atomic<size_t> total_bytes;
+    std::atomic<size_t> total_entries;
 };
 
 template <class Lambda>
@@ -65,47 +134,63 @@ template <class Lambda>
 std::pair<ccl_sched*, bool> ccl_sched_cache::find_or_create(ccl_sched_key&& key,
                                                             const Lambda& create_fn) {
     ccl_sched* sched = nullptr;
+    ccl_sched_cache_entry* entry = nullptr;
+    shard_t& shard = get_shard(key);
 
     bool is_created = false;
     {
-        std::lock_guard<sched_cache_lock_t> lock{ guard };
-        sched = find_unsafe(key);
-        if (sched) {
-#ifdef CCL_ENABLE_ITT
-            __itt_event sched_cached_event = ccl::profile::itt::event_get("SCHED_CACHED");
-            ccl::profile::itt::event_start(sched_cached_event);
-#endif // CCL_ENABLE_ITT
-            reference_counter++;
-#ifdef CCL_ENABLE_ITT
-            ccl::profile::itt::event_end(sched_cached_event);
-#endif // CCL_ENABLE_ITT
+        std::lock_guard<shard_t> lock{ shard };
+        entry = find_unsafe(shard, key);
+        reference_counter++;
+        if (entry) {
+            acquire_unsafe(shard, entry);
         }
         else {
-#ifdef CCL_ENABLE_ITT
-            __itt_event sched_new_event = ccl::profile::itt::event_get("SCHED_NEW");
-            ccl::profile::itt::event_start(sched_new_event);
-#endif // CCL_ENABLE_ITT
-            LOG_DEBUG("didn't find sched in cache, the new one will be created");
-            sched = create_fn();
-            {
-                reference_counter++;
-                auto emplace_result = table.emplace(std::move(key), sched);
-                CCL_ASSERT(emplace_result.second);
-            }
+            // reserve the slot so that sched creation can be done outside of the lock
+            entry = insert_unsafe(shard, std::move(key), nullptr);
             is_created = true;
 
             LOG_DEBUG("size ",
-                      table.size(),
+                      shard.table.size(),
                       ", bucket_count ",
-                      table.bucket_count(),
+                      shard.table.bucket_count(),
                       ", load_factor ",
-                      table.load_factor(),
+                      shard.table.load_factor(),
                       ", max_load_factor ",
-                      table.max_load_factor());
+                      shard.table.max_load_factor());
+        }
+    }
+
+    if (!is_created) {
 #ifdef CCL_ENABLE_ITT
-            ccl::profile::itt::event_end(sched_new_event);
+        __itt_event sched_cached_event = ccl::profile::itt::event_get("SCHED_CACHED");
+        ccl::profile::itt::event_start(sched_cached_event);
 #endif // CCL_ENABLE_ITT
+        shard.stat_hits++;
+        sched = wait_created(shard, entry);
+#ifdef CCL_ENABLE_ITT
+        ccl::profile::itt::event_end(sched_cached_event);
+#endif // CCL_ENABLE_ITT
+    }
+    else {
+#ifdef CCL_ENABLE_ITT
+        __itt_event sched_new_event = ccl::profile::itt::event_get("SCHED_NEW");
+        ccl::profile::itt::event_start(sched_new_event);
+#endif // CCL_ENABLE_ITT
+        LOG_DEBUG("didn't find sched in cache, the new one will be created");
+        shard.stat_misses++;
+        try {
+            sched = create_fn();
+        }
+        catch (...) {
+            remove_reserved(shard, entry);
+            throw;
         }
+        sched->cache_entry = entry;
+        entry->sched.store(sched, std::memory_order_release);
+#ifdef CCL_ENABLE_ITT
+        ccl::profile::itt::event_end(sched_new_event);
+#endif // CCL_ENABLE_ITT
     }
     LOG_TRACE("reference_counter=", reference_counter);
     return std::make_pair(sched, is_created);
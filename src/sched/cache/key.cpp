@@ -17,9 +17,10 @@
 #include "common/global/global.hpp"
 #include "sched/cache/key.hpp"
 #include "common/utils/enums.hpp"
+#include "common/utils/spinlock.hpp"
 
 #include <cstring>
-#include <numeric>
+#include <mutex>
 
 std::map<ccl_cache_key_type, std::string> ccl_sched_key::key_type_names = {
     std::make_pair(ccl_cache_key_full, "full"),
@@ -31,6 +32,8 @@ ccl_sched_key::ccl_sched_key(const ccl_coll_param& param, const ccl_coll_attr& a
 }
 
 void ccl_sched_key::set(const ccl_coll_param& param, const ccl_coll_attr& attr) {
+    has_hasher_result = false;
+
     if (ccl::global_data::env().cache_key_type == ccl_cache_key_full) {
         /* to zerioize holes in memory layout */
         memset((void*)&f, 0, sizeof(ccl_sched_key_inner_fields));
@@ -132,14 +135,21 @@ bool ccl_sched_key::check(const ccl_coll_param& param, const ccl_coll_attr& attr
 }
 
 bool ccl_sched_key::operator==(const ccl_sched_key& k) const {
-    bool are_fields_equal = 1;
-    if (ccl::global_data::env().cache_key_type == ccl_cache_key_full) {
-        are_fields_equal = !memcmp(&f, &(k.f), sizeof(ccl_sched_key_inner_fields));
-        are_fields_equal &= (vec1 == k.vec1) ? 1 : 0;
-        are_fields_equal &= (vec2 == k.vec2) ? 1 : 0;
+    bool are_keys_equal = true;
+    bool is_hashed = has_hasher_result && k.has_hasher_result;
+
+    if (is_hashed) {
+        /* cheap path, full comparison is done only on hash collision */
+        are_keys_equal = (hasher_result == k.hasher_result) && (match_id_idx == k.match_id_idx);
+    }
+    else {
+        are_keys_equal = !match_id.compare(k.match_id);
     }
 
-    bool are_keys_equal = are_fields_equal && !match_id.compare(k.match_id);
+    if (are_keys_equal && ccl::global_data::env().cache_key_type == ccl_cache_key_full) {
+        are_keys_equal = !memcmp(&f, &(k.f), sizeof(ccl_sched_key_inner_fields)) &&
+                         (vec1 == k.vec1) && (vec2 == k.vec2);
+    }
 
     LOG_DEBUG("are_keys_equal ", are_keys_equal);
 
@@ -177,23 +187,130 @@ void ccl_sched_key::print() const {
               match_id);
 }
 
+/* 64-bit hash over machine words with xxHash64 rounds and finalization */
+namespace {
+
+constexpr uint64_t hash_prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t hash_prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t hash_prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t hash_prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t hash_prime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t hash_rotl(uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t hash_round(uint64_t acc, uint64_t input) {
+    acc += input * hash_prime2;
+    acc = hash_rotl(acc, 31);
+    return acc * hash_prime1;
+}
+
+inline uint64_t hash_merge_round(uint64_t acc, uint64_t value) {
+    acc ^= hash_round(0, value);
+    return acc * hash_prime1 + hash_prime4;
+}
+
+inline uint64_t hash_word(uint64_t acc, uint64_t input) {
+    acc ^= hash_round(0, input);
+    return hash_rotl(acc, 27) * hash_prime1 + hash_prime4;
+}
+
+inline uint64_t hash_avalanche(uint64_t acc) {
+    acc ^= acc >> 33;
+    acc *= hash_prime2;
+    acc ^= acc >> 29;
+    acc *= hash_prime3;
+    acc ^= acc >> 32;
+    return acc;
+}
+
+/* 4 independent lanes for long vectors, e.g. alltoallv counts for large comms */
+uint64_t hash_words(uint64_t seed, const size_t* data, size_t count) {
+    const size_t* ptr = data;
+    const size_t* end = data + count;
+    uint64_t acc = 0;
+
+    if (count >= 4) {
+        uint64_t v1 = seed + hash_prime1 + hash_prime2;
+        uint64_t v2 = seed + hash_prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - hash_prime1;
+        for (; ptr + 4 <= end; ptr += 4) {
+            v1 = hash_round(v1, ptr[0]);
+            v2 = hash_round(v2, ptr[1]);
+            v3 = hash_round(v3, ptr[2]);
+            v4 = hash_round(v4, ptr[3]);
+        }
+        acc = hash_rotl(v1, 1) + hash_rotl(v2, 7) + hash_rotl(v3, 12) + hash_rotl(v4, 18);
+        acc = hash_merge_round(acc, v1);
+        acc = hash_merge_round(acc, v2);
+        acc = hash_merge_round(acc, v3);
+        acc = hash_merge_round(acc, v4);
+    }
+    else {
+        acc = seed + hash_prime5;
+    }
+
+    acc += count * sizeof(size_t);
+    for (; ptr < end; ptr++) {
+        acc = hash_word(acc, *ptr);
+    }
+
+    return hash_avalanche(acc);
+}
+
+std::unordered_map<std::string, size_t> match_id_table;
+ccl_spinlock match_id_guard;
+
+} // namespace
+
+size_t ccl_sched_key_hasher::intern_match_id(const std::string& match_id) {
+    if (match_id.empty())
+        return 0;
+
+    std::lock_guard<ccl_spinlock> lock{ match_id_guard };
+    auto it = match_id_table.find(match_id);
+    if (it != match_id_table.end())
+        return it->second;
+
+    size_t idx = match_id_table.size() + 1;
+    match_id_table.emplace(match_id, idx);
+    return idx;
+}
+
 size_t ccl_sched_key_hasher::operator()(const ccl_sched_key& k) const {
     if (k.has_hasher_result)
         return k.get_hasher_result();
 
-    size_t hash_value = string_hasher(k.match_id);
+    size_t match_id_idx = intern_match_id(k.match_id);
+    size_t hash_value = 0;
+
     if (ccl::global_data::env().cache_key_type == ccl_cache_key_full) {
-        /* TODO: improve hashing for vec fields to reduce probability of collisions
-           e.g. sum(a[idx]*(idx+1)) */
-        size_t vec1_sum = std::accumulate(k.vec1.begin(), k.vec1.end(), size_t(0));
-        size_t vec2_sum = std::accumulate(k.vec2.begin(), k.vec2.end(), size_t(0));
-        hash_value += k.f.ctype + ccl::utils::enum_to_underlying(k.f.dtype) +
-                      ccl::utils::enum_to_underlying(k.f.reduction) + k.f.count1 + k.f.count2 +
-                      k.f.root + (size_t)k.f.buf1 + (size_t)k.f.buf2 + (size_t)k.f.comm +
-                      (size_t)k.f.reduction_fn + vec1_sum + vec2_sum;
+        const size_t fields[] = { (size_t)k.f.ctype,
+                                  (size_t)k.f.buf1,
+                                  (size_t)k.f.buf2,
+                                  (size_t)ccl::utils::enum_to_underlying(k.f.dtype),
+                                  (size_t)ccl::utils::enum_to_underlying(k.f.reduction),
+                                  k.f.count1,
+                                  k.f.count2,
+                                  (size_t)k.f.root,
+                                  (size_t)k.f.peer_rank,
+                                  (size_t)k.f.group_id,
+                                  (size_t)k.f.comm,
+                                  (size_t)k.f.reduction_fn,
+                                  match_id_idx };
+        hash_value = hash_words(0, fields, sizeof(fields) / sizeof(fields[0]));
+        hash_value = hash_words(hash_value, k.vec1.data(), k.vec1.size());
+        hash_value = hash_words(hash_value, k.vec2.data(), k.vec2.size());
+    }
+    else {
+        hash_value = hash_words(0, &match_id_idx, 1);
     }
 
-    const_cast<ccl_sched_key&>(k).set_hasher_result(hash_value);
+    auto& key = const_cast<ccl_sched_key&>(k);
+    key.match_id_idx = match_id_idx;
+    key.set_hasher_result(hash_value);
 
     LOG_DEBUG("hash_value ", hash_value);
     k.print();
@@ -56,6 +56,9 @@ public:
 
     bool has_hasher_result = false;
 
+    /* interned match_id, valid once hasher_result is set, 0 stands for empty match_id */
+    size_t match_id_idx = 0;
+
     struct ccl_sched_key_inner_fields {
         ccl_coll_type ctype = ccl_coll_undefined;
         void* buf1 = nullptr; /* non-data buffer which can be used for caching */
@@ -88,8 +91,9 @@ public:
 
 class ccl_sched_key_hasher {
 public:
+    /* content hash is computed once per key and cached inside it */
     size_t operator()(const ccl_sched_key& k) const;
 
 private:
-    std::hash<std::string> string_hasher{};
+    static size_t intern_match_id(const std::string& match_id);
 };
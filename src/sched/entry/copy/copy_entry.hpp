@@ -34,6 +34,10 @@ public:
         return class_name();
     }
 
+    bool is_atl_ep_bound() const override {
+        return false;
+    }
+
     copy_entry() = delete;
     copy_entry(ccl_sched* sched,
                ccl_buffer in_buf,
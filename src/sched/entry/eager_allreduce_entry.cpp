@@ -0,0 +1,201 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "comp/comp.hpp"
+#include "sched/entry/eager_allreduce_entry.hpp"
+#include "sched/queue/queue.hpp"
+#include "sched/sched.hpp"
+
+eager_allreduce_entry::eager_allreduce_entry(ccl_sched* sched,
+                                             ccl_buffer send_buf,
+                                             ccl_buffer recv_buf,
+                                             size_t count,
+                                             const ccl_datatype& dtype,
+                                             ccl::reduction op,
+                                             ccl_comm* comm)
+        : sched_entry(sched),
+          send_buf(send_buf),
+          recv_buf(recv_buf),
+          count(count),
+          dtype(dtype),
+          op(op),
+          fn(sched->coll_attr.reduction_fn),
+          comm(comm),
+          bytes(count * dtype.size()) {
+    CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
+                     "custom reduction requires user provided callback");
+
+    int rank = comm->rank();
+    int comm_size = comm->size();
+    int pof2 = comm->pof2();
+    int rem = comm_size - pof2;
+    int newrank = rank - rem;
+    int recv_count = 0;
+
+    // the same steps as in ccl_coll_build_recursive_doubling_allreduce
+    if (rank < 2 * rem) {
+        if (rank % 2 == 0) {
+            steps.push_back({ rank + 1, true, false, -1 });
+            newrank = -1;
+        }
+        else {
+            steps.push_back({ rank - 1, false, true, recv_count++ });
+            newrank = rank / 2;
+        }
+    }
+
+    if (newrank != -1) {
+        for (int mask = 0x1; mask < pof2; mask <<= 1) {
+            int newdst = newrank ^ mask;
+            int dst = (newdst < rem) ? newdst * 2 + 1 : newdst + rem;
+            steps.push_back({ dst, true, true, recv_count++ });
+        }
+    }
+
+    if (rank < 2 * rem) {
+        if (rank % 2) {
+            steps.push_back({ rank - 1, true, false, -1 });
+        }
+        else {
+            steps.push_back({ rank + 1, false, false, recv_count++ });
+        }
+    }
+
+    for (size_t idx = 0; idx < steps.size(); idx++) {
+        if (steps[idx].reduce) {
+            final_reduce_step_idx = idx;
+        }
+    }
+
+    recv_reqs.resize(recv_count);
+    if (recv_count) {
+        tmp_buf = sched->alloc_buffer({ recv_count * bytes, send_buf });
+    }
+}
+
+void eager_allreduce_entry::reset(size_t idx) {
+    sched_entry::reset(idx);
+    posted_recv_count = 0;
+    step_idx = 0;
+    is_send_posted = false;
+}
+
+void* eager_allreduce_entry::get_recv_slot(const step_t& step) {
+    return static_cast<char*>(tmp_buf.get_ptr(recv_reqs.size() * bytes)) + step.recv_idx * bytes;
+}
+
+bool eager_allreduce_entry::check_req(atl_req_t& req) {
+    if (!req.is_completed) {
+        atl_status_t atl_status = comm->get_atl_comm()->check(sched->bin->get_atl_ep(), req);
+        if (unlikely(atl_status != ATL_STATUS_SUCCESS)) {
+            CCL_THROW("EAGER_ALLREDUCE entry failed. atl_status: ", atl_status_to_str(atl_status));
+        }
+    }
+    return req.is_completed;
+}
+
+void eager_allreduce_entry::start() {
+    if (posted_recv_count == 0) {
+        atl_tag = comm->get_atl_comm()->tag_creator->create(
+            comm->rank(), comm->get_comm_id(), sched->sched_id, sched->get_op_id());
+
+        // the final result of an excluded rank is received into recv_buf,
+        // so the local data has to be there before the receive is posted
+        if (send_buf != recv_buf) {
+            memcpy(recv_buf.get_ptr(bytes), send_buf.get_ptr(bytes), bytes);
+        }
+    }
+
+    // post receives of all steps, the peers may send before the previous steps are done here
+    for (auto& step : steps) {
+        if (step.recv_idx < static_cast<int>(posted_recv_count)) {
+            continue;
+        }
+
+        void* buf = (step.reduce) ? get_recv_slot(step) : recv_buf.get_ptr(bytes);
+        uint64_t tag = comm->get_atl_comm()->tag_creator->create(
+            step.peer, comm->get_comm_id(), sched->sched_id, sched->get_op_id());
+        atl_status_t atl_status = comm->get_atl_comm()->recv(sched->bin->get_atl_ep(),
+                                                             buf,
+                                                             bytes,
+                                                             step.peer,
+                                                             tag,
+                                                             recv_reqs[step.recv_idx]);
+        update_status(atl_status);
+        if (status == ccl_sched_entry_status_again) {
+            return;
+        }
+        posted_recv_count++;
+    }
+
+    LOG_DEBUG("EAGER_ALLREDUCE entry posted ", posted_recv_count, " receives, tag ", atl_tag);
+    status = ccl_sched_entry_status_started;
+    update();
+}
+
+void eager_allreduce_entry::update() {
+    while (step_idx < steps.size()) {
+        auto& step = steps[step_idx];
+
+        if (step.send) {
+            if (!is_send_posted) {
+                atl_status_t atl_status = comm->get_atl_comm()->send(sched->bin->get_atl_ep(),
+                                                                     recv_buf.get_ptr(bytes),
+                                                                     bytes,
+                                                                     step.peer,
+                                                                     atl_tag,
+                                                                     send_req);
+                if (atl_status == ATL_STATUS_AGAIN) {
+                    return;
+                }
+                update_status(atl_status);
+                is_send_posted = true;
+            }
+            // recv_buf is sent as is, it can be updated only after the send is done
+            if (!check_req(send_req)) {
+                return;
+            }
+        }
+
+        if (step.recv_idx >= 0) {
+            if (!check_req(recv_reqs[step.recv_idx])) {
+                return;
+            }
+            if (step.reduce) {
+                size_t offset = recv_buf.get_offset();
+                const ccl::fn_context context = { sched->coll_attr.match_id.c_str(), offset };
+                ccl::status comp_status = ccl_comp_reduce(sched,
+                                                          get_recv_slot(step),
+                                                          count,
+                                                          recv_buf.get_ptr(bytes),
+                                                          nullptr,
+                                                          dtype,
+                                                          op,
+                                                          fn,
+                                                          &context,
+                                                          (step_idx == final_reduce_step_idx)
+                                                              ? comm->size()
+                                                              : 1);
+                CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+            }
+        }
+
+        step_idx++;
+        is_send_posted = false;
+    }
+
+    LOG_DEBUG("EAGER_ALLREDUCE entry done");
+    status = ccl_sched_entry_status_complete;
+}
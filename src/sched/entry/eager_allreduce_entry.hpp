@@ -0,0 +1,104 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/global/global.hpp"
+#include "sched/entry/entry.hpp"
+
+#include <vector>
+
+// recursive doubling allreduce of a tiny message in a single entry:
+// receives of all steps are posted on start into own slots of the tmp buffer,
+// so the data of peers is matched on arrival and every step is a send and a local reduction
+class eager_allreduce_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "EAGER_ALLREDUCE";
+    }
+
+    const char* name() const noexcept override {
+        return class_name();
+    }
+
+    eager_allreduce_entry() = delete;
+    explicit eager_allreduce_entry(ccl_sched* sched,
+                                   ccl_buffer send_buf,
+                                   ccl_buffer recv_buf,
+                                   size_t count,
+                                   const ccl_datatype& dtype,
+                                   ccl::reduction op,
+                                   ccl_comm* comm);
+
+    void reset(size_t idx) override;
+    void start() override;
+    void update() override;
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "dt ",
+                           ccl::global_data::get().dtypes->name(dtype),
+                           ", send_buf ",
+                           send_buf,
+                           ", recv_buf ",
+                           recv_buf,
+                           ", count ",
+                           count,
+                           ", op ",
+                           ccl_reduction_to_str(op),
+                           ", atl_tag ",
+                           atl_tag,
+                           ", step ",
+                           step_idx,
+                           "/",
+                           steps.size(),
+                           "\n");
+    }
+
+private:
+    struct step_t {
+        int peer;
+        bool send;
+        // the received data is reduced into recv_buf, otherwise it is the final result
+        bool reduce;
+        // index of the receive, -1 if the step has no receive
+        int recv_idx;
+    };
+
+    void* get_recv_slot(const step_t& step);
+    bool check_req(atl_req_t& req);
+
+    const ccl_buffer send_buf;
+    const ccl_buffer recv_buf;
+    const size_t count;
+    const ccl_datatype dtype;
+    const ccl::reduction op;
+    const ccl::reduction_fn fn;
+    ccl_comm* comm;
+    const size_t bytes;
+
+    std::vector<step_t> steps;
+    // the reduction which completes the result, avg is divided there
+    size_t final_reduce_step_idx = 0;
+    ccl_buffer tmp_buf;
+
+    uint64_t atl_tag = 0;
+    std::vector<atl_req_t> recv_reqs;
+    atl_req_t send_req{};
+    size_t posted_recv_count = 0;
+    size_t step_idx = 0;
+    bool is_send_posted = false;
+};
@@ -237,6 +237,11 @@ ccl_sched* sched_entry::get_sched() const {
     return sched;
 }
 
+bool sched_entry::is_atl_ep_bound() const {
+    /* conservative default, only purely local entries opt out */
+    return true;
+}
+
 void sched_entry::set_exec_mode(ccl_sched_entry_exec_mode mode) {
     exec_mode = mode;
 }
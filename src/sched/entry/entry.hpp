@@ -98,6 +98,9 @@ public:
 
     ccl_sched* get_sched() const;
 
+    /* whether the entry posts operations on the ATL endpoint of its bin */
+    virtual bool is_atl_ep_bound() const;
+
 protected:
     virtual void start() = 0;
     virtual void update();
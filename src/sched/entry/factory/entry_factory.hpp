@@ -30,16 +30,22 @@
 #include "sched/entry/copy/copy_entry.hpp"
 #include "sched/entry/deps_entry.hpp"
 #include "sched/entry/deregister_entry.hpp"
+#include "sched/entry/eager_allreduce_entry.hpp"
 #include "sched/entry/function_entry.hpp"
 #include "sched/entry/probe_entry.hpp"
 #include "sched/entry/recv_entry.hpp"
 #include "sched/entry/recv_copy_entry.hpp"
 #include "sched/entry/recv_reduce_entry.hpp"
 #include "sched/entry/reduce_local_entry.hpp"
+#include "sched/entry/reduce_local_multi_entry.hpp"
+#include "sched/entry/ring_allreduce_entry.hpp"
 #include "sched/entry/register_entry.hpp"
 #include "sched/entry/send_entry.hpp"
+#include "sched/entry/sendv_entry.hpp"
+#include "sched/entry/shm_coll_entry.hpp"
 #include "sched/entry/subsched_entry.hpp"
 #include "sched/entry/sync_entry.hpp"
+#include "sched/entry/tree_allreduce_entry.hpp"
 #include "sched/entry/wait_value_entry.hpp"
 #include "sched/entry/write_entry.hpp"
 
@@ -38,6 +38,10 @@ public:
         return "FUNCTION";
     }
 
+    bool is_atl_ep_bound() const override {
+        return false;
+    }
+
 protected:
     void dump_detail(std::stringstream& str) const override {
         ccl_logger::format(str, "fn ", (void*)(fn), ", ctx ", ctx, "\n");
@@ -40,7 +40,8 @@ public:
                       int src,
                       ccl_comm* comm,
                       ccl_buffer comm_buf = ccl_buffer(),
-                      ccl_recv_reduce_result_buf_type result_buf_type = ccl_recv_reduce_local_buf)
+                      ccl_recv_reduce_result_buf_type result_buf_type = ccl_recv_reduce_local_buf,
+                      size_t avg_divisor = 1)
             : sched_entry(sched),
               inout_buf(inout_buf),
               in_cnt(cnt),
@@ -50,7 +51,8 @@ public:
               comm(comm),
               comm_buf(comm_buf),
               result_buf_type(result_buf_type),
-              fn(sched->coll_attr.reduction_fn) {
+              fn(sched->coll_attr.reduction_fn),
+              avg_divisor(avg_divisor) {
         CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
                          "custom reduction requires user provided callback",
                          ", op ",
@@ -127,7 +129,8 @@ public:
                                                   dtype,
                                                   op,
                                                   fn,
-                                                  &context);
+                                                  &context,
+                                                  avg_divisor);
 
         CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
         status = ccl_sched_entry_status_complete;
@@ -149,6 +152,8 @@ protected:
                            in_cnt,
                            ", op ",
                            ccl_reduction_to_str(op),
+                           ", avg_divisor ",
+                           avg_divisor,
                            ", red_fn  ",
                            fn,
                            ", src ",
@@ -177,5 +182,6 @@ private:
     ccl_recv_reduce_result_buf_type result_buf_type;
     uint64_t atl_tag = 0;
     ccl::reduction_fn fn;
+    size_t avg_divisor;
     atl_req_t req{};
 };
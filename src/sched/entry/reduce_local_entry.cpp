@@ -70,7 +70,8 @@ reduce_local_entry::reduce_local_entry(ccl_sched* sched,
                                        ccl_buffer inout_buf,
                                        size_t* out_cnt,
                                        const ccl_datatype& dtype,
-                                       ccl::reduction op)
+                                       ccl::reduction op,
+                                       size_t avg_divisor)
         : sched_entry(sched),
           in_buf(in_buf),
           in_cnt(in_cnt),
@@ -78,7 +79,8 @@ reduce_local_entry::reduce_local_entry(ccl_sched* sched,
           out_cnt(out_cnt),
           dtype(dtype),
           op(op),
-          fn(sched->coll_attr.reduction_fn) {
+          fn(sched->coll_attr.reduction_fn),
+          avg_divisor(avg_divisor) {
     CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
                      "custom reduction requires user provided callback",
                      ", op ",
@@ -107,7 +109,8 @@ void reduce_local_entry::start_on_host() {
                                               dtype,
                                               op,
                                               fn,
-                                              &context);
+                                              &context,
+                                              avg_divisor);
     CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
 
     status = ccl_sched_entry_status_complete;
@@ -32,6 +32,10 @@ public:
         return class_name();
     }
 
+    bool is_atl_ep_bound() const override {
+        return false;
+    }
+
     reduce_local_entry() = delete;
     explicit reduce_local_entry(ccl_sched* sched,
                                 const ccl_buffer in_buf,
@@ -39,7 +43,8 @@ public:
                                 ccl_buffer inout_buf,
                                 size_t* out_cnt,
                                 const ccl_datatype& dtype,
-                                ccl::reduction op);
+                                ccl::reduction op,
+                                size_t avg_divisor = 1);
 
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     void check_use_device();
@@ -69,6 +74,8 @@ protected:
                            out_cnt,
                            ", op ",
                            ccl_reduction_to_str(op),
+                           ", avg_divisor ",
+                           avg_divisor,
                            ", red_fn ",
                            fn,
                            "\n");
@@ -82,6 +89,7 @@ private:
     const ccl_datatype dtype;
     const ccl::reduction op;
     const ccl::reduction_fn fn;
+    const size_t avg_divisor;
 
     bool use_device{};
 
@@ -0,0 +1,118 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/global/global.hpp"
+#include "comp/comp.hpp"
+#include "sched/entry/entry.hpp"
+
+#include <vector>
+
+// reduces several local buffers into inout_buf in a single pass over inout_buf
+class reduce_local_multi_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "REDUCE_LOCAL_MULTI";
+    }
+
+    const char* name() const noexcept override {
+        return class_name();
+    }
+
+    bool is_atl_ep_bound() const override {
+        return false;
+    }
+
+    reduce_local_multi_entry() = delete;
+    explicit reduce_local_multi_entry(ccl_sched* sched,
+                                      const std::vector<ccl_buffer>& in_bufs,
+                                      size_t in_cnt,
+                                      ccl_buffer inout_buf,
+                                      const ccl_datatype& dtype,
+                                      ccl::reduction op,
+                                      size_t avg_divisor = 1)
+            : sched_entry(sched),
+              in_bufs(in_bufs),
+              in_cnt(in_cnt),
+              inout_buf(inout_buf),
+              dtype(dtype),
+              op(op),
+              fn(sched->coll_attr.reduction_fn),
+              avg_divisor(avg_divisor) {
+        CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
+                         "custom reduction requires user provided callback",
+                         ", op ",
+                         ccl_reduction_to_str(op),
+                         ", fn ",
+                         fn);
+        in_ptrs.resize(in_bufs.size());
+    }
+
+    void start() override {
+        size_t bytes = in_cnt * dtype.size();
+        size_t offset = inout_buf.get_offset();
+        const ccl::fn_context context = { sched->coll_attr.match_id.c_str(), offset };
+
+        for (size_t idx = 0; idx < in_bufs.size(); idx++) {
+            in_ptrs[idx] = in_bufs[idx].get_ptr(bytes);
+        }
+
+        ccl::status comp_status = ccl_comp_reduce_n(sched,
+                                                    in_ptrs.data(),
+                                                    in_ptrs.size(),
+                                                    in_cnt,
+                                                    inout_buf.get_ptr(bytes),
+                                                    dtype,
+                                                    op,
+                                                    fn,
+                                                    &context,
+                                                    avg_divisor);
+        CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+
+        status = ccl_sched_entry_status_complete;
+    }
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "dt ",
+                           ccl::global_data::get().dtypes->name(dtype),
+                           ", in_bufs ",
+                           in_bufs.size(),
+                           ", in_cnt ",
+                           in_cnt,
+                           ", inout_buf ",
+                           inout_buf,
+                           ", op ",
+                           ccl_reduction_to_str(op),
+                           ", avg_divisor ",
+                           avg_divisor,
+                           ", red_fn ",
+                           fn,
+                           "\n");
+    }
+
+private:
+    const std::vector<ccl_buffer> in_bufs;
+    const size_t in_cnt;
+    const ccl_buffer inout_buf;
+    const ccl_datatype dtype;
+    const ccl::reduction op;
+    const ccl::reduction_fn fn;
+    const size_t avg_divisor;
+
+    std::vector<void*> in_ptrs;
+};
@@ -0,0 +1,376 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "comp/comp.hpp"
+#include "sched/entry/ring_allreduce_entry.hpp"
+#include "sched/queue/queue.hpp"
+#include "sched/sched.hpp"
+
+// auto segment size: about this number of segments per block within the bounds below
+#define CCL_RING_ALLREDUCE_SEGMENTS_PER_BLOCK 8
+#define CCL_RING_ALLREDUCE_MIN_SEGMENT_SIZE   (64 * 1024)
+#define CCL_RING_ALLREDUCE_MAX_SEGMENT_SIZE   (1024 * 1024)
+
+ring_allreduce_entry::ring_allreduce_entry(ccl_sched* sched,
+                                           ccl_buffer send_buf,
+                                           ccl_buffer recv_buf,
+                                           size_t count,
+                                           size_t segment_count,
+                                           const ccl_datatype& dtype,
+                                           ccl::reduction op,
+                                           ccl_comm* comm)
+        : sched_entry(sched),
+          send_buf(send_buf),
+          recv_buf(recv_buf),
+          count(count),
+          segment_count(segment_count),
+          dtype(dtype),
+          op(op),
+          fn(sched->coll_attr.reduction_fn),
+          comm(comm),
+          inplace(send_buf == recv_buf),
+          wire_dtype(get_wire_dtype(dtype, op)),
+          is_compressed(wire_dtype != dtype.idx()),
+          wire_dtype_size(ccl::global_data::get().dtypes->get(wire_dtype).size()) {
+    CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
+                     "custom reduction requires user provided callback");
+    CCL_THROW_IF_NOT(segment_count > 0, "unexpected segment_count ", segment_count);
+
+    rank = comm->rank();
+    comm_size = comm->size();
+    src = (comm_size + rank - 1) % comm_size;
+    dst = (rank + 1) % comm_size;
+
+    // the same blocks as in ccl_coll_build_ring_allreduce, the last block gets the remainder
+    main_block_count = count / comm_size;
+    size_t last_block_count = main_block_count + count % comm_size;
+    size_t seg_num = (last_block_count + segment_count - 1) / segment_count;
+    segs.resize(seg_num);
+
+    // reduce_scatter steps followed by allgather steps
+    step_count = 2 * (comm_size - 1);
+
+    if (is_compressed) {
+        // two slots per segment: the data being sent and the data being received
+        wire_buf = sched->alloc_buffer({ 2 * seg_num * segment_count * wire_dtype_size, send_buf });
+    }
+    else if (inplace) {
+        tmp_buf = sched->alloc_buffer({ seg_num * segment_count * dtype.size(), send_buf });
+    }
+}
+
+size_t ring_allreduce_entry::get_segment_count(size_t count,
+                                               const ccl_datatype& dtype,
+                                               int comm_size) {
+    size_t segment_size = ccl::global_data::env().allreduce_ring_segment_size;
+    if (!segment_size) {
+        size_t block_size = count * dtype.size() / comm_size;
+        segment_size = std::min(
+            std::max(block_size / CCL_RING_ALLREDUCE_SEGMENTS_PER_BLOCK,
+                     static_cast<size_t>(CCL_RING_ALLREDUCE_MIN_SEGMENT_SIZE)),
+            static_cast<size_t>(CCL_RING_ALLREDUCE_MAX_SEGMENT_SIZE));
+    }
+    return std::max(segment_size / dtype.size(), size_t(1));
+}
+
+ccl::datatype ring_allreduce_entry::get_wire_dtype(const ccl_datatype& dtype, ccl::reduction op) {
+    if (dtype.idx() != ccl::datatype::float32 ||
+        (op != ccl::reduction::sum && op != ccl::reduction::avg)) {
+        return dtype.idx();
+    }
+    switch (ccl::global_data::env().allreduce_compression) {
+        case ccl_compression_bf16: return ccl::datatype::bfloat16;
+        case ccl_compression_fp16: return ccl::datatype::float16;
+        default: return dtype.idx();
+    }
+}
+
+void ring_allreduce_entry::reset(size_t idx) {
+    sched_entry::reset(idx);
+    for (auto& seg : segs) {
+        seg.step = 0;
+        seg.is_send_posted = false;
+        seg.is_recv_posted = false;
+        seg.send_slot = 0;
+    }
+    send_pos = 0;
+    recv_pos = 0;
+    done_seg_count = 0;
+}
+
+size_t ring_allreduce_entry::get_block_idx(size_t step, bool is_send) const {
+    int shift;
+    if (step < static_cast<size_t>(comm_size - 1)) {
+        // reduce_scatter: the result of the previous step is sent further
+        shift = (is_send) ? -static_cast<int>(step) : -static_cast<int>(step) - 1;
+    }
+    else {
+        // allgather: starts from the block fully reduced on this rank
+        int ag_step = static_cast<int>(step) - (comm_size - 1);
+        shift = (is_send) ? 1 - ag_step : -ag_step;
+    }
+    return (rank + shift + 2 * comm_size) % comm_size;
+}
+
+size_t ring_allreduce_entry::get_seg_offset(size_t block_idx, size_t seg_idx) const {
+    return (block_idx * main_block_count + seg_idx * segment_count) * dtype.size();
+}
+
+size_t ring_allreduce_entry::get_seg_count(size_t block_idx, size_t seg_idx) const {
+    size_t block_count = (block_idx == static_cast<size_t>(comm_size - 1))
+                             ? main_block_count + count % comm_size
+                             : main_block_count;
+    size_t seg_start = seg_idx * segment_count;
+    return (seg_start < block_count) ? std::min(segment_count, block_count - seg_start) : 0;
+}
+
+void* ring_allreduce_entry::get_tmp_slot(size_t seg_idx) const {
+    return static_cast<char*>(tmp_buf.get_ptr()) + seg_idx * segment_count * dtype.size();
+}
+
+void* ring_allreduce_entry::get_wire_slot(size_t seg_idx, size_t slot) const {
+    return static_cast<char*>(wire_buf.get_ptr()) +
+           (2 * seg_idx + slot) * segment_count * wire_dtype_size;
+}
+
+bool ring_allreduce_entry::check_req(atl_req_t& req) {
+    if (!req.is_completed) {
+        atl_status_t atl_status = comm->get_atl_comm()->check(sched->bin->get_atl_ep(), req);
+        if (unlikely(atl_status != ATL_STATUS_SUCCESS)) {
+            CCL_THROW("RING_ALLREDUCE entry failed. atl_status: ", atl_status_to_str(atl_status));
+        }
+    }
+    return req.is_completed;
+}
+
+bool ring_allreduce_entry::post_sends() {
+    bool is_posted = false;
+
+    while (send_pos < step_count * segs.size()) {
+        size_t step = send_pos / segs.size();
+        size_t seg_idx = send_pos % segs.size();
+        auto& seg = segs[seg_idx];
+
+        // the segment has to finish the previous step to have the data to send
+        if (seg.step != step) {
+            break;
+        }
+
+        size_t block_idx = get_block_idx(step, true /* is_send */);
+        size_t seg_count = get_seg_count(block_idx, seg_idx);
+        if (seg_count) {
+            size_t seg_bytes = seg_count * dtype.size();
+            ccl_buffer buf =
+                ((step == 0) ? send_buf : recv_buf) + get_seg_offset(block_idx, seg_idx);
+            void* send_ptr = buf.get_ptr(seg_bytes);
+            if (is_compressed) {
+                send_ptr = get_wire_slot(seg_idx, seg.send_slot);
+                // allgather steps after the first one forward the received wire data as is
+                if (step < static_cast<size_t>(comm_size)) {
+                    // the fully reduced block is rounded in place as well
+                    // to get the same result on all ranks
+                    ccl::status comp_status =
+                        ccl_comp_compress(buf.get_ptr(seg_bytes),
+                                          send_ptr,
+                                          seg_count,
+                                          wire_dtype,
+                                          step == static_cast<size_t>(comm_size - 1));
+                    CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+                }
+                seg_bytes = seg_count * wire_dtype_size;
+            }
+            atl_status_t atl_status = comm->get_atl_comm()->send(sched->bin->get_atl_ep(),
+                                                                 send_ptr,
+                                                                 seg_bytes,
+                                                                 dst,
+                                                                 send_tag,
+                                                                 seg.send_req);
+            if (atl_status == ATL_STATUS_AGAIN) {
+                break;
+            }
+            update_status(atl_status);
+        }
+        else {
+            seg.send_req.is_completed = 1;
+        }
+
+        seg.is_send_posted = true;
+        send_pos++;
+        is_posted = true;
+    }
+
+    return is_posted;
+}
+
+bool ring_allreduce_entry::post_recvs() {
+    bool is_posted = false;
+
+    while (recv_pos < step_count * segs.size()) {
+        size_t step = recv_pos / segs.size();
+        size_t seg_idx = recv_pos % segs.size();
+        auto& seg = segs[seg_idx];
+
+        // the receive buffer of the segment is free only when the previous step is done
+        if (seg.step != step) {
+            break;
+        }
+
+        size_t block_idx = get_block_idx(step, false /* is_send */);
+        size_t seg_count = get_seg_count(block_idx, seg_idx);
+        if (seg_count) {
+            size_t seg_bytes = seg_count * dtype.size();
+            void* buf = nullptr;
+            if (is_compressed) {
+                buf = get_wire_slot(seg_idx, 1 - seg.send_slot);
+                seg_bytes = seg_count * wire_dtype_size;
+            }
+            else if (inplace && step < static_cast<size_t>(comm_size - 1)) {
+                buf = get_tmp_slot(seg_idx);
+            }
+            else {
+                buf = (recv_buf + get_seg_offset(block_idx, seg_idx)).get_ptr(seg_bytes);
+            }
+            atl_status_t atl_status = comm->get_atl_comm()->recv(sched->bin->get_atl_ep(),
+                                                                 buf,
+                                                                 seg_bytes,
+                                                                 src,
+                                                                 recv_tag,
+                                                                 seg.recv_req);
+            if (atl_status == ATL_STATUS_AGAIN) {
+                break;
+            }
+            update_status(atl_status);
+        }
+        else {
+            seg.recv_req.is_completed = 1;
+        }
+
+        seg.is_recv_posted = true;
+        recv_pos++;
+        is_posted = true;
+    }
+
+    return is_posted;
+}
+
+void ring_allreduce_entry::start() {
+    send_tag = comm->get_atl_comm()->tag_creator->create(
+        rank, comm->get_comm_id(), sched->sched_id, sched->get_op_id());
+    recv_tag = comm->get_atl_comm()->tag_creator->create(
+        src, comm->get_comm_id(), sched->sched_id, sched->get_op_id());
+
+    LOG_DEBUG("RING_ALLREDUCE entry: count ",
+              count,
+              ", segment_count ",
+              segment_count,
+              ", segments ",
+              segs.size(),
+              ", wire dt ",
+              ccl::global_data::get().dtypes->name(wire_dtype),
+              ", send_tag ",
+              send_tag);
+
+    status = ccl_sched_entry_status_started;
+    update();
+}
+
+void ring_allreduce_entry::update() {
+    size_t rs_step_count = comm_size - 1;
+
+    bool is_progressed = true;
+    while (is_progressed) {
+        is_progressed = post_sends();
+        is_progressed |= post_recvs();
+
+        for (size_t seg_idx = 0; seg_idx < segs.size(); seg_idx++) {
+            auto& seg = segs[seg_idx];
+            if (seg.step == step_count || !seg.is_send_posted || !seg.is_recv_posted) {
+                continue;
+            }
+            if (!check_req(seg.recv_req) || !check_req(seg.send_req)) {
+                continue;
+            }
+
+            if (is_compressed) {
+                size_t block_idx = get_block_idx(seg.step, false /* is_send */);
+                size_t seg_count = get_seg_count(block_idx, seg_idx);
+                size_t offset = get_seg_offset(block_idx, seg_idx);
+                if (seg_count) {
+                    size_t seg_bytes = seg_count * dtype.size();
+                    const void* wire_slot = get_wire_slot(seg_idx, 1 - seg.send_slot);
+                    void* out_buf = (recv_buf + offset).get_ptr(seg_bytes);
+                    ccl::status comp_status = ccl::status::success;
+                    if (seg.step < rs_step_count) {
+                        comp_status = ccl_comp_reduce_compressed(
+                            wire_slot,
+                            (send_buf + offset).get_ptr(seg_bytes),
+                            out_buf,
+                            seg_count,
+                            wire_dtype,
+                            op,
+                            (seg.step == rs_step_count - 1) ? comm_size : 1);
+                    }
+                    else {
+                        comp_status =
+                            ccl_comp_decompress(wire_slot, out_buf, seg_count, wire_dtype);
+                    }
+                    CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+                }
+                // the received wire data is sent on the next step
+                seg.send_slot = 1 - seg.send_slot;
+            }
+            else if (seg.step < rs_step_count) {
+                size_t block_idx = get_block_idx(seg.step, false /* is_send */);
+                size_t seg_count = get_seg_count(block_idx, seg_idx);
+                size_t offset = get_seg_offset(block_idx, seg_idx);
+                if (seg_count) {
+                    size_t seg_bytes = seg_count * dtype.size();
+                    // in-place data was received into the tmp slot, otherwise into recv_buf
+                    const void* in_buf =
+                        (inplace) ? get_tmp_slot(seg_idx) : (send_buf + offset).get_ptr(seg_bytes);
+                    void* inout_buf = (recv_buf + offset).get_ptr(seg_bytes);
+                    const ccl::fn_context context = { sched->coll_attr.match_id.c_str(),
+                                                      recv_buf.get_offset() + offset };
+                    ccl::status comp_status = ccl_comp_reduce(sched,
+                                                              in_buf,
+                                                              seg_count,
+                                                              inout_buf,
+                                                              nullptr,
+                                                              dtype,
+                                                              op,
+                                                              fn,
+                                                              &context,
+                                                              (seg.step == rs_step_count - 1)
+                                                                  ? comm_size
+                                                                  : 1);
+                    CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+                }
+            }
+
+            seg.step++;
+            seg.is_send_posted = false;
+            seg.is_recv_posted = false;
+            if (seg.step == step_count) {
+                done_seg_count++;
+            }
+            is_progressed = true;
+        }
+    }
+
+    if (done_seg_count == segs.size()) {
+        LOG_DEBUG("RING_ALLREDUCE entry done");
+        status = ccl_sched_entry_status_complete;
+    }
+}
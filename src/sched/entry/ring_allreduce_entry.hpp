@@ -0,0 +1,139 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/global/global.hpp"
+#include "sched/entry/entry.hpp"
+
+#include <vector>
+
+// segmented ring allreduce (reduce_scatter + allgather) in a single entry:
+// every block is split into segments which go through the ring steps independently,
+// so the reduction of one segment overlaps the transfers of the neighbour segments.
+// Sends and receives are posted in (step, segment) order, the same on all ranks,
+// to keep matching by a single tag.
+// With CCL_ALLREDUCE_COMPRESSION float32 segments go over the wire in 16-bit format:
+// they are converted right before the send and converted back within the reduction
+class ring_allreduce_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "RING_ALLREDUCE";
+    }
+
+    const char* name() const noexcept override {
+        return class_name();
+    }
+
+    ring_allreduce_entry() = delete;
+    explicit ring_allreduce_entry(ccl_sched* sched,
+                                  ccl_buffer send_buf,
+                                  ccl_buffer recv_buf,
+                                  size_t count,
+                                  size_t segment_count,
+                                  const ccl_datatype& dtype,
+                                  ccl::reduction op,
+                                  ccl_comm* comm);
+
+    // number of elements in a segment chosen from the message size and the comm size
+    static size_t get_segment_count(size_t count, const ccl_datatype& dtype, int comm_size);
+
+    // datatype used for transfers, the same as dtype if compression is not applicable
+    static ccl::datatype get_wire_dtype(const ccl_datatype& dtype, ccl::reduction op);
+
+    void reset(size_t idx) override;
+    void start() override;
+    void update() override;
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "dt ",
+                           ccl::global_data::get().dtypes->name(dtype),
+                           ", send_buf ",
+                           send_buf,
+                           ", recv_buf ",
+                           recv_buf,
+                           ", count ",
+                           count,
+                           ", segment_count ",
+                           segment_count,
+                           ", segments ",
+                           segs.size(),
+                           ", op ",
+                           ccl_reduction_to_str(op),
+                           ", wire dt ",
+                           ccl::global_data::get().dtypes->name(wire_dtype),
+                           ", send_tag ",
+                           send_tag,
+                           ", posted sends ",
+                           send_pos,
+                           ", posted recvs ",
+                           recv_pos,
+                           "/",
+                           step_count * segs.size(),
+                           "\n");
+    }
+
+private:
+    struct segment_t {
+        size_t step = 0;
+        atl_req_t send_req{};
+        atl_req_t recv_req{};
+        bool is_send_posted = false;
+        bool is_recv_posted = false;
+        // compressed data: index of the wire slot to send from, the other one is received into
+        size_t send_slot = 0;
+    };
+
+    size_t get_block_idx(size_t step, bool is_send) const;
+    size_t get_seg_offset(size_t block_idx, size_t seg_idx) const;
+    size_t get_seg_count(size_t block_idx, size_t seg_idx) const;
+    void* get_tmp_slot(size_t seg_idx) const;
+    void* get_wire_slot(size_t seg_idx, size_t slot) const;
+    bool post_sends();
+    bool post_recvs();
+    bool check_req(atl_req_t& req);
+
+    const ccl_buffer send_buf;
+    const ccl_buffer recv_buf;
+    const size_t count;
+    const size_t segment_count;
+    const ccl_datatype dtype;
+    const ccl::reduction op;
+    const ccl::reduction_fn fn;
+    ccl_comm* comm;
+    const bool inplace;
+    const ccl::datatype wire_dtype;
+    const bool is_compressed;
+    const size_t wire_dtype_size;
+
+    int rank;
+    int comm_size;
+    int src;
+    int dst;
+    size_t main_block_count;
+    size_t step_count;
+
+    std::vector<segment_t> segs;
+    ccl_buffer tmp_buf;
+    ccl_buffer wire_buf;
+
+    uint64_t send_tag = 0;
+    uint64_t recv_tag = 0;
+    size_t send_pos = 0;
+    size_t recv_pos = 0;
+    size_t done_seg_count = 0;
+};
@@ -0,0 +1,125 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/global/global.hpp"
+#include "sched/entry/entry.hpp"
+#include "sched/queue/queue.hpp"
+
+#include <vector>
+
+// sends several buffers as a single message without packing them into a staging buffer
+class sendv_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "SENDV";
+    }
+
+    sendv_entry() = delete;
+    sendv_entry(ccl_sched* sched,
+                const std::vector<ccl_buffer>& bufs,
+                const std::vector<size_t>& cnts,
+                const ccl_datatype& dtype,
+                int dst,
+                ccl_comm* comm)
+            : sched_entry(sched),
+              bufs(bufs),
+              cnts(cnts),
+              dtype(dtype),
+              dst(dst),
+              comm(comm) {
+        CCL_THROW_IF_NOT(bufs.size() == cnts.size(),
+                         "unexpected number of counts ",
+                         cnts.size(),
+                         ", expected ",
+                         bufs.size());
+        iov.resize(bufs.size());
+    }
+
+    void start() override {
+        size_t bytes = 0;
+        for (size_t idx = 0; idx < bufs.size(); idx++) {
+            size_t buf_bytes = cnts[idx] * dtype.size();
+            iov[idx].iov_base = bufs[idx].get_ptr(buf_bytes);
+            iov[idx].iov_len = buf_bytes;
+            bytes += buf_bytes;
+        }
+
+        atl_tag = comm->get_atl_comm()->tag_creator->create(
+            comm->rank(), comm->get_comm_id(), sched->sched_id, sched->get_op_id());
+        LOG_DEBUG("SENDV entry dst ",
+                  dst,
+                  ", tag ",
+                  atl_tag,
+                  ", req ",
+                  req,
+                  ", iov_count ",
+                  iov.size(),
+                  ", bytes ",
+                  bytes);
+
+        atl_status_t atl_status = comm->get_atl_comm()->sendv(
+            sched->bin->get_atl_ep(), iov.data(), iov.size(), dst, atl_tag, req);
+
+        update_status(atl_status);
+    }
+
+    void update() override {
+        atl_status_t atl_status = comm->get_atl_comm()->check(sched->bin->get_atl_ep(), req);
+
+        if (unlikely(atl_status != ATL_STATUS_SUCCESS)) {
+            CCL_THROW("SENDV entry failed. atl_status: ", atl_status_to_str(atl_status));
+        }
+
+        if (req.is_completed) {
+            LOG_DEBUG("SENDV entry done, dst ", dst);
+            status = ccl_sched_entry_status_complete;
+        }
+    }
+
+    const char* name() const override {
+        return class_name();
+    }
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "dt ",
+                           ccl::global_data::get().dtypes->name(dtype),
+                           ", iov_count ",
+                           bufs.size(),
+                           ", dst ",
+                           dst,
+                           ", atl_tag ",
+                           atl_tag,
+                           ", comm_id ",
+                           comm->get_comm_id(),
+                           ", req ",
+                           req,
+                           "\n");
+    }
+
+private:
+    const std::vector<ccl_buffer> bufs;
+    const std::vector<size_t> cnts;
+    const ccl_datatype dtype;
+    const int dst;
+    ccl_comm* comm;
+    uint64_t atl_tag = 0;
+    atl_req_t req{};
+
+    std::vector<struct iovec> iov;
+};
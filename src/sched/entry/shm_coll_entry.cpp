@@ -0,0 +1,379 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "comm/comm.hpp"
+#include "comp/comp.hpp"
+#include "sched/entry/shm_coll_entry.hpp"
+#include "sched/sched.hpp"
+
+#include <numeric>
+
+namespace {
+// below this size every rank reduces the whole message itself,
+// this saves one synchronization step compared to the partitioned reduction
+constexpr size_t shm_small_allreduce_size = 8192;
+
+size_t div_up(size_t value, size_t divisor) {
+    return (value + divisor - 1) / divisor;
+}
+} // namespace
+
+shm_coll_entry::shm_coll_entry(ccl_sched* sched,
+                               ccl_coll_type ctype,
+                               ccl_buffer send_buf,
+                               ccl_buffer recv_buf,
+                               size_t count,
+                               const size_t* recv_counts,
+                               const ccl_datatype& dtype,
+                               ccl::reduction op,
+                               int root,
+                               ccl_comm* comm)
+        : sched_entry(sched),
+          ctype(ctype),
+          send_buf(send_buf),
+          recv_buf(recv_buf),
+          count(count),
+          dtype(dtype),
+          op(op),
+          fn(sched->coll_attr.reduction_fn),
+          root(root),
+          ctx(comm->get_shm_coll_ctx()),
+          rank(comm->rank()),
+          comm_size(comm->size()),
+          dtype_size(dtype.size()) {
+    CCL_THROW_IF_NOT(ctx, "no shm segment for comm ", comm->id());
+    CCL_THROW_IF_NOT(ctx->size() == comm_size && ctx->rank() == rank,
+                     "unexpected shm segment: ",
+                     ctx->to_string());
+
+    size_t chunk_size = ctx->get_chunk_size();
+
+    if (ctype == ccl_coll_allreduce || ctype == ccl_coll_reduce_scatter) {
+        CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
+                         "custom reduction requires user provided callback");
+    }
+
+    switch (ctype) {
+        case ccl_coll_allreduce:
+            chunk_count = chunk_size / dtype_size;
+            chunk_num = div_up(count, chunk_count);
+            is_small_allreduce = (count * dtype_size <= shm_small_allreduce_size);
+            if (chunk_num) {
+                // write + reduce + gather per chunk, gather of a chunk overlaps with write
+                // of the next chunk as they use different halves of the rank buffer
+                phase_count = is_small_allreduce ? 2 : 2 * chunk_num + 1;
+            }
+            in_ptrs.resize(comm_size - 1);
+            break;
+        case ccl_coll_reduce_scatter:
+            chunk_count = chunk_size / (comm_size * dtype_size);
+            CCL_THROW_IF_NOT(chunk_count, "too many ranks ", comm_size, " for shm chunk size");
+            chunk_num = div_up(count, chunk_count);
+            if (chunk_num) {
+                phase_count = chunk_num + 1;
+            }
+            in_ptrs.resize(comm_size - 1);
+            break;
+        case ccl_coll_allgatherv: {
+            CCL_THROW_IF_NOT(recv_counts, "no recv_counts for allgatherv");
+            recv_offsets.resize(comm_size + 1, 0);
+            size_t max_bytes = 0;
+            for (int idx = 0; idx < comm_size; idx++) {
+                size_t bytes = recv_counts[idx] * dtype_size;
+                recv_offsets[idx + 1] = recv_offsets[idx] + bytes;
+                max_bytes = std::max(max_bytes, bytes);
+            }
+            chunk_count = chunk_size;
+            chunk_num = div_up(max_bytes, chunk_count);
+            if (chunk_num) {
+                phase_count = chunk_num + 1;
+            }
+            break;
+        }
+        case ccl_coll_bcast:
+            chunk_count = chunk_size;
+            chunk_num = div_up(count * dtype_size, chunk_count);
+            if (chunk_num) {
+                phase_count = chunk_num + 1;
+            }
+            break;
+        case ccl_coll_barrier: break;
+        default: CCL_THROW("unexpected coll ", ccl_coll_type_to_str(ctype));
+    }
+
+    CCL_THROW_IF_NOT(phase_count < ccl_shm_coll_ctx::done_step,
+                     "too many shm phases ",
+                     phase_count,
+                     ", count ",
+                     count);
+}
+
+void shm_coll_entry::reset(size_t idx) {
+    sched_entry::reset(idx);
+
+    // schedules are renewed in the order the collectives are posted, which is the same on all
+    // ranks, so taking the sequence number here gives each collective the same slot everywhere
+    seq = ctx->acquire_seq();
+    has_seq = true;
+}
+
+void shm_coll_entry::start() {
+    if (!has_seq) {
+        seq = ctx->acquire_seq();
+    }
+    has_seq = false;
+
+    phase = 0;
+    is_slot_acquired = false;
+    is_done_published = false;
+
+    send_ptr = static_cast<char*>(send_buf.get_ptr());
+    recv_ptr = static_cast<char*>(recv_buf.get_ptr());
+
+    LOG_DEBUG("starting SHM_COLL entry: coll ",
+              ccl_coll_type_to_str(ctype),
+              ", seq ",
+              seq,
+              ", phases ",
+              phase_count);
+
+    status = ccl_sched_entry_status_started;
+    update();
+}
+
+void shm_coll_entry::update() {
+    if (!is_slot_acquired) {
+        // the slot is free once all ranks are done with the previous collective in it
+        if (seq >= ccl_shm_coll_ctx::slot_count &&
+            !is_step_reached(seq - ccl_shm_coll_ctx::slot_count, ccl_shm_coll_ctx::done_step)) {
+            return;
+        }
+        is_slot_acquired = true;
+    }
+
+    while (phase < phase_count) {
+        if (phase > 0 && !is_step_reached(seq, phase)) {
+            return;
+        }
+        run_phase(phase);
+        phase++;
+        if (phase < phase_count) {
+            publish(phase);
+        }
+    }
+
+    if (!is_done_published) {
+        publish(ccl_shm_coll_ctx::done_step);
+        is_done_published = true;
+    }
+
+    if (ctype == ccl_coll_barrier && !is_step_reached(seq, ccl_shm_coll_ctx::done_step)) {
+        return;
+    }
+
+    status = ccl_sched_entry_status_complete;
+}
+
+bool shm_coll_entry::is_step_reached(uint64_t step_seq, uint64_t step) const {
+    return ctx->is_step_reached(step_seq, step);
+}
+
+void shm_coll_entry::publish(uint64_t step) {
+    ctx->publish(seq, step);
+}
+
+void shm_coll_entry::run_phase(size_t idx) {
+    switch (ctype) {
+        case ccl_coll_allreduce: run_allreduce_phase(idx); break;
+        case ccl_coll_reduce_scatter: run_reduce_scatter_phase(idx); break;
+        case ccl_coll_allgatherv: run_allgatherv_phase(idx); break;
+        case ccl_coll_bcast: run_bcast_phase(idx); break;
+        default: CCL_THROW("unexpected coll ", ccl_coll_type_to_str(ctype));
+    }
+}
+
+// splits chunk into comm_size parts aligned to cache line
+void shm_coll_entry::get_part(size_t elem_count,
+                              int part_idx,
+                              size_t& part_offset,
+                              size_t& part_count) const {
+    size_t align = std::max(CACHELINE_SIZE / dtype_size, size_t(1));
+    size_t base_count = div_up(div_up(elem_count, comm_size), align) * align;
+    part_offset = std::min(elem_count, part_idx * base_count);
+    part_count = std::min(elem_count, part_offset + base_count) - part_offset;
+}
+
+// inout_ptr = op(inout_ptr, in_ptrs[0], ..., in_ptrs[in_count - 1])
+void shm_coll_entry::reduce(size_t in_count,
+                            size_t elem_count,
+                            void* inout_ptr,
+                            size_t elem_offset) {
+    const ccl::fn_context context = { sched->coll_attr.match_id.c_str(),
+                                      elem_offset * dtype_size };
+    ccl::status comp_status = ccl_comp_reduce_n(
+        sched, in_ptrs.data(), in_count, elem_count, inout_ptr, dtype, op, fn, &context);
+    CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+}
+
+// phase 2c writes chunk c into the rank buffer and gathers the reduced chunk c - 1,
+// phase 2c + 1 reduces the own part of chunk c from the buffers of all ranks
+void shm_coll_entry::run_allreduce_phase(size_t idx) {
+    if (is_small_allreduce) {
+        if (idx == 0) {
+            ccl_comp_copy(send_ptr, ctx->get_buf(seq, rank, 0), count * dtype_size);
+        }
+        else {
+            // the same reduction order on all ranks keeps the results bitwise identical
+            ccl_comp_copy(ctx->get_buf(seq, 0, 0), recv_ptr, count * dtype_size);
+            for (int peer = 1; peer < comm_size; peer++) {
+                in_ptrs[peer - 1] = ctx->get_buf(seq, peer, 0);
+            }
+            reduce(comm_size - 1, count, recv_ptr, 0);
+        }
+        return;
+    }
+
+    size_t chunk_idx = idx / 2;
+    size_t part_offset, part_count;
+
+    if (idx % 2) {
+        size_t chunk_offset = chunk_idx * chunk_count;
+        size_t elem_count = std::min(chunk_count, count - chunk_offset);
+        size_t buf_idx = chunk_idx % ccl_shm_coll_ctx::buf_count;
+        get_part(elem_count, rank, part_offset, part_count);
+        if (!part_count) {
+            return;
+        }
+        size_t in_count = 0;
+        for (int peer = 0; peer < comm_size; peer++) {
+            if (peer != rank) {
+                in_ptrs[in_count++] = ctx->get_buf(seq, peer, buf_idx) + part_offset * dtype_size;
+            }
+        }
+        reduce(in_count,
+               part_count,
+               ctx->get_buf(seq, rank, buf_idx) + part_offset * dtype_size,
+               chunk_offset + part_offset);
+        return;
+    }
+
+    if (chunk_idx > 0) {
+        size_t prev_idx = chunk_idx - 1;
+        size_t chunk_offset = prev_idx * chunk_count;
+        size_t elem_count = std::min(chunk_count, count - chunk_offset);
+        size_t buf_idx = prev_idx % ccl_shm_coll_ctx::buf_count;
+        for (int peer = 0; peer < comm_size; peer++) {
+            get_part(elem_count, peer, part_offset, part_count);
+            ccl_comp_copy(ctx->get_buf(seq, peer, buf_idx) + part_offset * dtype_size,
+                          recv_ptr + (chunk_offset + part_offset) * dtype_size,
+                          part_count * dtype_size);
+        }
+    }
+
+    if (chunk_idx < chunk_num) {
+        size_t chunk_offset = chunk_idx * chunk_count;
+        size_t elem_count = std::min(chunk_count, count - chunk_offset);
+        ccl_comp_copy(send_ptr + chunk_offset * dtype_size,
+                      ctx->get_buf(seq, rank, chunk_idx % ccl_shm_coll_ctx::buf_count),
+                      elem_count * dtype_size);
+    }
+}
+
+// phase c reduces the own block of chunk c - 1 into recv_buf
+// and writes the blocks of chunk c for the other ranks
+void shm_coll_entry::run_reduce_scatter_phase(size_t idx) {
+    if (idx > 0) {
+        size_t chunk_idx = idx - 1;
+        size_t chunk_offset = chunk_idx * chunk_count;
+        size_t elem_count = std::min(chunk_count, count - chunk_offset);
+        size_t buf_idx = chunk_idx % ccl_shm_coll_ctx::buf_count;
+        char* inout_ptr = recv_ptr + chunk_offset * dtype_size;
+        ccl_comp_copy(send_ptr + (rank * count + chunk_offset) * dtype_size,
+                      inout_ptr,
+                      elem_count * dtype_size);
+        size_t in_count = 0;
+        for (int peer = 0; peer < comm_size; peer++) {
+            if (peer != rank) {
+                in_ptrs[in_count++] =
+                    ctx->get_buf(seq, peer, buf_idx) + rank * chunk_count * dtype_size;
+            }
+        }
+        reduce(in_count, elem_count, inout_ptr, chunk_offset);
+    }
+
+    if (idx < chunk_num) {
+        size_t chunk_offset = idx * chunk_count;
+        size_t elem_count = std::min(chunk_count, count - chunk_offset);
+        char* buf = ctx->get_buf(seq, rank, idx % ccl_shm_coll_ctx::buf_count);
+        for (int peer = 0; peer < comm_size; peer++) {
+            if (peer != rank) {
+                ccl_comp_copy(send_ptr + (peer * count + chunk_offset) * dtype_size,
+                              buf + peer * chunk_count * dtype_size,
+                              elem_count * dtype_size);
+            }
+        }
+    }
+}
+
+// phase c reads chunk c - 1 of the other ranks and writes own chunk c
+void shm_coll_entry::run_allgatherv_phase(size_t idx) {
+    if (idx == 0) {
+        ccl_comp_copy(send_ptr,
+                      recv_ptr + recv_offsets[rank],
+                      recv_offsets[rank + 1] - recv_offsets[rank]);
+    }
+    else {
+        size_t chunk_idx = idx - 1;
+        size_t chunk_offset = chunk_idx * chunk_count;
+        size_t buf_idx = chunk_idx % ccl_shm_coll_ctx::buf_count;
+        for (int peer = 0; peer < comm_size; peer++) {
+            size_t peer_bytes = recv_offsets[peer + 1] - recv_offsets[peer];
+            if (peer == rank || chunk_offset >= peer_bytes) {
+                continue;
+            }
+            ccl_comp_copy(ctx->get_buf(seq, peer, buf_idx),
+                          recv_ptr + recv_offsets[peer] + chunk_offset,
+                          std::min(chunk_count, peer_bytes - chunk_offset));
+        }
+    }
+
+    size_t own_bytes = recv_offsets[rank + 1] - recv_offsets[rank];
+    size_t chunk_offset = idx * chunk_count;
+    if (idx < chunk_num && chunk_offset < own_bytes) {
+        ccl_comp_copy(send_ptr + chunk_offset,
+                      ctx->get_buf(seq, rank, idx % ccl_shm_coll_ctx::buf_count),
+                      std::min(chunk_count, own_bytes - chunk_offset));
+    }
+}
+
+// phase c: root writes chunk c, other ranks read chunk c - 1
+void shm_coll_entry::run_bcast_phase(size_t idx) {
+    size_t bytes = count * dtype_size;
+    if (rank == root) {
+        if (idx < chunk_num) {
+            size_t chunk_offset = idx * chunk_count;
+            ccl_comp_copy(recv_ptr + chunk_offset,
+                          ctx->get_buf(seq, root, idx % ccl_shm_coll_ctx::buf_count),
+                          std::min(chunk_count, bytes - chunk_offset));
+        }
+    }
+    else if (idx > 0) {
+        size_t chunk_idx = idx - 1;
+        size_t chunk_offset = chunk_idx * chunk_count;
+        ccl_comp_copy(ctx->get_buf(seq, root, chunk_idx % ccl_shm_coll_ctx::buf_count),
+                      recv_ptr + chunk_offset,
+                      std::min(chunk_count, bytes - chunk_offset));
+    }
+}
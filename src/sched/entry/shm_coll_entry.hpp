@@ -0,0 +1,128 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "comm/shm_coll_ctx.hpp"
+#include "common/global/global.hpp"
+#include "sched/entry/entry.hpp"
+
+#include <vector>
+
+// runs a whole intra-node collective on the shm segment of the comm:
+// the collective is split into phases, after each phase a rank publishes its progress
+// in its flag and the next phase starts once all ranks have reached the same step
+class shm_coll_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "SHM_COLL";
+    }
+
+    const char* name() const noexcept override {
+        return class_name();
+    }
+
+    bool is_atl_ep_bound() const override {
+        return false;
+    }
+
+    shm_coll_entry() = delete;
+    explicit shm_coll_entry(ccl_sched* sched,
+                            ccl_coll_type ctype,
+                            ccl_buffer send_buf,
+                            ccl_buffer recv_buf,
+                            size_t count,
+                            const size_t* recv_counts,
+                            const ccl_datatype& dtype,
+                            ccl::reduction op,
+                            int root,
+                            ccl_comm* comm);
+
+    void reset(size_t idx) override;
+    void start() override;
+    void update() override;
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "coll ",
+                           ccl_coll_type_to_str(ctype),
+                           ", dt ",
+                           ccl::global_data::get().dtypes->name(dtype),
+                           ", send_buf ",
+                           send_buf,
+                           ", recv_buf ",
+                           recv_buf,
+                           ", count ",
+                           count,
+                           ", op ",
+                           ccl_reduction_to_str(op),
+                           ", root ",
+                           root,
+                           ", seq ",
+                           seq,
+                           ", phase ",
+                           phase,
+                           "/",
+                           phase_count,
+                           "\n");
+    }
+
+private:
+    bool is_step_reached(uint64_t step_seq, uint64_t step) const;
+    void publish(uint64_t step);
+
+    void run_phase(size_t idx);
+    void run_allreduce_phase(size_t idx);
+    void run_reduce_scatter_phase(size_t idx);
+    void run_allgatherv_phase(size_t idx);
+    void run_bcast_phase(size_t idx);
+
+    void get_part(size_t elem_count, int part_idx, size_t& part_offset, size_t& part_count) const;
+    void reduce(size_t in_count, size_t elem_count, void* inout_ptr, size_t elem_offset);
+
+    const ccl_coll_type ctype;
+    const ccl_buffer send_buf;
+    const ccl_buffer recv_buf;
+    const size_t count;
+    const ccl_datatype dtype;
+    const ccl::reduction op;
+    const ccl::reduction_fn fn;
+    const int root;
+
+    ccl_shm_coll_ctx* ctx;
+    const int rank;
+    const int comm_size;
+    const size_t dtype_size;
+
+    // allgatherv: byte offsets of the blocks in recv_buf, comm_size + 1 values
+    std::vector<size_t> recv_offsets;
+
+    // elements (bytes for allgatherv and bcast) moved by one rank in one chunk
+    size_t chunk_count{};
+    size_t chunk_num{};
+    size_t phase_count{};
+    bool is_small_allreduce{};
+
+    uint64_t seq{};
+    bool has_seq{};
+    bool is_slot_acquired{};
+    bool is_done_published{};
+    size_t phase{};
+
+    char* send_ptr{};
+    char* recv_ptr{};
+    std::vector<const void*> in_ptrs;
+};
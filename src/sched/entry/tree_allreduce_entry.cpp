@@ -0,0 +1,332 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "comp/comp.hpp"
+#include "sched/entry/tree_allreduce_entry.hpp"
+#include "sched/queue/queue.hpp"
+#include "sched/sched.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// number of chunks of every child which may be received ahead of the reduction
+#define CCL_TREE_ALLREDUCE_RECV_WINDOW 4
+
+// auto chunk size minimizes (chunk_num + 2 * depth) * (latency + chunk_size / bandwidth),
+// this is the assumed latency x bandwidth product of a link
+#define CCL_TREE_ALLREDUCE_LINK_LATENCY_BYTES (64 * 1024)
+#define CCL_TREE_ALLREDUCE_MIN_CHUNK_SIZE     (16 * 1024)
+#define CCL_TREE_ALLREDUCE_MAX_CHUNK_SIZE     (1024 * 1024)
+
+tree_allreduce_entry::tree_allreduce_entry(ccl_sched* sched,
+                                           ccl_buffer buf,
+                                           size_t count,
+                                           size_t chunk_count,
+                                           const ccl_datatype& dtype,
+                                           ccl::reduction op,
+                                           const ccl_bin_tree& tree,
+                                           ccl_comm* comm)
+        : sched_entry(sched),
+          buf(buf),
+          count(count),
+          chunk_count(chunk_count),
+          dtype(dtype),
+          op(op),
+          fn(sched->coll_attr.reduction_fn),
+          comm(comm),
+          parent(tree.parent()),
+          chunk_num((count + chunk_count - 1) / chunk_count) {
+    CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
+                     "custom reduction requires user provided callback");
+    CCL_THROW_IF_NOT(chunk_count > 0, "unexpected chunk_count ", chunk_count);
+
+    for (int child : { tree.left(), tree.right() }) {
+        if (child != -1) {
+            children.push_back(
+                { child, 0, 0, 0, std::vector<atl_req_t>(CCL_TREE_ALLREDUCE_RECV_WINDOW) });
+        }
+    }
+
+    up_send_reqs.resize(chunk_num);
+    down_recv_reqs.resize(chunk_num);
+    down_send_reqs.resize(chunk_num * children.size());
+
+    if (!children.empty()) {
+        tmp_buf = sched->alloc_buffer(
+            { children.size() * CCL_TREE_ALLREDUCE_RECV_WINDOW * chunk_count * dtype.size(),
+              buf });
+    }
+}
+
+size_t tree_allreduce_entry::get_chunk_count(size_t count,
+                                             const ccl_datatype& dtype,
+                                             int comm_size) {
+    ssize_t part_count = ccl::global_data::env().dtree_partition_count;
+    if (part_count != CCL_ENV_SIZET_NOT_SPECIFIED && part_count > 0) {
+        return std::max((count + part_count - 1) / part_count, size_t(1));
+    }
+
+    size_t depth = 1;
+    while ((1 << depth) < comm_size) {
+        depth++;
+    }
+
+    size_t chunk_size = static_cast<size_t>(
+        std::sqrt(static_cast<double>(count * dtype.size()) *
+                  CCL_TREE_ALLREDUCE_LINK_LATENCY_BYTES / (2 * depth)));
+    chunk_size = std::max(chunk_size, static_cast<size_t>(CCL_TREE_ALLREDUCE_MIN_CHUNK_SIZE));
+    chunk_size = std::min(chunk_size, static_cast<size_t>(CCL_TREE_ALLREDUCE_MAX_CHUNK_SIZE));
+
+    return std::max(chunk_size / dtype.size(), size_t(1));
+}
+
+void tree_allreduce_entry::reset(size_t idx) {
+    sched_entry::reset(idx);
+    for (auto& child : children) {
+        child.recv_pos = 0;
+        child.reduced_pos = 0;
+    }
+    up_send_pos = 0;
+    down_recv_pos = 0;
+    down_send_pos = 0;
+    done_pos = 0;
+}
+
+size_t tree_allreduce_entry::get_chunk_offset(size_t chunk_idx) const {
+    return chunk_idx * chunk_count * dtype.size();
+}
+
+size_t tree_allreduce_entry::get_chunk_size(size_t chunk_idx) const {
+    return std::min(chunk_count, count - chunk_idx * chunk_count) * dtype.size();
+}
+
+void* tree_allreduce_entry::get_tmp_slot(size_t child_idx, size_t chunk_idx) const {
+    size_t slot_idx = child_idx * CCL_TREE_ALLREDUCE_RECV_WINDOW +
+                      chunk_idx % CCL_TREE_ALLREDUCE_RECV_WINDOW;
+    return static_cast<char*>(tmp_buf.get_ptr()) + slot_idx * chunk_count * dtype.size();
+}
+
+bool tree_allreduce_entry::is_reduced(size_t chunk_idx) const {
+    for (const auto& child : children) {
+        if (child.reduced_pos <= chunk_idx) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool tree_allreduce_entry::check_req(atl_req_t& req) {
+    if (!req.is_completed) {
+        atl_status_t atl_status = comm->get_atl_comm()->check(sched->bin->get_atl_ep(), req);
+        if (unlikely(atl_status != ATL_STATUS_SUCCESS)) {
+            CCL_THROW("TREE_ALLREDUCE entry failed. atl_status: ", atl_status_to_str(atl_status));
+        }
+    }
+    return req.is_completed;
+}
+
+bool tree_allreduce_entry::post_child_recvs() {
+    bool is_posted = false;
+    for (size_t child_idx = 0; child_idx < children.size(); child_idx++) {
+        auto& child = children[child_idx];
+        // the slot is free when the chunk received into it before is reduced
+        while (child.recv_pos < chunk_num &&
+               child.recv_pos < child.reduced_pos + CCL_TREE_ALLREDUCE_RECV_WINDOW) {
+            atl_status_t atl_status = comm->get_atl_comm()->recv(
+                sched->bin->get_atl_ep(),
+                get_tmp_slot(child_idx, child.recv_pos),
+                get_chunk_size(child.recv_pos),
+                child.rank,
+                child.tag,
+                child.reqs[child.recv_pos % CCL_TREE_ALLREDUCE_RECV_WINDOW]);
+            if (atl_status == ATL_STATUS_AGAIN) {
+                break;
+            }
+            update_status(atl_status);
+            child.recv_pos++;
+            is_posted = true;
+        }
+    }
+    return is_posted;
+}
+
+bool tree_allreduce_entry::reduce_child_data() {
+    bool is_reduced = false;
+    for (size_t child_idx = 0; child_idx < children.size(); child_idx++) {
+        auto& child = children[child_idx];
+        while (child.reduced_pos < child.recv_pos &&
+               check_req(child.reqs[child.reduced_pos % CCL_TREE_ALLREDUCE_RECV_WINDOW])) {
+            size_t chunk_idx = child.reduced_pos;
+            size_t chunk_size = get_chunk_size(chunk_idx);
+            size_t offset = get_chunk_offset(chunk_idx);
+            const ccl::fn_context context = { sched->coll_attr.match_id.c_str(),
+                                              buf.get_offset() + offset };
+            // the root completes the chunk with the last child reduction, avg is divided there
+            size_t avg_divisor = 1;
+            if (parent == -1 &&
+                std::all_of(children.begin(), children.end(), [&](const child_t& other) {
+                    return &other == &child || other.reduced_pos > chunk_idx;
+                })) {
+                avg_divisor = comm->size();
+            }
+            ccl::status comp_status = ccl_comp_reduce(sched,
+                                                      get_tmp_slot(child_idx, chunk_idx),
+                                                      chunk_size / dtype.size(),
+                                                      (buf + offset).get_ptr(chunk_size),
+                                                      nullptr,
+                                                      dtype,
+                                                      op,
+                                                      fn,
+                                                      &context,
+                                                      avg_divisor);
+            CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+            child.reduced_pos++;
+            is_reduced = true;
+        }
+    }
+    return is_reduced;
+}
+
+bool tree_allreduce_entry::post_up_sends() {
+    bool is_posted = false;
+    while (parent != -1 && up_send_pos < chunk_num && is_reduced(up_send_pos)) {
+        size_t chunk_size = get_chunk_size(up_send_pos);
+        atl_status_t atl_status =
+            comm->get_atl_comm()->send(sched->bin->get_atl_ep(),
+                                       (buf + get_chunk_offset(up_send_pos)).get_ptr(chunk_size),
+                                       chunk_size,
+                                       parent,
+                                       send_tag,
+                                       up_send_reqs[up_send_pos]);
+        if (atl_status == ATL_STATUS_AGAIN) {
+            break;
+        }
+        update_status(atl_status);
+        up_send_pos++;
+        is_posted = true;
+    }
+    return is_posted;
+}
+
+bool tree_allreduce_entry::post_down_recvs() {
+    bool is_posted = false;
+    // the final value overwrites the chunk, so its send to the parent has to be done
+    while (down_recv_pos < up_send_pos && check_req(up_send_reqs[down_recv_pos])) {
+        size_t chunk_size = get_chunk_size(down_recv_pos);
+        atl_status_t atl_status =
+            comm->get_atl_comm()->recv(sched->bin->get_atl_ep(),
+                                       (buf + get_chunk_offset(down_recv_pos)).get_ptr(chunk_size),
+                                       chunk_size,
+                                       parent,
+                                       parent_tag,
+                                       down_recv_reqs[down_recv_pos]);
+        if (atl_status == ATL_STATUS_AGAIN) {
+            break;
+        }
+        update_status(atl_status);
+        down_recv_pos++;
+        is_posted = true;
+    }
+    return is_posted;
+}
+
+bool tree_allreduce_entry::post_down_sends() {
+    bool is_posted = false;
+    while (down_send_pos < chunk_num) {
+        bool is_final = (parent == -1) ? is_reduced(down_send_pos)
+                                       : (down_send_pos < down_recv_pos &&
+                                          check_req(down_recv_reqs[down_send_pos]));
+        if (!is_final) {
+            break;
+        }
+
+        // sends to the children of the same chunk are posted together to keep the order
+        size_t chunk_size = get_chunk_size(down_send_pos);
+        void* chunk_buf = (buf + get_chunk_offset(down_send_pos)).get_ptr(chunk_size);
+        for (size_t child_idx = 0; child_idx < children.size(); child_idx++) {
+            atl_req_t& req = down_send_reqs[down_send_pos * children.size() + child_idx];
+            atl_status_t atl_status;
+            do {
+                atl_status = comm->get_atl_comm()->send(sched->bin->get_atl_ep(),
+                                                        chunk_buf,
+                                                        chunk_size,
+                                                        children[child_idx].rank,
+                                                        send_tag,
+                                                        req);
+            } while (atl_status == ATL_STATUS_AGAIN);
+            update_status(atl_status);
+        }
+        down_send_pos++;
+        is_posted = true;
+    }
+    return is_posted;
+}
+
+void tree_allreduce_entry::start() {
+    int rank = comm->rank();
+    send_tag = comm->get_atl_comm()->tag_creator->create(
+        rank, comm->get_comm_id(), sched->sched_id, sched->get_op_id());
+    if (parent != -1) {
+        parent_tag = comm->get_atl_comm()->tag_creator->create(
+            parent, comm->get_comm_id(), sched->sched_id, sched->get_op_id());
+    }
+    for (auto& child : children) {
+        child.tag = comm->get_atl_comm()->tag_creator->create(
+            child.rank, comm->get_comm_id(), sched->sched_id, sched->get_op_id());
+    }
+
+    LOG_DEBUG("TREE_ALLREDUCE entry: count ",
+              count,
+              ", chunk_count ",
+              chunk_count,
+              ", chunks ",
+              chunk_num,
+              ", parent ",
+              parent,
+              ", children ",
+              children.size(),
+              ", send_tag ",
+              send_tag);
+
+    status = ccl_sched_entry_status_started;
+    update();
+}
+
+void tree_allreduce_entry::update() {
+    bool is_progressed = true;
+    while (is_progressed) {
+        is_progressed = post_child_recvs();
+        is_progressed |= reduce_child_data();
+        is_progressed |= post_up_sends();
+        is_progressed |= post_down_recvs();
+        is_progressed |= post_down_sends();
+
+        while (done_pos < down_send_pos) {
+            bool is_done = true;
+            for (size_t child_idx = 0; child_idx < children.size(); child_idx++) {
+                is_done &= check_req(down_send_reqs[done_pos * children.size() + child_idx]);
+            }
+            if (!is_done) {
+                break;
+            }
+            done_pos++;
+        }
+    }
+
+    if (done_pos == chunk_num) {
+        LOG_DEBUG("TREE_ALLREDUCE entry done");
+        status = ccl_sched_entry_status_complete;
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/global/global.hpp"
+#include "common/utils/tree.hpp"
+#include "sched/entry/entry.hpp"
+
+#include <vector>
+
+// pipelined reduce + bcast of a buffer over a binary tree in a single entry:
+// the buffer is split into chunks, a chunk is sent to the parent as soon as the data
+// of the children is reduced into it and is sent down as soon as its final value arrives,
+// so the reduce-up of the next chunks overlaps the bcast-down of the previous ones.
+// Messages between two ranks go in one direction and in chunk order, so one tag is enough
+class tree_allreduce_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "TREE_ALLREDUCE";
+    }
+
+    const char* name() const noexcept override {
+        return class_name();
+    }
+
+    tree_allreduce_entry() = delete;
+    explicit tree_allreduce_entry(ccl_sched* sched,
+                                  ccl_buffer buf,
+                                  size_t count,
+                                  size_t chunk_count,
+                                  const ccl_datatype& dtype,
+                                  ccl::reduction op,
+                                  const ccl_bin_tree& tree,
+                                  ccl_comm* comm);
+
+    // number of elements in a chunk chosen from the message size and the comm size
+    static size_t get_chunk_count(size_t count, const ccl_datatype& dtype, int comm_size);
+
+    void reset(size_t idx) override;
+    void start() override;
+    void update() override;
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "dt ",
+                           ccl::global_data::get().dtypes->name(dtype),
+                           ", buf ",
+                           buf,
+                           ", count ",
+                           count,
+                           ", chunk_count ",
+                           chunk_count,
+                           ", chunks ",
+                           chunk_num,
+                           ", op ",
+                           ccl_reduction_to_str(op),
+                           ", parent ",
+                           parent,
+                           ", children ",
+                           children.size(),
+                           ", up ",
+                           up_send_pos,
+                           ", down ",
+                           down_send_pos,
+                           ", done ",
+                           done_pos,
+                           "\n");
+    }
+
+private:
+    struct child_t {
+        int rank;
+        uint64_t tag;
+        size_t recv_pos;
+        size_t reduced_pos;
+        std::vector<atl_req_t> reqs;
+    };
+
+    size_t get_chunk_offset(size_t chunk_idx) const;
+    size_t get_chunk_size(size_t chunk_idx) const;
+    void* get_tmp_slot(size_t child_idx, size_t chunk_idx) const;
+    bool is_reduced(size_t chunk_idx) const;
+    bool check_req(atl_req_t& req);
+
+    bool post_child_recvs();
+    bool reduce_child_data();
+    bool post_up_sends();
+    bool post_down_recvs();
+    bool post_down_sends();
+
+    const ccl_buffer buf;
+    const size_t count;
+    const size_t chunk_count;
+    const ccl_datatype dtype;
+    const ccl::reduction op;
+    const ccl::reduction_fn fn;
+    ccl_comm* comm;
+    const int parent;
+    const size_t chunk_num;
+
+    std::vector<child_t> children;
+    ccl_buffer tmp_buf;
+
+    uint64_t send_tag = 0;
+    uint64_t parent_tag = 0;
+
+    std::vector<atl_req_t> up_send_reqs;
+    std::vector<atl_req_t> down_recv_reqs;
+    // chunk_num x children.size()
+    std::vector<atl_req_t> down_send_reqs;
+
+    size_t up_send_pos = 0;
+    size_t down_recv_pos = 0;
+    size_t down_send_pos = 0;
+    size_t done_pos = 0;
+};
@@ -0,0 +1,67 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "sched/queue/steal_queue.hpp"
+
+void ccl_steal_sched_queue::add(ccl_sched* sched) {
+    CCL_ASSERT(sched);
+    CCL_ASSERT(!sched->bin, "sched ", sched, ", bin ", sched->bin);
+    CCL_ASSERT(!sched->strict_order);
+
+    std::lock_guard<ccl_spinlock> lock{ queue_guard };
+    queue.push_back(sched);
+    count.store(queue.size(), std::memory_order_relaxed);
+}
+
+ccl_sched* ccl_steal_sched_queue::pop() {
+    if (!size())
+        return nullptr;
+
+    std::lock_guard<ccl_spinlock> lock{ queue_guard };
+    if (queue.empty())
+        return nullptr;
+
+    ccl_sched* sched = queue.front();
+    queue.pop_front();
+    count.store(queue.size(), std::memory_order_relaxed);
+    return sched;
+}
+
+size_t ccl_steal_sched_queue::steal(std::vector<ccl_sched*>& scheds) {
+    if (!size())
+        return 0;
+
+    /* don't wait for owner, it will retry on the next iteration anyway */
+    if (!queue_guard.try_lock())
+        return 0;
+
+    /* leave the head to the owner, it is going to be started soon */
+    size_t steal_count = queue.size() / 2;
+    for (size_t idx = 0; idx < steal_count; idx++) {
+        scheds.push_back(queue.back());
+        queue.pop_back();
+    }
+    count.store(queue.size(), std::memory_order_relaxed);
+
+    queue_guard.unlock();
+
+    return steal_count;
+}
+
+void ccl_steal_sched_queue::clear() {
+    std::lock_guard<ccl_spinlock> lock{ queue_guard };
+    queue.clear();
+    count.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,52 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/utils/spinlock.hpp"
+#include "sched/sched.hpp"
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+/* pending scheds of a single worker which are not bound to its ATL EP yet */
+class ccl_steal_sched_queue {
+public:
+    ccl_steal_sched_queue() {}
+    ccl_steal_sched_queue(const ccl_steal_sched_queue& other) = delete;
+    ccl_steal_sched_queue& operator=(const ccl_steal_sched_queue& other) = delete;
+    ~ccl_steal_sched_queue() {}
+
+    /* owner side, FIFO */
+    void add(ccl_sched* sched);
+    ccl_sched* pop();
+
+    /* thief side, takes up to a half of pending scheds from the tail */
+    size_t steal(std::vector<ccl_sched*>& scheds);
+
+    void clear();
+
+    size_t size() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+private:
+    ccl_spinlock queue_guard{};
+    std::deque<ccl_sched*> queue{};
+
+    /* allows lockless emptiness checks from other workers */
+    std::atomic<size_t> count{ 0 };
+};
@@ -15,6 +15,7 @@
 */
 #include "coll/coll_check.hpp"
 #include "coll/coll_util.hpp"
+#include "coll/selection/adaptive_selector.hpp"
 #include "coll/selection/selection.hpp"
 #include "common/global/global.hpp"
 #include "common/log/log.hpp"
@@ -221,6 +222,15 @@ ccl_request* ccl_sched::start(ccl_executor* exec,
     return get_request();
 }
 
+ccl_request* ccl_sched::start_persistent(ccl_executor* exec) {
+    CCL_THROW_IF_NOT(is_completed(), "persistent sched ", this, " is still in progress");
+
+    // the sched is not shared through the cache, so there are no delayed requests
+    // and the request of the previous execution can be reused
+    restart_manager->set_not_in_progress();
+    return start(exec);
+}
+
 int ccl_sched::calculate_request_count() const {
     return std::max(1, static_cast<int>(subscheds.size()));
 }
@@ -247,6 +257,23 @@ std::vector<std::shared_ptr<ccl_sched>>& ccl_sched::get_subscheds() {
     return subscheds;
 }
 
+size_t ccl_sched::get_memory_bytes() const {
+    size_t bytes = sizeof(*this) + memory.buffer_manager.get_allocated_bytes() +
+                   entries.size() * sizeof(sched_entry);
+    for (const auto& sched : subscheds) {
+        bytes += sched->get_memory_bytes();
+    }
+    return bytes;
+}
+
+bool ccl_sched::is_atl_ep_bound() const {
+    for (const auto& entry : entries) {
+        if (entry->is_atl_ep_bound())
+            return true;
+    }
+    return false;
+}
+
 void ccl_sched::prepare_subscheds(bool update_sched_id) {
     for (auto& sched : subscheds) {
         sched->renew(update_sched_id, true);
@@ -558,6 +585,13 @@ void ccl_sched::complete() {
                     // restart it again
                     parent_schedule->try_to_restart();
                 }
+                if (parent_schedule->adaptive_timer.is_started()) {
+                    parent_schedule->adaptive_timer.update();
+                    ccl::global_data::get().adaptive_selector->update(
+                        parent_schedule->coll_param,
+                        parent_schedule->adaptive_timer.get_elapsed_usec());
+                    parent_schedule->adaptive_timer.reset();
+                }
                 parent_req->complete();
             }
         }
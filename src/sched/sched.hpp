@@ -53,6 +53,7 @@ static constexpr int invalid_entry_idx = -1;
 class sched_restart_manager;
 
 class ccl_sched_key;
+struct ccl_sched_cache_entry;
 // TODO: after removing duplicate code, the only sched types currently
 // in use: extra and master. Need to rework code further for unification
 enum class sched_type_t { /* regular , */ master, extra };
@@ -73,6 +74,11 @@ public:
 
     void add_subsched(const ccl_coll_param& param, bool update_sched_id = true);
     std::vector<std::shared_ptr<ccl_sched>>& get_subscheds();
+
+    /* estimated memory footprint including subscheds, used for cache accounting */
+    size_t get_memory_bytes() const;
+    /* true if any entry uses the ATL endpoint of the bin, such sched must stay on its worker */
+    bool is_atl_ep_bound() const;
     void commit(ccl_parallelizer* parallelizer = nullptr, bool update_sched_id = true);
     // start executing the schedule
     ccl_request* start(ccl_executor* exec,
@@ -82,6 +88,8 @@ public:
                        bool update_sched_id = true,
                        // if true - we're restarting the same sched after it's been delayed
                        bool restart = false);
+    // start the sched owned by a persistent request, the previous execution must be completed
+    ccl_request* start_persistent(ccl_executor* exec);
 
 #if defined(CCL_ENABLE_ZE) && defined(CCL_ENABLE_SYCL)
     void inherit_ze_managers_from(ccl_sched* sched) {
@@ -213,6 +221,7 @@ public:
 
     ccl_sched_bin* bin = nullptr; /* valid only during execution */
     ccl_sched_queue* queue = nullptr; /* cached pointer to queue, valid even after execution */
+    ccl_sched_cache_entry* cache_entry = nullptr; /* valid only for scheds stored in cache */
     size_t start_idx = 0; /* index to start */
 
     /*
@@ -232,6 +241,12 @@ public:
     /* currently applicable for start phase only */
     bool strict_order = false;
 
+    /* set when sched is passed to worker, used for worker latency stat */
+    std::chrono::steady_clock::time_point worker_add_time{};
+
+    /* started for master sched whose completion time is reported to adaptive selector */
+    ccl::sched_timer adaptive_timer;
+
     /*
       limits number of active entries
       mostly makes sense for ATL entries
@@ -246,6 +246,16 @@ std::string topo_manager::get_uuid(int rank) const {
     return uuids[rank];
 }
 
+int topo_manager::get_host_count() const {
+    return static_cast<int>(host_info_vec.size());
+}
+
+int topo_manager::get_host_leader_rank(int host_idx) const {
+    CCL_THROW_IF_NOT(
+        host_idx >= 0 && host_idx < get_host_count(), "unexpected host_idx ", host_idx);
+    return *host_info_vec[host_idx].ranks.begin();
+}
+
 bool topo_manager::has_same_ppn() const {
     return is_same_ppn;
 }
@@ -147,6 +147,9 @@ public:
               std::shared_ptr<ccl::context> context_ptr);
 
     int get_host_idx() const;
+    int get_host_count() const;
+    // the lowest rank of the host
+    int get_host_leader_rank(int host_idx) const;
     int get_intra_card_color(int rank) const;
     int get_inter_card_color(int rank) const;
     // for MT